@@ -1,6 +1,14 @@
 #version 330 core
 out vec4 FragColor;
 
+// Variantes: o ResourceSystem injeta SHADER_VARIANT, SHADOWS, NORMAL_MAP e MAX_LIGHTS logo após o #version.
+// Sem eles este é o shader completo (fallback enquanto a variante compila), com as sombras ligadas em runtime.
+#ifndef SHADER_VARIANT
+#define SHADOWS
+#define NORMAL_MAP
+#define MAX_LIGHTS 10 // igual ao último EngineConfig::SHADER_LIGHT_TIERS
+#endif
+
 struct Material {
     sampler2D diffuse;
     sampler2D specular;
@@ -30,19 +38,29 @@ in vec2 TexCoords;
 uniform vec3 viewPos;
 uniform Material material;
 uniform int numLights;
-uniform Light lights[10];
+uniform Light lights[MAX_LIGHTS];
+
+#if defined(NORMAL_MAP) && !defined(SHADER_VARIANT)
+// o fallback atende todos os materiais: só aplica o normal map quando o material tem um, como as variantes
+uniform int hasNormalMap;
+#endif
 
+#ifdef SHADOWS
 // Shadow mapping
 uniform sampler2D shadowMap;
 uniform mat4 lightSpaceMatrix;
+#ifndef SHADER_VARIANT
 uniform int useShadows;
+#endif
 
 // direção da luz que gerou o shadow map
 uniform vec3 shadowLightDir;
 
 float calculateShadow(vec4 fragPosLightSpace)
 {
+#ifndef SHADER_VARIANT
     if (useShadows == 0) return 0.0;
+#endif
 
     vec3 projCoords = fragPosLightSpace.xyz / fragPosLightSpace.w;
     projCoords = projCoords * 0.5 + 0.5;
@@ -83,19 +101,29 @@ float calculateShadow(vec4 fragPosLightSpace)
 
     return shadow;
 }
+#endif
 
 void main()
 {
     // Normal da malha (geométrica)
     vec3 nGeom = normalize(Normal);
 
+#ifdef NORMAL_MAP
     // Normal do normal map (tangent-like, mas ainda sem TBN)
-    vec3 nMap = texture(material.normal, TexCoords).rgb;
-    nMap = normalize(nMap * 2.0 - 1.0); // [0,1] -> [-1,1]
+    // Só XY é amostrado (normal maps BC5 guardam dois canais); Z é reconstruído
+    vec3 nMap;
+    nMap.xy = texture(material.normal, TexCoords).rg * 2.0 - 1.0; // [0,1] -> [-1,1]
+    nMap.z = sqrt(max(0.0, 1.0 - dot(nMap.xy, nMap.xy)));
 
     // Mistura das duas para evitar reflexos quebrados quando o mapa é default
     float normalStrength = 0.5; // ajuste fino aqui (0 = só geometria, 1 = só normal map)
     vec3 normal = normalize(mix(nGeom, nMap, normalStrength));
+#ifndef SHADER_VARIANT
+    if (hasNormalMap == 0) normal = nGeom;
+#endif
+#else
+    vec3 normal = nGeom;
+#endif
 
     vec3 viewDir = normalize(viewPos - FragPos);
 
@@ -103,8 +131,12 @@ void main()
     vec3 specularTex = texture(material.specular, TexCoords).rgb;
     vec3 emissionTex = texture(material.emission, TexCoords).rgb;
 
+#ifdef SHADOWS
     vec4 fragPosLightSpace = lightSpaceMatrix * vec4(FragPos, 1.0);
     float shadow = calculateShadow(fragPosLightSpace);
+#else
+    float shadow = 0.0;
+#endif
 
     // Emission
     vec3 result = emissionTex;
@@ -112,7 +144,9 @@ void main()
     if (numLights == 0) {
         result += diffuseTex * 0.7;
     } else {
-        for (int i = 0; i < numLights; ++i) {
+        // Limite constante: o compilador pode desenrolar o laço em variantes com poucas luzes
+        for (int i = 0; i < MAX_LIGHTS; ++i) {
+            if (i >= numLights) break;
 
             Light light = lights[i];
 
@@ -1,6 +1,6 @@
 #version 330 core
 
-layout(location = 0) in vec3 aPos;     // Vertice position
+layout(location = 0) in vec3 aPos;     // Vertice position (packed meshes: normalized 16-bit within the bounds)
 layout(location = 1) in vec3 aNormal;  // Vertice Normal position
 layout(location = 2) in vec2 aTex;  // Vertice Texture position
 
@@ -8,14 +8,18 @@ uniform mat4 MVP;   // Matrix Model-View-Project
 uniform mat4 model; // Matrix model with obj transformations
 // Normal matrix: pre-computed transpose(inverse(model)) on CPU to reduce per-vertex overhead
 uniform mat3 normalMatrix;
+// Packed position decode: position = aPos * positionScale + positionOffset (identity for float meshes)
+uniform vec3 positionScale;
+uniform vec3 positionOffset;
 
 out vec3 FragPos;   // Frag position in world space
 out vec3 Normal;    // Interpolated normal
 out vec2 TexCoords;    // Texture coordinates
 
 void main() {
-    FragPos = vec3(model * vec4(aPos, 1.0));
+    vec3 position = aPos * positionScale + positionOffset;
+    FragPos = vec3(model * vec4(position, 1.0));
     Normal = normalize(normalMatrix * aNormal);
     TexCoords = aTex;
-    gl_Position = MVP * vec4(aPos, 1.0);
+    gl_Position = MVP * vec4(position, 1.0);
 }
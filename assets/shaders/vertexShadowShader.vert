@@ -3,7 +3,9 @@ layout(location = 0) in vec3 aPos;
 
 uniform mat4 lightSpaceMatrix;
 uniform mat4 model;
+uniform vec3 positionScale;  // packed position decode (identity for float meshes)
+uniform vec3 positionOffset;
 
 void main() {
-    gl_Position = lightSpaceMatrix * model * vec4(aPos, 1.0);
+    gl_Position = lightSpaceMatrix * model * vec4(aPos * positionScale + positionOffset, 1.0);
 }
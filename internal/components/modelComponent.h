@@ -6,6 +6,7 @@
 struct ModelComponent : public BaseComponent {
   uint32_t meshHandle;
   std::vector<uint32_t> materialHandles; // one per submesh
+  uint32_t lod = 0;                      // currently selected detail level (kept for hysteresis)
 
   ModelComponent(uint32_t mesh, std::vector<uint32_t> mats) : meshHandle(mesh), materialHandles(std::move(mats)) {}
 };
\ No newline at end of file
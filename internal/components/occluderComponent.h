@@ -0,0 +1,9 @@
+#pragma once
+
+#include "foundation/ecs/componentManager.h"
+
+// Marks a model entity as an occluder: its mesh is rasterized into the CPU
+// depth buffer used to cull hidden renderables.
+struct OccluderComponent : public BaseComponent {
+  OccluderComponent() = default;
+};
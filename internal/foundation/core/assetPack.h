@@ -0,0 +1,94 @@
+#pragma once
+#include "foundation/core/mappedFile.h"
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// What a packed blob holds; part of the lookup key, so one source can be packed as several assets
+enum class AssetType : uint32_t {
+  Mesh,      // mesh cache file (MeshCache layout)
+  Texture,   // texture cache file (TextureCache layout), color usage
+  NormalMap, // texture cache file, normal map usage
+  Shader,    // shader source text
+};
+
+// Read-only view of a packed asset, valid while the pack stays mounted
+struct AssetBlob {
+  const uint8_t *data = nullptr;
+  size_t size = 0;
+};
+
+// Single-file asset pack: header | hashed directory | keys | blobs (16-byte aligned), mapped once at startup.
+// Assets are looked up by their engine path (e.g. "../assets/models/box/box.obj"), stored relative to
+// ASSET_BASE_PATH; the directory is an open-addressing table of 64-bit path hashes, so a lookup is a
+// few probes in mapped memory instead of stat/open calls. Each entry keeps its key, so a hash collision
+// probes on instead of returning another asset.
+class AssetPack {
+public:
+  static constexpr uint32_t FORMAT_VERSION = 2;
+
+  // Blob compression; blobs are runtime formats already (block-compressed textures, packed meshes)
+  enum class Compression : uint32_t { None };
+
+  struct Header {
+    char magic[4];
+    uint32_t formatVersion;
+    uint32_t entryCount;
+    uint32_t slotCount; // power of two
+    uint64_t directoryOffset;
+  };
+
+  // Directory slot; hash 0 marks an empty slot
+  struct Entry {
+    uint64_t hash;
+    uint64_t offset;
+    uint64_t size;
+    uint64_t keyOffset; // getKey() of the asset, not null-terminated
+    uint32_t keySize;
+    uint32_t type;
+    uint32_t compression;
+    uint32_t reserved;
+  };
+
+private:
+  MappedFile m_file;
+  const Entry *m_slots = nullptr;
+  uint32_t m_slotMask = 0;
+  uint32_t m_entryCount = 0;
+
+public:
+  // Pack mounted by the engine at startup (empty unless ASSET_PACK_PATH exists)
+  static AssetPack &get();
+
+  bool open(const std::string &path);
+  void close();
+  bool isOpen() const;
+  uint32_t getEntryCount() const;
+
+  // Packed asset for an engine path; false if the pack does not hold it
+  bool find(const std::string &path, AssetType type, AssetBlob &blob) const;
+
+  // Lookup key: path relative to ASSET_BASE_PATH, lexically normalized, '/' separated
+  static std::string getKey(const std::string &path);
+  static uint64_t hashKey(const std::string &key, AssetType type);
+};
+
+// Collects blobs and writes an AssetPack file
+class AssetPackWriter {
+private:
+  struct Pending {
+    std::string key;
+    uint64_t hash;
+    AssetType type;
+    std::vector<uint8_t> data;
+  };
+  std::vector<Pending> m_assets;
+  std::unordered_map<std::string, size_t> m_indices; // type + key -> m_assets index
+
+public:
+  // Add (or replace) the asset of an engine path
+  void add(const std::string &path, AssetType type, const void *data, size_t size);
+  size_t getAssetCount() const;
+  bool write(const std::string &outputPath) const;
+};
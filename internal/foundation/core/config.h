@@ -24,6 +24,109 @@ constexpr float DEFAULT_CLEAR_COLOR_A = 1.0f;
 constexpr int SHADOW_MAP_WIDTH = 2048;
 constexpr int SHADOW_MAP_HEIGHT = 2048;
 
+// Renderables per job when extracting and recording command lists
+constexpr unsigned int RENDER_RECORD_CHUNK_SIZE = 256;
+
+// ========== MESH LOD CONFIGURATION ==========
+// Number of detail levels per submesh (LOD 0 = source mesh)
+constexpr unsigned int MESH_LOD_COUNT = 4;
+// Each level targets this fraction of the previous level's triangles
+constexpr float MESH_LOD_REDUCTION = 0.5f;
+// Max simplification error per level, relative to the mesh bounding box diagonal
+constexpr float MESH_LOD_MAX_ERROR = 0.05f;
+// A level is dropped when it saves less than this fraction of triangles
+constexpr float MESH_LOD_MIN_SAVING = 0.1f;
+// Upload meshes as 16-byte packed vertices (16-bit positions within the bounds, 10_10_10_2 normals,
+// half-float UVs) instead of 32-byte float vertices; UVs beyond +-2048 lose sub-texel precision
+constexpr bool MESH_PACK_VERTICES = true;
+
+// OBJ files are parsed in chunks of about this size in parallel
+constexpr unsigned int OBJ_PARSE_CHUNK_BYTES = 4u * 1024 * 1024;
+
+// Projected screen size (bounding sphere radius / half view height) below which
+// LOD i+1 is selected instead of LOD i
+constexpr float LOD_SCREEN_THRESHOLDS[MESH_LOD_COUNT - 1] = {0.5f, 0.25f, 0.1f};
+// Relative band around each threshold to avoid popping between levels
+constexpr float LOD_HYSTERESIS = 0.15f;
+
+// ========== OCCLUSION CULLING CONFIGURATION ==========
+// CPU depth buffer the designated occluders are rasterized into
+constexpr int OCCLUSION_BUFFER_WIDTH = 256;
+constexpr int OCCLUSION_BUFFER_HEIGHT = 128;
+// Raster tiles processed in parallel (width must be a multiple of 4)
+constexpr int OCCLUSION_TILE_WIDTH = 64;
+constexpr int OCCLUSION_TILE_HEIGHT = 32;
+
+// ========== PROFILER CONFIGURATION ==========
+constexpr bool PROFILER_ENABLED = true;
+// Zone events buffered per thread between two collected frames
+constexpr unsigned int PROFILER_RING_CAPACITY = 16384;
+// Frames kept for the overlay and the Chrome trace export
+constexpr unsigned int PROFILER_HISTORY_FRAMES = 120;
+constexpr const char *PROFILER_TRACE_PATH = "profile_trace.json";
+
+// GPU pass timings: frames a timestamp query stays in flight before it is read back
+// (2 = double-buffered), and samples kept for the graph and percentiles
+constexpr unsigned int GPU_TIMER_FRAMES_IN_FLIGHT = 2;
+constexpr unsigned int GPU_TIMER_HISTORY = 240;
+
+// ========== ASSET STREAMING CONFIGURATION ==========
+// GPU upload budget per frame for assets loaded in the background; at least one
+// finished asset is uploaded each frame even if it alone exceeds the budget
+constexpr unsigned int ASSET_UPLOAD_BUDGET_BYTES = 8 * 1024 * 1024;
+constexpr float ASSET_UPLOAD_BUDGET_MS = 2.0f;
+// Streamed textures go through a pixel unpack ring with one segment per frame in flight;
+// a segment is reused once the GPU fence of its frame signalled
+constexpr unsigned int TEXTURE_STAGING_SEGMENT_BYTES = 8 * 1024 * 1024;
+constexpr unsigned int TEXTURE_STAGING_SEGMENTS = 3;
+
+// ========== RESOURCE BUDGET CONFIGURATION ==========
+// ResourceSystem evicts least recently used resources while a type is over budget: unreferenced meshes
+// (CPU + GPU bytes) and textures no drawn material used for RESOURCE_EVICTION_MIN_AGE_FRAMES (GPU bytes).
+// Evicted textures keep their name (1x1 placeholder) and stream back in when a material uses them again.
+constexpr unsigned int MESH_MEMORY_BUDGET_BYTES = 256u * 1024 * 1024;
+constexpr unsigned int TEXTURE_MEMORY_BUDGET_BYTES = 512u * 1024 * 1024;
+constexpr unsigned int RESOURCE_EVICTION_MIN_AGE_FRAMES = 300;
+
+// ========== WORLD STREAMING CONFIGURATION ==========
+// Cells closer than the load radius (XZ distance to the cell's square) to the camera, or to where its velocity
+// takes it within the look-ahead time, are streamed in; cells farther than the unload radius from both are
+// destroyed. The gap between the radii keeps cells on the boundary from reloading back and forth.
+constexpr float STREAMING_LOAD_RADIUS = 96.0f;
+constexpr float STREAMING_UNLOAD_RADIUS = 128.0f;
+constexpr float STREAMING_LOOKAHEAD_SECONDS = 1.5f;
+// Weight of the newest frame in the smoothed camera velocity
+constexpr float STREAMING_VELOCITY_SMOOTHING = 0.1f;
+// Cell snapshots read on the job system at a time
+constexpr unsigned int STREAMING_MAX_PENDING_READS = 4;
+// Components instantiated plus entities destroyed per frame (at least one cell is unloaded each frame)
+constexpr unsigned int STREAMING_COMPONENTS_PER_FRAME = 2048;
+
+// ========== TEXTURE COMPRESSION CONFIGURATION ==========
+// Imported textures are block-compressed on the CPU once and cached (BC1/BC3 color, BC5 normal maps);
+// BC7 replaces BC1/BC3 for color at a slower encode and twice the size of BC1
+constexpr bool TEXTURE_COMPRESSION_ENABLED = true;
+constexpr bool TEXTURE_COMPRESSION_USE_BC7 = false;
+
+// ========== SHADER VARIANT CONFIGURATION ==========
+// Light count tiers of the main shader variants (MAX_LIGHTS); the last one is the size of the shader's
+// light array and the most lights a frame can use
+constexpr int SHADER_LIGHT_TIERS[] = {1, 4, 10};
+constexpr unsigned int SHADER_LIGHT_TIER_COUNT = sizeof(SHADER_LIGHT_TIERS) / sizeof(SHADER_LIGHT_TIERS[0]);
+// Background variant builds finished per frame (each may block on drivers without parallel shader compile)
+constexpr unsigned int SHADER_BUILDS_PER_FRAME = 2;
+
+// ========== PROGRAM CACHE CONFIGURATION ==========
+// Linked shader programs are saved as driver binaries and reloaded on later runs instead of compiling GLSL
+constexpr bool PROGRAM_CACHE_ENABLED = true;
+
+// ========== HOT RELOAD CONFIGURATION ==========
+// Shaders and textures loaded through ResourceSystem are rebuilt in place when their files change on disk
+// (never for assets served from the asset pack)
+constexpr bool HOT_RELOAD_ENABLED = true;
+// Write-time polling interval where inotify is unavailable
+constexpr int HOT_RELOAD_POLL_MS = 50;
+
 // ========== ASSET PATHS CONFIGURATION ==========
 // Base directories (relative to binary execution directory)
 constexpr const char *ASSET_BASE_PATH = "../assets/";
@@ -31,6 +134,12 @@ constexpr const char *MODEL_PATH = "../assets/models/";
 constexpr const char *SHADER_PATH = "../assets/shaders/";
 constexpr const char *TEXTURE_PATH = "../assets/textures/";
 constexpr const char *SOUND_PATH = "../assets/sounds/";
+// Generated data (imported meshes, ...), safe to delete
+constexpr const char *MESH_CACHE_PATH = "../assets/cache/meshes/";
+constexpr const char *TEXTURE_CACHE_PATH = "../assets/cache/textures/";
+constexpr const char *PROGRAM_CACHE_PATH = "../assets/cache/programs/";
+// Pre-cooked assets in one mapped file; mounted at startup if present (loose files otherwise)
+constexpr const char *ASSET_PACK_PATH = "../assets/assets.pack";
 
 // ========== SHADER FILES ==========
 constexpr const char *SHADER_VERTEX = "../assets/shaders/vertexShader.vert";
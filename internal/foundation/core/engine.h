@@ -1,16 +1,24 @@
 #pragma once
 #include "components/lightComponent.h"
+#include "foundation/core/sceneFile.h"
 #include "foundation/ecs/componentManager.h"
 #include "foundation/ecs/entityManager.h"
 #include "foundation/ecs/systemManager.h"
+#include <cstdint>
 #include <glm/glm.hpp>
 #include <string>
 
+class JobSystem;
+struct RenderStats;
+struct ResourceMemoryStats;
+struct StreamingStats;
+
 // Central engine coordinator using ECS architecture
 class Engine {
 private:
   float m_screenWidth;
   float m_screenHeight;
+  bool m_headless;
 
   EntityManager entityManager;
   ComponentManager componentManager;
@@ -20,20 +28,46 @@ private:
   bool loadResources();
 
   void loop(bool &running);
+  void frame(bool &running); // update + render, then close the profiler frame
   void update(bool &running);
   void render();
 
 public:
-  Engine();
+  // headless: no window/UI, rendering goes to the recording NullBackend
+  explicit Engine(bool headless = false);
   ~Engine();
 
   bool init();
   void run();
 
+  // run a fixed number of frames (benchmarks, headless tests)
+  void runFrames(uint32_t frameCount);
+
+  bool isHeadless() const;
+  const RenderStats &getRenderStats();
+  ResourceMemoryStats getResourceMemoryStats();
+  // Worker pool shared by the engine's systems (tools and benchmarks submit to it too)
+  JobSystem &getJobSystem();
+
   // High-level entity creation (delegated to SceneSystem)
   void createCameraEntity(glm::vec3 position, float yaw = 0.0f, float pitch = 0.0f, float fov = 90.0f);
   void createModelEntity(const std::string &name, const std::string &modelPath, glm::vec3 position, glm::vec3 rotation,
                          glm::vec3 scale);
+  bool createGltfEntities(const std::string &path, glm::vec3 position, glm::vec3 rotation, glm::vec3 scale);
   void createLightEntity(const std::string &name, glm::vec3 position, glm::vec3 direction, glm::vec3 color,
                          LightType type, float intensity, float cutOff, float outerCutOff);
+
+  // Scene files (delegated to SceneSystem); loading replaces the current scene
+  bool saveScene(const std::string &path, SceneFile::Format format = SceneFile::Format::Json);
+  bool loadScene(const std::string &path);
+
+  // World streaming (delegated to SceneSystem / StreamingSystem): save the scene as a grid of cells, then stream
+  // a saved world around the active camera (resident entities stay; loadScene closes the world)
+  bool saveWorld(const std::string &directory, float cellSize);
+  bool openWorld(const std::string &directory);
+  void closeWorld();
+  StreamingStats getStreamingStats();
+
+  // Move the active camera (scripted camera paths, benchmarks)
+  void setCameraPosition(glm::vec3 position);
 };
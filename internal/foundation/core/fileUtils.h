@@ -0,0 +1,24 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+// Helpers for caches keyed on source files.
+namespace FileUtils {
+
+// FNV-1a of a byte range, continuing from hash (chain calls to hash several ranges)
+uint64_t hashData(const void *data, size_t size, uint64_t hash = 1469598103934665603ull);
+
+// FNV-1a of the lexically normalized path ("a/./b" and "a/b" hash the same)
+uint64_t hashPath(const std::string &path);
+
+// Write time (file clock ticks) and size of a file; false if it does not exist
+bool getFileStamp(const std::string &path, int64_t &modified, uint64_t &size);
+
+// FNV-1a of the file contents (content hash for incremental asset cooking); false if unreadable
+bool hashFile(const std::string &path, uint64_t &hash);
+
+// Write data to path atomically (temp file + rename), creating parent directories
+bool writeFileAtomic(const std::string &path, const void *data, size_t size);
+
+} // namespace FileUtils
@@ -0,0 +1,40 @@
+#pragma once
+#include <chrono>
+#include <filesystem>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+// Reports watched files that were written since the last poll, without blocking.
+// Linux uses inotify on the parent directories (so editors that save by renaming a temporary file are seen);
+// other platforms compare last write times, at most every EngineConfig::HOT_RELOAD_POLL_MS.
+class FileWatcher {
+private:
+  std::unordered_set<std::string> m_files; // normalized absolute paths
+#ifdef __linux__
+  int m_fd = -1;
+  std::unordered_map<int, std::string> m_directories; // watch descriptor -> normalized directory
+#else
+  std::unordered_map<std::string, std::filesystem::file_time_type> m_writeTimes;
+  std::chrono::steady_clock::time_point m_lastPoll;
+#endif
+
+  static std::string normalize(const std::string &path);
+
+public:
+  FileWatcher();
+  ~FileWatcher();
+
+  FileWatcher(const FileWatcher &) = delete;
+  FileWatcher &operator=(const FileWatcher &) = delete;
+
+  // Start reporting changes to path (watching a file twice is harmless).
+  // Returns the normalized path poll() reports it as.
+  std::string watch(const std::string &path);
+
+  // Appends each changed file once (normalized path)
+  void poll(std::vector<std::string> &changed);
+
+  size_t getWatchCount() const;
+};
@@ -0,0 +1,32 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+// Read-only memory mapping of a whole file (mmap / MapViewOfFile).
+// The data stays valid until close() or destruction; pages are loaded on first touch.
+class MappedFile {
+private:
+  const uint8_t *m_data = nullptr;
+  size_t m_size = 0;
+#ifdef _WIN32
+  void *m_file = nullptr;
+  void *m_mapping = nullptr;
+#endif
+
+public:
+  MappedFile() = default;
+  ~MappedFile();
+
+  MappedFile(const MappedFile &) = delete;
+  MappedFile &operator=(const MappedFile &) = delete;
+  MappedFile(MappedFile &&other) noexcept;
+  MappedFile &operator=(MappedFile &&other) noexcept;
+
+  bool open(const std::string &path);
+  void close();
+
+  bool isOpen() const;
+  const uint8_t *getData() const;
+  size_t getSize() const;
+};
@@ -0,0 +1,85 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// One finished zone (times in ns since profiler start)
+struct ProfileEvent {
+  const char *name; // must be a string literal / static string
+  uint64_t start = 0;
+  uint64_t end = 0;
+  uint32_t threadId = 0;
+  uint32_t depth = 0;
+};
+
+// Zone timings of one frame, merged by name over all threads
+struct ProfileZoneStats {
+  const char *name;
+  uint32_t depth = 0;
+  uint32_t calls = 0;
+  double totalMs = 0.0;
+};
+
+// All events recorded between two endFrame() calls
+struct ProfileFrame {
+  uint64_t start = 0;
+  uint64_t end = 0;
+  std::vector<ProfileEvent> events;
+};
+
+// Scoped CPU zone profiler.
+// Every thread writes into its own ring buffer without locking; endFrame() (main thread)
+// drains all rings into the frame history. A disabled profiler costs one relaxed load per zone.
+namespace Profiler {
+void setEnabled(bool enabled);
+bool isEnabled();
+
+// nanoseconds since profiler start (steady clock)
+uint64_t now();
+
+void beginZone(const char *name);
+void endZone();
+
+// name shown for the calling thread in the trace / overlay
+void setThreadName(const std::string &name);
+std::string getThreadName(uint32_t threadId);
+
+// close the current frame: collect events of all threads
+void endFrame();
+
+// last completed frame and its per-zone summary
+const ProfileFrame &getLastFrame();
+std::vector<ProfileZoneStats> getZoneStats();
+
+// events of the recorded frame history as Chrome trace-event JSON (chrome://tracing, Perfetto)
+bool writeChromeTrace(const std::string &path);
+} // namespace Profiler
+
+// RAII zone, use through PROFILE_ZONE
+class ProfileZone {
+private:
+  bool m_active;
+
+public:
+  explicit ProfileZone(const char *name) : m_active(Profiler::isEnabled()) {
+    if (m_active)
+      Profiler::beginZone(name);
+  }
+  ~ProfileZone() {
+    if (m_active)
+      Profiler::endZone();
+  }
+
+  ProfileZone(const ProfileZone &) = delete;
+  ProfileZone &operator=(const ProfileZone &) = delete;
+};
+
+#define PROFILE_CONCAT_INNER(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_INNER(a, b)
+
+// Build with ENGINE_NO_PROFILER to compile all zones out
+#ifdef ENGINE_NO_PROFILER
+#define PROFILE_ZONE(name)
+#else
+#define PROFILE_ZONE(name) ProfileZone PROFILE_CONCAT(profileZone, __LINE__)(name)
+#endif
@@ -0,0 +1,112 @@
+#pragma once
+#include <cstdint>
+#include <glm/glm.hpp>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Saved scene, held as one column per component field. Two file forms:
+// - JSON: one object per entity with its components, for editing by hand
+// - snapshot: header | columns, each column a raw array (8-byte aligned) read back with a single copy
+// Entities are numbered 0..entityCount-1 in the file. Assets are referenced by path (relative to the scene
+// file) through the mesh and material tables, so each distinct asset is resolved once when instantiated.
+namespace SceneFile {
+
+// Bump when the snapshot layout or the JSON schema changes
+constexpr uint32_t FORMAT_VERSION = 1;
+constexpr uint32_t NO_STRING = 0xFFFFFFFFu; // unnamed entity, or texture slot left to the fallback map
+
+enum class Format { Json, Snapshot };
+
+struct MaterialRecord {
+  uint32_t textures[4]; // path string per MaterialSlot
+  float shininess;
+};
+
+struct LightRecord {
+  uint32_t entity;
+  uint32_t type; // LightType
+  glm::vec3 position;
+  glm::vec3 direction;
+  glm::vec3 color;
+  float intensity;
+  float ambient;
+  float constant;
+  float linear;
+  float quadratic;
+  float cutOff; // cosines, as in LightComponent
+  float outerCutOff;
+};
+
+struct CameraRecord {
+  uint32_t entity;
+  uint32_t active; // the camera CameraSystem renders from
+  glm::vec3 position;
+  float yaw;
+  float pitch;
+  float fov;
+  float moveSpeed;
+  float mouseSensitivity;
+  float smoothFactor;
+};
+
+struct Data {
+  uint32_t entityCount = 0;
+  std::vector<std::string> strings; // names and asset paths
+  std::vector<uint32_t> names;      // per entity, NO_STRING if unnamed
+
+  // Transform pool
+  std::vector<uint32_t> transformEntities;
+  std::vector<glm::vec3> positions;
+  std::vector<glm::vec3> rotations;
+  std::vector<glm::vec3> scales;
+
+  // Model pool: mesh table entry and the material table entries [materialStart, materialStart + materialCount)
+  // of modelMaterials, one per submesh
+  std::vector<uint32_t> modelEntities;
+  std::vector<uint32_t> modelMeshes;
+  std::vector<uint32_t> modelMaterialStarts;
+  std::vector<uint32_t> modelMaterialCounts;
+  std::vector<uint32_t> modelMaterials;
+
+  // Asset tables
+  std::vector<uint32_t> meshes; // path strings
+  std::vector<MaterialRecord> materials;
+
+  std::vector<uint32_t> occluders;
+  std::vector<LightRecord> lights;
+  std::vector<CameraRecord> cameras;
+
+  // Index of value in strings, added on first use
+  uint32_t addString(const std::string &value);
+
+private:
+  std::unordered_map<std::string, uint32_t> m_stringIndices;
+};
+
+// World: the index of a grid of cell snapshots on the XZ plane, kept beside them in the world directory
+constexpr const char *WORLD_INDEX_FILE = "world.json";
+
+struct WorldCell {
+  int32_t x = 0; // cell coordinates: it covers [x, x + 1) * cellSize by [z, z + 1) * cellSize
+  int32_t z = 0;
+  std::string file; // snapshot, relative to the world directory
+  uint32_t entityCount = 0;
+};
+
+struct World {
+  float cellSize = 0.0f;
+  std::vector<WorldCell> cells;
+};
+
+// Write the scene in either form (atomic: temp file + rename)
+bool write(const std::string &path, const Data &data, Format format);
+
+// Read a scene file of either form (detected from its contents); false if it is malformed or references
+// entities, strings or table entries that do not exist
+bool read(const std::string &path, Data &data);
+
+bool writeWorld(const std::string &path, const World &world);
+bool readWorld(const std::string &path, World &world);
+
+} // namespace SceneFile
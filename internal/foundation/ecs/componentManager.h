@@ -68,6 +68,15 @@ public:
       map.erase(entity);
   }
 
+  // Remove every component of every entity
+  void clear() { m_storage.clear(); }
+
+  // Make room for count more components of a type (bulk inserts)
+  template <typename T> void reserve(size_t count) {
+    auto &map = m_storage[std::type_index(typeid(T))];
+    map.reserve(map.size() + count);
+  }
+
   // Remove specific component type from entity
   template <typename T> void remove(Entity entity) { m_storage[std::type_index(typeid(T))].erase(entity); }
 };
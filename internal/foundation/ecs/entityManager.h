@@ -12,6 +12,8 @@ private:
 public:
   Entity createEntity();
   void destroyEntity(Entity entity);
+  void clear(); // destroy every entity (IDs are not reused)
 
   bool isAlive(Entity entity) const { return m_activeEntities.count(entity) > 0; }
+  const std::unordered_set<Entity> &getEntities() const { return m_activeEntities; }
 };
@@ -0,0 +1,99 @@
+#pragma once
+#include "foundation/core/config.h"
+#include "rendering/backend/renderBackend.h"
+#include <SDL3/SDL.h>
+#include <array>
+#include <unordered_map>
+
+// OpenGL 3.3 backend (requires a current context and loaded GLAD)
+class GLBackend : public RenderBackend {
+private:
+  SDL_Window *m_window;
+
+  // Compressed format support, queried once on the context thread (readable from any thread)
+  bool m_supportsS3tc = false;
+  bool m_supportsBptc = false;
+  // GL 4.1 / ARB_get_program_binary with at least one binary format
+  bool m_supportsProgramBinary = false;
+  // KHR_parallel_shader_compile: program completion can be polled without blocking
+  bool m_supportsParallelCompile = false;
+
+  // Stage objects of programs whose build was issued but not finished yet
+  struct PendingProgram {
+    uint32_t vertexShader;
+    uint32_t fragmentShader;
+  };
+  std::unordered_map<uint32_t, PendingProgram> m_pendingPrograms;
+
+  // Pixel unpack ring for streamed textures: persistent-mapped with GL 4.4 buffer storage,
+  // filled with glBufferSubData otherwise. A segment is fenced when its frame is presented.
+  struct StagingSegment {
+    void *fence = nullptr; // GLsync
+    size_t used = 0;
+  };
+  uint32_t m_stagingBuffer = 0;
+  unsigned char *m_stagingData = nullptr;
+  std::array<StagingSegment, EngineConfig::TEXTURE_STAGING_SEGMENTS> m_staging;
+  uint32_t m_stagingSegment = 0;
+
+  void createStagingRing();
+  void uploadRows(int level, int y, int width, int rows, TextureFormat format, const void *pixels);
+
+  uint32_t compileStage(unsigned int type, const std::string &source);
+
+public:
+  explicit GLBackend(SDL_Window *window);
+
+  const char *getName() const override;
+
+  void clear() override;
+  void present() override;
+  void setViewport(int x, int y, int width, int height) override;
+  void bindFramebuffer(uint32_t framebuffer) override;
+
+  MeshBuffers createMeshBuffers(const void *vertices, size_t vertexBytes, size_t vertexStride,
+                                const std::vector<VertexAttribute> &layout, const uint32_t *indices,
+                                size_t indexCount) override;
+  void destroyMeshBuffers(const MeshBuffers &buffers) override;
+  void drawIndexed(uint32_t vertexArray, uint32_t indexStart, uint32_t indexCount) override;
+
+  bool supportsTextureFormat(TextureFormat format) const override;
+  uint32_t createTexture2D(int width, int height, TextureFormat format, const void *pixels,
+                           bool generateMipmaps) override;
+  void updateTexture2D(uint32_t texture, int width, int height, TextureFormat format, const void *pixels,
+                       bool generateMipmaps) override;
+  void deleteTexture(uint32_t texture) override;
+  void allocateTexture2D(uint32_t texture, int width, int height, TextureFormat format, int levelCount) override;
+  size_t getTextureStagingSpace() override;
+  bool uploadTextureRows(uint32_t texture, int level, int y, int width, int rows, TextureFormat format,
+                         const void *pixels) override;
+  void setTextureBaseLevel(uint32_t texture, int level) override;
+  void uploadTextureLevel(uint32_t texture, int level, int width, int height, TextureFormat format,
+                          const void *pixels) override;
+  void bindTexture(int unit, uint32_t texture) override;
+
+  void createDepthTarget(int width, int height, uint32_t &framebuffer, uint32_t &depthTexture) override;
+
+  uint32_t createProgram(const std::string &vertexSource, const std::string &fragmentSource,
+                         std::string &errorLog) override;
+  uint32_t compileProgram(const std::string &vertexSource, const std::string &fragmentSource) override;
+  bool isProgramReady(uint32_t program) override;
+  bool finishProgram(uint32_t program, std::string &errorLog) override;
+  void deleteProgram(uint32_t program) override;
+  void useProgram(uint32_t program) override;
+  int getUniformLocation(uint32_t program, const char *name) override;
+  std::string getProgramBinaryDriver() const override;
+  bool getProgramBinary(uint32_t program, uint32_t &format, std::vector<uint8_t> &binary) override;
+  uint32_t createProgramFromBinary(uint32_t format, const void *binary, size_t size) override;
+
+  void setUniform(int location, int value) override;
+  void setUniform(int location, float value) override;
+  void setUniform(int location, const glm::vec3 &value) override;
+  void setUniform(int location, const glm::mat3 &value) override;
+  void setUniform(int location, const glm::mat4 &value) override;
+
+  uint32_t createTimestampQuery() override;
+  void deleteQuery(uint32_t query) override;
+  void writeTimestamp(uint32_t query) override;
+  bool readTimestamp(uint32_t query, uint64_t &timestamp) override;
+};
@@ -0,0 +1,110 @@
+#pragma once
+#include "rendering/backend/renderBackend.h"
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+
+// Counters recorded by the null backend
+struct BackendCounters {
+  uint64_t drawCalls = 0;
+  uint64_t indices = 0;
+  uint64_t programBinds = 0;
+  uint64_t textureBinds = 0;
+  uint64_t framebufferBinds = 0;
+  uint64_t viewportChanges = 0;
+  uint64_t uniformUploads = 0;
+  uint64_t bufferBytesUploaded = 0;
+  uint64_t textureBytesUploaded = 0;
+};
+
+// Backend without a GPU: records draw calls, state changes, uniform uploads and
+// buffer sizes so the frame pipeline can run (and be measured) headless.
+class NullBackend : public RenderBackend {
+private:
+  uint32_t m_nextObject = 1;
+  uint32_t m_frameCount = 0;
+
+  BackendCounters m_current; // frame in progress
+  BackendCounters m_lastFrame;
+  BackendCounters m_total;
+
+  // program -> (uniform name -> location)
+  std::unordered_map<uint32_t, std::unordered_map<std::string, int>> m_uniforms;
+  // background builds that finishProgram reports as failed
+  std::unordered_set<uint32_t> m_failedPrograms;
+
+  // timestamp queries resolve immediately to the CPU submission time
+  std::unordered_map<uint32_t, uint64_t> m_timestamps;
+
+  // live GPU allocations (object -> bytes)
+  std::unordered_map<uint32_t, size_t> m_bufferBytes;
+  std::unordered_map<uint32_t, size_t> m_textureBytes;
+
+  // staging bytes used this frame (the ring is assumed to be free again next frame)
+  size_t m_stagingUsed = 0;
+
+  void count(uint64_t BackendCounters::*counter, uint64_t amount = 1);
+
+public:
+  const char *getName() const override;
+
+  void clear() override;
+  void present() override;
+  void setViewport(int x, int y, int width, int height) override;
+  void bindFramebuffer(uint32_t framebuffer) override;
+
+  MeshBuffers createMeshBuffers(const void *vertices, size_t vertexBytes, size_t vertexStride,
+                                const std::vector<VertexAttribute> &layout, const uint32_t *indices,
+                                size_t indexCount) override;
+  void destroyMeshBuffers(const MeshBuffers &buffers) override;
+  void drawIndexed(uint32_t vertexArray, uint32_t indexStart, uint32_t indexCount) override;
+
+  bool supportsTextureFormat(TextureFormat format) const override;
+  uint32_t createTexture2D(int width, int height, TextureFormat format, const void *pixels,
+                           bool generateMipmaps) override;
+  void updateTexture2D(uint32_t texture, int width, int height, TextureFormat format, const void *pixels,
+                       bool generateMipmaps) override;
+  void deleteTexture(uint32_t texture) override;
+  void allocateTexture2D(uint32_t texture, int width, int height, TextureFormat format, int levelCount) override;
+  size_t getTextureStagingSpace() override;
+  bool uploadTextureRows(uint32_t texture, int level, int y, int width, int rows, TextureFormat format,
+                         const void *pixels) override;
+  void setTextureBaseLevel(uint32_t texture, int level) override;
+  void uploadTextureLevel(uint32_t texture, int level, int width, int height, TextureFormat format,
+                          const void *pixels) override;
+  void bindTexture(int unit, uint32_t texture) override;
+
+  void createDepthTarget(int width, int height, uint32_t &framebuffer, uint32_t &depthTexture) override;
+
+  uint32_t createProgram(const std::string &vertexSource, const std::string &fragmentSource,
+                         std::string &errorLog) override;
+  uint32_t compileProgram(const std::string &vertexSource, const std::string &fragmentSource) override;
+  bool isProgramReady(uint32_t program) override;
+  bool finishProgram(uint32_t program, std::string &errorLog) override;
+  void deleteProgram(uint32_t program) override;
+  void useProgram(uint32_t program) override;
+  int getUniformLocation(uint32_t program, const char *name) override;
+  std::string getProgramBinaryDriver() const override;
+  bool getProgramBinary(uint32_t program, uint32_t &format, std::vector<uint8_t> &binary) override;
+  uint32_t createProgramFromBinary(uint32_t format, const void *binary, size_t size) override;
+
+  void setUniform(int location, int value) override;
+  void setUniform(int location, float value) override;
+  void setUniform(int location, const glm::vec3 &value) override;
+  void setUniform(int location, const glm::mat3 &value) override;
+  void setUniform(int location, const glm::mat4 &value) override;
+
+  uint32_t createTimestampQuery() override;
+  void deleteQuery(uint32_t query) override;
+  void writeTimestamp(uint32_t query) override;
+  bool readTimestamp(uint32_t query, uint64_t &timestamp) override;
+
+  // counters of the last presented frame / since creation
+  const BackendCounters &getFrameCounters() const;
+  const BackendCounters &getTotalCounters() const;
+  uint32_t getFrameCount() const;
+
+  // bytes currently held by (simulated) GPU buffers and textures
+  size_t getResidentBufferBytes() const;
+  size_t getResidentTextureBytes() const;
+};
@@ -0,0 +1,143 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <glm/glm.hpp>
+#include <memory>
+#include <string>
+#include <vector>
+
+// Component type of a vertex attribute (normalized integer types read as [0,1] / [-1,1] floats)
+enum class AttributeType { Float, HalfFloat, UnsignedShort, Int2101010 };
+
+// One vertex attribute of a vertex buffer (interleaved, or one array per attribute with their own strides)
+struct VertexAttribute {
+  uint32_t location;
+  int components;
+  AttributeType type;
+  bool normalized;
+  size_t offset;
+  size_t stride = 0; // bytes between elements, 0 = the buffer's vertex stride
+};
+
+// GPU objects backing a mesh
+struct MeshBuffers {
+  uint32_t vertexArray = 0;
+  uint32_t vertexBuffer = 0;
+  uint32_t indexBuffer = 0;
+};
+
+// Uncompressed 8-bit formats, and block-compressed formats storing 4x4 texel blocks:
+// BC1 (RGB, 8 bytes), BC3 (RGBA, 16), BC5 (two channels, for normal maps, 16), BC7 (RGBA, 16)
+enum class TextureFormat { RGB8, RGBA8, BC1, BC3, BC5, BC7 };
+
+inline bool isCompressedFormat(TextureFormat format) {
+  return format != TextureFormat::RGB8 && format != TextureFormat::RGBA8;
+}
+
+// Channels of an uncompressed format (or of the image a compressed format was encoded from)
+inline int getTextureChannels(TextureFormat format) {
+  return format == TextureFormat::RGB8 || format == TextureFormat::BC1 ? 3 : 4;
+}
+
+// Texel rows per upload unit: one row of blocks for compressed formats
+inline int getTextureRowGranularity(TextureFormat format) { return isCompressedFormat(format) ? 4 : 1; }
+
+// Bytes of a width x height image (compressed sizes round up to whole blocks)
+inline size_t getTextureLevelBytes(TextureFormat format, int width, int height) {
+  if (!isCompressedFormat(format))
+    return static_cast<size_t>(width) * height * getTextureChannels(format);
+  size_t blocks = static_cast<size_t>((width + 3) / 4) * ((height + 3) / 4);
+  return blocks * (format == TextureFormat::BC1 ? 8 : 16);
+}
+
+inline const char *getTextureFormatName(TextureFormat format) {
+  static const char *names[] = {"RGB8", "RGBA8", "BC1", "BC3", "BC5", "BC7"};
+  return names[static_cast<int>(format)];
+}
+
+// Thin rendering API used by Renderer and the GPU resources (Mesh, Material, Shader).
+// One backend is active per process, like the GL context it usually wraps.
+class RenderBackend {
+public:
+  virtual ~RenderBackend() = default;
+
+  // Active backend (throws if none was set)
+  static RenderBackend &get();
+  static void set(std::unique_ptr<RenderBackend> backend);
+
+  virtual const char *getName() const = 0;
+
+  // Frame
+  virtual void clear() = 0;
+  virtual void present() = 0;
+  virtual void setViewport(int x, int y, int width, int height) = 0;
+  virtual void bindFramebuffer(uint32_t framebuffer) = 0;
+
+  // Geometry
+  virtual MeshBuffers createMeshBuffers(const void *vertices, size_t vertexBytes, size_t vertexStride,
+                                        const std::vector<VertexAttribute> &layout, const uint32_t *indices,
+                                        size_t indexCount) = 0;
+  virtual void destroyMeshBuffers(const MeshBuffers &buffers) = 0;
+  virtual void drawIndexed(uint32_t vertexArray, uint32_t indexStart, uint32_t indexCount) = 0;
+
+  // Textures (repeat wrapping, linear filtering, trilinear when mipmapped).
+  // createTexture2D/updateTexture2D take uncompressed formats only; compressed textures go through
+  // allocateTexture2D + uploadTextureRows/uploadTextureLevel.
+  virtual bool supportsTextureFormat(TextureFormat format) const = 0;
+  virtual uint32_t createTexture2D(int width, int height, TextureFormat format, const void *pixels,
+                                   bool generateMipmaps) = 0;
+  // Replace size and contents of an existing texture (its name stays valid, e.g. placeholder -> streamed image)
+  virtual void updateTexture2D(uint32_t texture, int width, int height, TextureFormat format, const void *pixels,
+                               bool generateMipmaps) = 0;
+  virtual void deleteTexture(uint32_t texture) = 0;
+
+  // Streamed textures: allocateTexture2D gives an existing name storage for levelCount levels (contents
+  // undefined) and samples only the last level; setTextureBaseLevel exposes finer levels once uploaded.
+  // Rows are copied through a staging ring recycled per frame in flight: getTextureStagingSpace is what can
+  // still be uploaded this frame, uploadTextureRows fails (without stalling) if the rows do not fit.
+  virtual void allocateTexture2D(uint32_t texture, int width, int height, TextureFormat format, int levelCount) = 0;
+  virtual size_t getTextureStagingSpace() = 0;
+  virtual bool uploadTextureRows(uint32_t texture, int level, int y, int width, int rows, TextureFormat format,
+                                 const void *pixels) = 0;
+  virtual void setTextureBaseLevel(uint32_t texture, int level) = 0;
+  // Whole level straight from client memory (synchronous loads)
+  virtual void uploadTextureLevel(uint32_t texture, int level, int width, int height, TextureFormat format,
+                                  const void *pixels) = 0;
+
+  virtual void bindTexture(int unit, uint32_t texture) = 0;
+
+  // Depth-only render target used by the shadow pass
+  virtual void createDepthTarget(int width, int height, uint32_t &framebuffer, uint32_t &depthTexture) = 0;
+
+  // Programs (returns 0 and fills errorLog on failure)
+  virtual uint32_t createProgram(const std::string &vertexSource, const std::string &fragmentSource,
+                                 std::string &errorLog) = 0;
+  // Background builds: compileProgram returns at once, isProgramReady polls without blocking (drivers without
+  // parallel compile report ready and build in finishProgram), finishProgram returns false, fills errorLog and
+  // deletes the program if the build failed
+  virtual uint32_t compileProgram(const std::string &vertexSource, const std::string &fragmentSource) = 0;
+  virtual bool isProgramReady(uint32_t program) = 0;
+  virtual bool finishProgram(uint32_t program, std::string &errorLog) = 0;
+  virtual void deleteProgram(uint32_t program) = 0;
+  virtual void useProgram(uint32_t program) = 0;
+  virtual int getUniformLocation(uint32_t program, const char *name) = 0;
+
+  // Linked program binaries (program cache). getProgramBinaryDriver identifies the driver binaries are valid
+  // for ("" if binaries are unsupported); createProgramFromBinary returns 0 if the driver rejects the binary.
+  virtual std::string getProgramBinaryDriver() const = 0;
+  virtual bool getProgramBinary(uint32_t program, uint32_t &format, std::vector<uint8_t> &binary) = 0;
+  virtual uint32_t createProgramFromBinary(uint32_t format, const void *binary, size_t size) = 0;
+
+  // Uniform uploads to the program in use
+  virtual void setUniform(int location, int value) = 0;
+  virtual void setUniform(int location, float value) = 0;
+  virtual void setUniform(int location, const glm::vec3 &value) = 0;
+  virtual void setUniform(int location, const glm::mat3 &value) = 0;
+  virtual void setUniform(int location, const glm::mat4 &value) = 0;
+
+  // GPU timestamp queries (ns); readTimestamp never blocks and returns false until the result is available
+  virtual uint32_t createTimestampQuery() = 0;
+  virtual void deleteQuery(uint32_t query) = 0;
+  virtual void writeTimestamp(uint32_t query) = 0;
+  virtual bool readTimestamp(uint32_t query, uint64_t &timestamp) = 0;
+};
@@ -0,0 +1,60 @@
+#pragma once
+#include "foundation/core/config.h"
+#include "rendering/resources/mesh.h"
+#include <cstdint>
+#include <glm/glm.hpp>
+#include <vector>
+
+class JobSystem;
+
+// Software occlusion culling (pure CPU, no GL calls).
+// Occluder triangles are rasterized into a low resolution depth buffer, tile by tile,
+// then reduced into a max-depth pyramid that bounding boxes are tested against.
+class OcclusionCuller {
+private:
+  // Edge functions and depth plane of a screen-space triangle (pixel units, y up)
+  struct ScreenTriangle {
+    float edgeA[3], edgeB[3], edgeC[3];
+    float depthA, depthB, depthC;
+    int minX, minY, maxX, maxY;
+  };
+
+  int m_width;
+  int m_height;
+  int m_tilesX;
+  int m_tilesY;
+
+  glm::mat4 m_viewProjection{1.0f};
+  std::vector<ScreenTriangle> m_triangles;
+  std::vector<std::vector<uint32_t>> m_tileBins;
+
+  // Level 0 is the full resolution depth buffer; each level keeps the max of 2x2 texels
+  std::vector<std::vector<float>> m_pyramid;
+  std::vector<glm::ivec2> m_levelSizes;
+
+  void rasterizeTile(int tile);
+  void buildPyramid();
+
+public:
+  OcclusionCuller(int width = EngineConfig::OCCLUSION_BUFFER_WIDTH,
+                  int height = EngineConfig::OCCLUSION_BUFFER_HEIGHT);
+
+  // clear depth and occluders for a new view
+  void beginFrame(const glm::mat4 &viewProjection);
+
+  // queue occluder triangles (front-facing, fully in front of the near plane);
+  // positions are positionStride bytes apart (a Vertex array or tightly packed positions)
+  void addOccluder(const glm::vec3 *positions, size_t positionStride, const uint32_t *indices, size_t indexCount,
+                   const glm::mat4 &model);
+
+  // rasterize queued occluders and build the depth pyramid (jobs may be null)
+  void rasterize(JobSystem *jobs);
+
+  // conservative test of a local-space AABB; false only if hidden or outside the view
+  bool isVisible(const glm::vec3 &boundsMin, const glm::vec3 &boundsMax, const glm::mat4 &model) const;
+
+  int getWidth() const;
+  int getHeight() const;
+  size_t getOccluderTriangleCount() const;
+  const std::vector<float> &getDepthBuffer() const;
+};
@@ -0,0 +1,21 @@
+#pragma once
+#include "rendering/resources/mesh.h"
+#include <cstdint>
+#include <vector>
+
+// Index/vertex buffer optimizations for the GPU vertex pipeline.
+namespace MeshOptimizer {
+
+// Merge bitwise-identical vertices; rewrites indices in place and returns the unique vertices
+std::vector<Vertex> deduplicateVertices(const std::vector<Vertex> &vertices, std::vector<uint32_t> &indices);
+
+// Reorder triangles for post-transform cache hits (Forsyth's linear-speed algorithm)
+void optimizeVertexCache(uint32_t *indices, size_t indexCount, size_t vertexCount);
+
+// Reorder vertices by first use so fetches walk memory linearly; remaps all indices
+void optimizeVertexFetch(std::vector<Vertex> &vertices, std::vector<uint32_t> &indices);
+
+// Average cache miss ratio (transformed vertices per triangle) of a FIFO cache
+float computeAcmr(const uint32_t *indices, size_t indexCount, size_t vertexCount, uint32_t cacheSize = 16);
+
+} // namespace MeshOptimizer
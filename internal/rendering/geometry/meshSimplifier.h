@@ -0,0 +1,17 @@
+#pragma once
+#include "rendering/resources/mesh.h"
+#include <cstdint>
+#include <vector>
+
+// Quadric error metric mesh simplification (Garland-Heckbert edge collapse).
+// Works on positions only: vertices sharing a position are welded for connectivity,
+// collapsed vertices snap to an existing vertex so normals/uvs remain valid.
+namespace MeshSimplifier {
+
+// Simplify a triangle list down to targetIndexCount indices (or until the next
+// collapse would exceed maxError, relative to the bounding box diagonal).
+// Returned indices reference the same vertex array as the input.
+std::vector<uint32_t> simplify(const std::vector<Vertex> &vertices, const uint32_t *indices, size_t indexCount,
+                               size_t targetIndexCount, float maxError);
+
+} // namespace MeshSimplifier
@@ -0,0 +1,25 @@
+#pragma once
+#include "rendering/resources/mesh.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+class JobSystem;
+
+// Wavefront OBJ reader for large files. The file is mapped and split at line boundaries into chunks that are
+// parsed in parallel (numbers with std::from_chars); face corners are then welded by their v/vt/vn triple in
+// one merge pass. Polygons are fan-triangulated and each 'o'/'g' statement starts a new submesh (groups
+// without faces are dropped). Materials, smoothing groups, lines and points are ignored.
+namespace ObjParser {
+
+struct Result {
+  std::vector<Vertex> vertices; // one per distinct v/vt/vn triple; V flipped for OpenGL, zero if absent
+  std::vector<uint32_t> indices;
+  std::vector<Submesh> submeshes;
+  uint32_t cornerCount = 0; // triangle corners read (vertices before welding)
+};
+
+// jobSystem may be null (chunks are parsed on the calling thread)
+bool parse(const std::string &path, Result &result, JobSystem *jobSystem = nullptr);
+
+} // namespace ObjParser
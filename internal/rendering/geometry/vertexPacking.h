@@ -0,0 +1,23 @@
+#pragma once
+#include "rendering/resources/mesh.h"
+#include <cstdint>
+#include <vector>
+
+// Quantized positions are decoded in the vertex shader: position = aPos * scale + offset,
+// aPos being the normalized [0,1] attribute fetch
+struct PositionDecode {
+  glm::vec3 scale{1.0f};
+  glm::vec3 offset{0.0f};
+};
+
+// Conversion of imported float vertices to the packed upload format.
+namespace VertexPacking {
+
+// Decode of positions quantized to 16 bits over boundsMin..boundsMax
+PositionDecode getPositionDecode(const glm::vec3 &boundsMin, const glm::vec3 &boundsMax);
+
+// Pack vertices; positions are quantized with the decode of getPositionDecode(boundsMin, boundsMax)
+std::vector<PackedVertex> packVertices(const Vertex *vertices, size_t vertexCount, const glm::vec3 &boundsMin,
+                                       const glm::vec3 &boundsMax);
+
+} // namespace VertexPacking
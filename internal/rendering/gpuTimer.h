@@ -0,0 +1,60 @@
+#pragma once
+#include "foundation/core/config.h"
+#include <array>
+#include <cstdint>
+#include <vector>
+
+// Passes timed on the GPU (Frame spans everything between beginFrame and present)
+enum class GpuPass : uint32_t { Frame, Shadow, Main, UI, Count };
+
+// Per-pass GPU timings from timestamp queries.
+// Each pass writes a begin/end timestamp; queries are read back GPU_TIMER_FRAMES_IN_FLIGHT
+// frames later, right before their slot is reused, so the CPU never waits on the GPU.
+class GpuTimer {
+private:
+  static constexpr uint32_t PASS_COUNT = static_cast<uint32_t>(GpuPass::Count);
+  static constexpr uint32_t SLOT_COUNT = EngineConfig::GPU_TIMER_FRAMES_IN_FLIGHT;
+
+  struct Slot {
+    std::array<uint32_t, PASS_COUNT> begin{};
+    std::array<uint32_t, PASS_COUNT> end{};
+    std::array<bool, PASS_COUNT> issued{};
+  };
+
+  std::array<Slot, SLOT_COUNT> m_slots;
+  uint32_t m_frame = 0;
+  bool m_initialized = false;
+
+  // rolling history per pass (ms), m_historyNext is the oldest sample once full
+  std::array<std::vector<float>, PASS_COUNT> m_history;
+  uint32_t m_historyNext = 0;
+  uint32_t m_historySize = 0;
+  std::array<float, PASS_COUNT> m_lastMs{};
+  uint32_t m_droppedFrames = 0;
+
+  Slot &currentSlot();
+  void collect(Slot &slot);
+
+public:
+  void init();
+
+  // read back the slot about to be reused, then start recording into it
+  void beginFrame();
+
+  void begin(GpuPass pass);
+  void end(GpuPass pass);
+
+  static const char *getPassName(GpuPass pass);
+
+  float getLastMs(GpuPass pass) const;
+  // p in [0, 1] over the rolling history
+  float getPercentile(GpuPass pass, float p) const;
+
+  // ring buffer for plotting: values, sample count and index of the oldest sample
+  const float *getHistory(GpuPass pass) const;
+  uint32_t getHistorySize() const;
+  uint32_t getHistoryOffset() const;
+
+  // frames whose results were not ready when their slot came around again
+  uint32_t getDroppedFrames() const;
+};
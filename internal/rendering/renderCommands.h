@@ -0,0 +1,38 @@
+#pragma once
+#include "rendering/resources/mesh.h"
+#include <cstdint>
+#include <glm/glm.hpp>
+#include <vector>
+
+class Material;
+
+// Constants shared by every draw of a frame
+struct FrameConstants {
+  glm::mat4 view{1.0f};
+  glm::mat4 projection{1.0f};
+  glm::mat4 lightSpaceMatrix{1.0f};
+  glm::vec3 viewPos{0.0f};
+  bool useShadows = false;
+  uint32_t shaderFeatures = 0; // ShaderFeatures every main-pass draw needs (shadows, light tier)
+};
+
+// One recorded draw. Filled on worker threads, replayed on the GL thread:
+// holds resolved resources and precomputed matrices, never GL state.
+struct DrawCommand {
+  uint32_t shaderHandle = 0;
+  uint32_t shaderFeatures = 0; // variant to draw with, resolved into shaderHandle before sorting
+  const Mesh *mesh = nullptr;
+  SubmeshLod range{};
+  const Material *material = nullptr; // null in depth-only passes
+  glm::mat4 model{1.0f};
+  glm::mat4 mvp{1.0f};
+  glm::mat3 normalMatrix{1.0f};
+};
+
+// Draw list of a pass, or of one chunk of a pass while recording
+struct RenderCommandList {
+  std::vector<DrawCommand> draws;
+
+  void clear() { draws.clear(); }
+  void append(const RenderCommandList &other) { draws.insert(draws.end(), other.draws.begin(), other.draws.end()); }
+};
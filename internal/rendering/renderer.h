@@ -1,17 +1,17 @@
 #pragma once
-#include <SDL3/SDL.h>
-#include <glad/glad.h>
+#include "rendering/gpuTimer.h"
+#include <cstdint>
 
 class Mesh;
 struct Submesh;
+struct SubmeshLod;
 
+// Frame and pass control on top of the active RenderBackend
 class Renderer {
 private:
-  SDL_Window *m_window = nullptr;
-
   // Shadow mapping
-  GLuint m_depthMapFBO = 0;
-  GLuint m_depthMap = 0;
+  uint32_t m_depthMapFBO = 0;
+  uint32_t m_depthMap = 0;
   const int m_shadowWidth = 4096;
   const int m_shadowHeight = 4096;
 
@@ -19,26 +19,30 @@ private:
   int m_screenWidth = 1280;
   int m_screenHeight = 720;
 
+  GpuTimer m_gpuTimer;
+
   void initShadowMapping();
 
 public:
-  void init(SDL_Window *window);
+  void init();
 
-  // Main render pass
-  void beginFrame() const;
-  void endFrame() const;
+  // Main render pass (the whole frame is timed as GpuPass::Frame)
+  void beginFrame();
+  void endFrame();
 
-  // Drawing
-  void drawMesh(const Mesh &mesh) const;
-  void drawSubmesh(const Mesh &mesh, const Submesh &submesh) const;
+  // Drawing (lod selects the submesh index range, clamped per submesh)
+  void drawMesh(const Mesh &mesh, uint32_t lod = 0) const;
+  void drawSubmesh(const Mesh &mesh, const Submesh &submesh, uint32_t lod = 0) const;
+  void drawRange(const Mesh &mesh, const SubmeshLod &range) const;
 
   // Shadow pass
   void beginShadowPass();
   void endShadowPass();
 
   // Getters
-  GLuint getDepthMap() const;
-  GLuint getDepthMapFBO() const;
+  uint32_t getDepthMap() const;
+  uint32_t getDepthMapFBO() const;
+  GpuTimer &getGpuTimer();
 
   void setViewportSize(int width, int height);
 };
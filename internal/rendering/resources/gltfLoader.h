@@ -0,0 +1,65 @@
+#pragma once
+#include "foundation/core/mappedFile.h"
+#include "rendering/resources/mesh.h"
+#include <cstdint>
+#include <glm/glm.hpp>
+#include <memory>
+#include <string>
+#include <vector>
+
+// Binary glTF 2.0 (.glb) reader. The JSON chunk is parsed into the few tables the engine uses; the binary chunk
+// stays mapped and accessor ranges are uploaded from it directly when their layout is one the vertex shader
+// reads (float positions, normals and UVs, interleaved or not). Other layouts are repacked into Vertex arrays.
+// Node hierarchies are flattened into world transforms (entities have no parents). Materials, skins, morph
+// targets and animations are ignored.
+namespace GltfLoader {
+
+// Accessor with its buffer view resolved to a range of the binary chunk
+struct Accessor {
+  size_t offset = 0; // into the binary chunk
+  size_t stride = 0; // bytes between elements
+  size_t count = 0;
+  uint32_t componentType = 0; // glTF (= GL enum) component type
+  int components = 0;
+  bool hasBounds = false;
+  glm::vec3 min{0.0f};
+  glm::vec3 max{0.0f};
+};
+
+// Triangle primitive: accessor indices, -1 if absent
+struct Primitive {
+  int position = -1;
+  int normal = -1;
+  int texCoord = -1;
+  int indices = -1;
+};
+
+struct MeshInfo {
+  std::string name;
+  std::vector<Primitive> primitives;
+};
+
+// Node of the default scene that has a mesh
+struct Instance {
+  std::string name;
+  uint32_t mesh = 0;
+  glm::mat4 world{1.0f};
+};
+
+struct Asset {
+  MappedFile file;
+  const uint8_t *binary = nullptr;
+  size_t binarySize = 0;
+  std::vector<Accessor> accessors;
+  std::vector<MeshInfo> meshes;
+  std::vector<Instance> instances;
+};
+
+// Parse the file; accessors are validated against the binary chunk
+bool load(const std::string &path, Asset &asset);
+
+// Upload a mesh of the asset (render thread), one submesh per primitive. zeroCopy reports whether the vertices
+// went to the GPU straight from the mapped file.
+std::unique_ptr<Mesh> createMesh(const Asset &asset, uint32_t meshIndex, bool *zeroCopy = nullptr);
+
+} // namespace GltfLoader
@@ -1,40 +1,98 @@
 #pragma once
+#include "foundation/core/mappedFile.h"
+#include "rendering/backend/renderBackend.h"
+#include <algorithm>
 #include <array>
 #include <cstdint>
 #include <filesystem>
-#include <glad/glad.h>
+#include <memory>
 #include <string>
+#include <vector>
 
+class JobSystem;
+
+// How a texture is sampled; decides its compressed format (normal maps keep two channels)
+enum class TextureUsage { Color, Normal };
+
+// Texture ready for upload: every mip level, uncompressed or block-compressed
+struct TextureImage {
+  int width = 0;
+  int height = 0;
+  TextureFormat format = TextureFormat::RGB8;
+
+  // Level pointers; each level halves the previous one (at least 1 texel)
+  std::vector<const unsigned char *> levels;
+
+  // Storage behind levels: decoded level 0 (stb_image), generated or encoded levels, or the mapped texture cache
+  std::unique_ptr<unsigned char, void (*)(void *)> pixels{nullptr, nullptr};
+  std::vector<unsigned char> levelData;
+  MappedFile mapping;
+
+  bool isLoaded() const { return !levels.empty(); }
+  int getLevelCount() const { return static_cast<int>(levels.size()); }
+  int getLevelWidth(int level) const { return std::max(1, width >> level); }
+  int getLevelHeight(int level) const { return std::max(1, height >> level); }
+  const unsigned char *getLevel(int level) const { return levels[level]; }
+  size_t getLevelBytes(int level) const {
+    return getTextureLevelBytes(format, getLevelWidth(level), getLevelHeight(level));
+  }
+  size_t getTotalBytes() const {
+    size_t bytes = 0;
+    for (int level = 0; level < getLevelCount(); ++level)
+      bytes += getLevelBytes(level);
+    return bytes;
+  }
+};
+
+// Texture maps of a material, in texture unit order
+enum class MaterialSlot { Diffuse, Specular, Normal, Emission, Count };
+
+// Parameter block: texture names, shininess and shader. Materials with equal parameters are interchangeable;
+// ResourceSystem::createMaterial shares one handle between them.
 class Material {
 private:
-  GLuint m_diffuse = 0;
-  GLuint m_specular = 0;
-  GLuint m_normal = 0;
-  GLuint m_emission = 0;
+  std::array<uint32_t, static_cast<size_t>(MaterialSlot::Count)> m_textures{};
   float m_shininess = 16.0f;
   uint32_t m_shaderHandle = 0;
 
 public:
   Material(); // Auto-init with default PBR fallbacks
-  Material(GLuint diffuse, GLuint specular, GLuint normal, GLuint emission, float shininess = 16.0f);
+  Material(uint32_t diffuse, uint32_t specular, uint32_t normal, uint32_t emission, float shininess = 16.0f);
+
+  bool operator==(const Material &other) const;
+  bool operator!=(const Material &other) const { return !(*this == other); }
+  uint64_t getHash() const;
 
   // Static utilities
-  static GLuint createFallbackTexture(const std::array<unsigned char, 3> &color);
-  static GLuint loadTexture(const std::filesystem::path &path);
+  static uint32_t createFallbackTexture(const std::array<unsigned char, 3> &color);
+  // 1x1 texture an unset map samples (gray diffuse, dim specular, flat normal, black emission); created on
+  // first use and shared by every material of the process
+  static uint32_t getFallbackTexture(MaterialSlot slot);
+  static uint32_t loadTexture(const std::filesystem::path &path, TextureUsage usage = TextureUsage::Color,
+                              JobSystem *jobSystem = nullptr);
+
+  // Split loadTexture: decode (file IO and encoding, any thread) and upload (render thread).
+  // path has no extension, the first supported image file wins.
+  static bool decodeTexture(const std::filesystem::path &path, TextureImage &image,
+                            TextureUsage usage = TextureUsage::Color, JobSystem *jobSystem = nullptr);
+  static uint32_t uploadTexture(const TextureImage &image);
 
   // Getters
-  GLuint getDiffuse() const;
-  GLuint getSpecular() const;
-  GLuint getNormal() const;
-  GLuint getEmission() const;
+  uint32_t getDiffuse() const;
+  uint32_t getSpecular() const;
+  uint32_t getNormal() const;
+  uint32_t getEmission() const;
   float getShininess() const;
   uint32_t getShaderHandle() const;
+  uint32_t getTexture(MaterialSlot slot) const;
+  bool hasNormalMap() const; // false while the normal map is the flat fallback
 
   // Setters (direct texture ID)
-  void setDiffuseTexture(GLuint texture);
-  void setSpecularTexture(GLuint texture);
-  void setNormalTexture(GLuint texture);
-  void setEmissionTexture(GLuint texture);
+  void setDiffuseTexture(uint32_t texture);
+  void setSpecularTexture(uint32_t texture);
+  void setNormalTexture(uint32_t texture);
+  void setEmissionTexture(uint32_t texture);
+  void setTexture(MaterialSlot slot, uint32_t texture);
 
   // Setters (load from path)
   void setDiffuse(const std::string &path);
@@ -1,38 +1,118 @@
 #pragma once
-#include <glad/glad.h>
+#include "foundation/core/config.h"
+#include "foundation/core/mappedFile.h"
+#include "rendering/backend/renderBackend.h"
+#include <array>
 #include <glm/glm.hpp>
 #include <string>
 #include <vector>
 
+class JobSystem;
+
 struct Vertex {
   glm::vec3 position;
   glm::vec3 normal;
   glm::vec2 texCoord;
 };
 
+// Compact GPU vertex (16 bytes instead of 32): position as 16-bit unorm within the mesh bounds
+// (w unused, keeps normal 4-byte aligned), normal as snorm 10_10_10_2, texCoord as half floats.
+struct PackedVertex {
+  uint16_t position[4];
+  uint32_t normal;
+  uint16_t texCoord[2];
+};
+
+struct SubmeshLod {
+  uint32_t indexStart;
+  uint32_t indexCount;
+};
+
 struct Submesh {
   uint32_t indexStart;
   uint32_t indexCount;
+
+  // Simplified index ranges for LOD 1..lodCount-1 (LOD 0 is indexStart/indexCount)
+  std::array<SubmeshLod, EngineConfig::MESH_LOD_COUNT - 1> lods{};
+  uint32_t lodCount = 1;
+
+  // Index range for a detail level (clamped to the coarsest available)
+  SubmeshLod getLod(uint32_t level) const {
+    if (level == 0 || lodCount <= 1)
+      return {indexStart, indexCount};
+    return lods[(level < lodCount ? level : lodCount - 1) - 1];
+  }
+};
+
+// Importer statistics (vertex welding and cache optimization)
+struct MeshImportStats {
+  uint32_t sourceVertices = 0; // one per triangle corner of the source file
+  uint32_t vertices = 0;       // after welding
+  float acmrBefore = 0.0f;     // welded, original triangle order
+  float acmrAfter = 0.0f;      // after cache optimization
+};
+
+// What a mesh keeps in CPU memory once its buffers are uploaded
+enum class MeshResidency {
+  GpuOnly,     // nothing: vertices and indices are released (mapped back from the mesh cache if needed later)
+  CpuAndGpu,   // full vertices and indices (picking, physics)
+  CpuPositions // positions and indices only (collision, occlusion culling)
 };
 
 class Mesh {
 private:
-  GLuint m_VAO = 0;
-  GLuint m_VBO = 0;
-  GLuint m_EBO = 0;
+  MeshBuffers m_buffers;
+  MeshResidency m_residency = MeshResidency::GpuOnly;
+  std::string m_sourcePath; // set by load(); released geometry is restored from its mesh cache
 
+  // Geometry is owned after an import, or read in place from the mapped mesh cache.
+  // Counts stay valid after the data is released.
   std::vector<Vertex> m_vertices;
   std::vector<uint32_t> m_indices;
+  MappedFile m_mapping;
+  const Vertex *m_vertexData = nullptr;
+  const uint32_t *m_indexData = nullptr;
+  size_t m_vertexCount = 0;
+  size_t m_indexCount = 0;
+
+  // Packed vertices waiting for upload (MESH_PACK_VERTICES): owned after an import, or in the mapped mesh cache
+  std::vector<PackedVertex> m_packedVertices;
+  const PackedVertex *m_packedData = nullptr;
+
+  // CpuPositions: what is left of the vertices after upload
+  std::vector<glm::vec3> m_positions;
+
+  size_t m_externalVertexBytes = 0; // vertex buffer of uploadExternal, in its source layout
+
   std::vector<Submesh> m_submeshes;
 
+  // Local-space bounding box
+  glm::vec3 m_boundsMin{0.0f};
+  glm::vec3 m_boundsMax{0.0f};
+  glm::vec3 m_positionScale{1.0f};
+  glm::vec3 m_positionOffset{0.0f};
+
+  MeshImportStats m_importStats;
+
+  void useOwnedGeometry();
+  void releaseCpuData();
+  bool restoreCpuData();
+  bool applyResidency();
+  void packVertices();
   void setupBuffers();
-  bool loadOBJ(const std::string &filename);
+  void computeBounds();
+  void optimizeGeometry();
+  void generateLods();
+  bool loadOBJ(const std::string &filename, JobSystem *jobSystem);
+  bool loadCached(const std::string &filename);
 
 public:
   Mesh() = default;
-  explicit Mesh(const std::string &filename);
-  Mesh(const std::vector<Vertex> &vertices, const std::vector<uint32_t> &indices,
-       const std::vector<Submesh> &submeshes);
+  explicit Mesh(const std::string &filename, JobSystem *jobSystem = nullptr);
+  // Takes the vectors (move them in to avoid copies). There is no file to restore from, so the CPU copy is
+  // kept unless residency says otherwise.
+  Mesh(std::vector<Vertex> vertices, std::vector<uint32_t> indices, std::vector<Submesh> submeshes,
+       MeshResidency residency = MeshResidency::CpuAndGpu);
   ~Mesh();
 
   // Prevent copy, allow move
@@ -41,9 +121,48 @@ public:
   Mesh(Mesh &&) = default;
   Mesh &operator=(Mesh &&) = default;
 
-  GLuint getVAO() const;
+  // Mesh(filename) split for background loading: load() reads the cache or imports the file
+  // without touching the GPU (any thread), upload() creates the buffers on the render thread.
+  // A job system parses large OBJ files in parallel.
+  bool load(const std::string &filename, JobSystem *jobSystem = nullptr);
+  void upload();
+  bool isUploaded() const;
+
+  // Upload vertices in their source layout straight from caller memory, e.g. accessors of a mapped glTF buffer
+  // (no repacking; float positions at location 0). Nothing is kept on the CPU.
+  void uploadExternal(const void *vertices, size_t vertexBytes, size_t vertexCount,
+                      const std::vector<VertexAttribute> &layout, const uint32_t *indices, size_t indexCount,
+                      std::vector<Submesh> submeshes, const glm::vec3 &boundsMin, const glm::vec3 &boundsMax);
+
+  size_t getUploadBytes() const;
+  // Geometry held in memory: owned vertices/indices/positions, the mapped cache file, packed vertices awaiting
+  // upload
+  size_t getCpuBytes() const;
+  size_t getGpuBytes() const; // uploaded buffers, 0 before upload
+
+  // Applied after upload (at once if already uploaded). Raising it maps the released data back from the mesh
+  // cache; false if that is impossible (no cache for this mesh).
+  bool setResidency(MeshResidency residency);
+  MeshResidency getResidency() const;
+
+  uint32_t getVAO() const;
   const std::vector<Submesh> &getSubmeshes() const;
+  const Vertex *getVertexData() const; // null once uploaded unless CpuAndGpu
+  size_t getVertexCount() const;
+  const uint32_t *getIndexData() const; // null once uploaded if GpuOnly
+  // Vertex positions, positionStride bytes apart; null once uploaded if GpuOnly
+  const glm::vec3 *getPositionData() const;
+  size_t getPositionStride() const;
+  size_t getIndexCount() const;
+  uint32_t getLodCount() const;
+  const MeshImportStats &getImportStats() const;
+
+  glm::vec3 getBoundsMin() const;
+  glm::vec3 getBoundsMax() const;
+
+  // Uniforms decoding the uploaded positions (identity unless vertices are packed)
+  glm::vec3 getPositionScale() const;
+  glm::vec3 getPositionOffset() const;
 
-  void setVerticesIndices(const std::vector<Vertex> &vertices, const std::vector<uint32_t> &indices,
-                          const std::vector<Submesh> &submeshes);
+  void setVerticesIndices(std::vector<Vertex> vertices, std::vector<uint32_t> indices, std::vector<Submesh> submeshes);
 };
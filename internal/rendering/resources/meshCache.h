@@ -0,0 +1,67 @@
+#pragma once
+#include "foundation/core/mappedFile.h"
+#include "rendering/resources/mesh.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Binary mesh cache: the imported (welded, optimized, LOD'd) mesh written once and mmap'ed on later runs.
+// Layout: header | submesh table | vertex blob | packed vertex blob | index blob, every section 16-byte aligned.
+// The packed vertices are the GPU layout (PackedVertex) and upload straight from the mapping; the full vertices
+// serve CPU residency.
+namespace MeshCache {
+
+// Bump when the file layout changes
+constexpr uint32_t FORMAT_VERSION = 3;
+// Bump when the import pipeline output changes (welding, cache optimization, LOD settings)
+constexpr uint32_t IMPORTER_VERSION = 2;
+
+struct Header {
+  char magic[4];
+  uint32_t formatVersion;
+  uint32_t importerVersion;
+  uint32_t vertexStride;
+  uint64_t sourcePathHash;
+  int64_t sourceModified; // source file write time (file clock ticks)
+  uint64_t sourceSize;
+  uint32_t submeshCount;
+  uint32_t vertexCount;
+  uint32_t indexCount;
+  uint32_t packedVertexStride;
+  uint32_t submeshStride; // sizeof(Submesh), which follows MESH_LOD_COUNT
+  uint32_t reserved;
+  float boundsMin[3];
+  float boundsMax[3];
+  uint64_t submeshOffset;
+  uint64_t vertexOffset;
+  uint64_t packedVertexOffset;
+  uint64_t indexOffset;
+};
+
+// Mapped cache file; pointers reference the mapping (or the asset pack) and live as long as the view
+struct View {
+  MappedFile file;
+  const Header *header = nullptr;
+  const Submesh *submeshes = nullptr;
+  const Vertex *vertices = nullptr;
+  const PackedVertex *packedVertices = nullptr;
+  const uint32_t *indices = nullptr;
+};
+
+// Cache file used for a source asset
+std::string getCachePath(const std::string &sourcePath);
+
+// Map the cache of sourcePath (from the asset pack if mounted and holding it);
+// false if missing or stale (source changed, other importer/format version)
+bool open(const std::string &sourcePath, View &view);
+
+// Write the imported mesh of sourcePath with its packed vertices (atomic: temp file + rename)
+bool write(const std::string &sourcePath, const Vertex *vertices, const PackedVertex *packedVertices,
+           size_t vertexCount, const uint32_t *indices, size_t indexCount, const std::vector<Submesh> &submeshes,
+           const glm::vec3 &boundsMin, const glm::vec3 &boundsMax);
+
+// Point an existing cache at the current source file stamp (the source was touched but its contents,
+// and so the cooked data, did not change)
+bool updateSourceStamp(const std::string &sourcePath);
+
+} // namespace MeshCache
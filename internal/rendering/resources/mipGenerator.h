@@ -0,0 +1,14 @@
+#pragma once
+#include "rendering/resources/material.h"
+
+// CPU mip chain generation, so streamed textures need no glGenerateMipmap on the render thread.
+namespace MipGenerator {
+
+// 2x2 box filter of one level into the next (floor(width/2) x floor(height/2), at least 1x1);
+// edge texels are clamped for odd or 1-wide sources
+void downsample(const unsigned char *source, int width, int height, int channels, unsigned char *destination);
+
+// Rebuild levels 1..log2(max(width, height)) of an uncompressed image from its level 0 (into levelData)
+void generateMips(TextureImage &image);
+
+} // namespace MipGenerator
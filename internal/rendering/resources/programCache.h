@@ -0,0 +1,42 @@
+#pragma once
+#include <cstdint>
+#include <string>
+
+// Program cache: linked program binaries saved on the first build and loaded on later runs instead of
+// compiling GLSL. Files are named by the hash of both sources and the driver string, so an edited shader
+// or a driver update simply misses; a binary the driver still rejects falls back to a source compile.
+namespace ProgramCache {
+
+// Bump when the file layout changes
+constexpr uint32_t FORMAT_VERSION = 1;
+
+struct Header {
+  char magic[4];
+  uint32_t formatVersion;
+  uint32_t binaryFormat; // driver-specific (glGetProgramBinary)
+  float compileMs;       // source build time the binary replaces, for the startup report
+  uint64_t sourceHash;
+  uint64_t driverHash;
+  uint64_t binarySize;
+};
+
+// Lookups of this run
+struct Stats {
+  uint32_t hits = 0;
+  uint32_t misses = 0;
+  uint32_t rejected = 0; // binaries found but refused by the driver (counted as misses too)
+  double loadMs = 0.0;
+  double compileMs = 0.0; // source builds after a miss
+  double savedMs = 0.0;   // recorded build time of the hits minus their load time
+};
+
+// Program built from the cached binary of these sources, 0 on a miss (or if binaries are unsupported)
+uint32_t load(const std::string &vertexSource, const std::string &fragmentSource);
+
+// Save the binary of a program just built from these sources in compileMs (atomic: temp file + rename)
+bool store(uint32_t program, const std::string &vertexSource, const std::string &fragmentSource,
+           double compileMs);
+
+const Stats &getStats();
+
+} // namespace ProgramCache
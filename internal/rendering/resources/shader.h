@@ -1,22 +1,57 @@
 #pragma once
-#include <glad/glad.h>
+#include "foundation/core/config.h"
+#include "rendering/backend/renderBackend.h"
+#include <chrono>
 #include <glm/glm.hpp>
 #include <string>
 
+// Feature bits of a shader variant, compiled in as #defines. A shader built without variant defines has every
+// feature behind runtime switches, so it can stand in for any variant while that one is being built.
+namespace ShaderFeatures {
+constexpr uint32_t Shadows = 1u << 0;   // SHADOWS: shadow map lookup
+constexpr uint32_t NormalMap = 1u << 1; // NORMAL_MAP: normal map lookup
+// Bits 2-3: light count tier, index into EngineConfig::SHADER_LIGHT_TIERS (MAX_LIGHTS)
+constexpr uint32_t LightTierShift = 2;
+constexpr uint32_t LightTierMask = 3u << LightTierShift;
+constexpr uint32_t All = Shadows | NormalMap | ((EngineConfig::SHADER_LIGHT_TIER_COUNT - 1) << LightTierShift);
+
+// Light tier bits of the smallest tier holding lightCount lights
+uint32_t getLightTier(size_t lightCount);
+int getMaxLights(uint32_t features);
+
+// Lines inserted after #version to build the variant
+std::string getDefines(uint32_t features);
+} // namespace ShaderFeatures
+
 class Shader {
 private:
-  GLuint m_shaderID = 0;
+  uint32_t m_shaderID = 0;
+  std::string m_vertexFile;
+  std::string m_fragmentFile;
+  uint32_t m_features = ShaderFeatures::All;
+  std::string m_defines; // empty for the full shader
+
+  // Background build in flight (the sources are kept for the program cache)
+  uint32_t m_pendingID = 0;
+  std::string m_pendingVertexSource;
+  std::string m_pendingFragmentSource;
+  std::chrono::steady_clock::time_point m_pendingStart;
 
   std::string readShaderFile(const char *filename) const;
-  GLuint compileShader(GLenum type, const char *filename);
-  GLuint createShaderProgram(const char *vertexFile, const char *fragmentFile);
+  bool readSources(std::string &vertexSource, std::string &fragmentSource) const;
+  uint32_t createShaderProgram();
+  void cancelBuild();
 
 public:
   Shader() = default;
   Shader(const char *vertexFile, const char *fragmentFile);
+  // Variant with only the given features; with async the build is started and finished by update(), the
+  // program stays 0 until then
+  Shader(const char *vertexFile, const char *fragmentFile, uint32_t features, bool async = false);
   ~Shader() {
+    cancelBuild();
     if (m_shaderID)
-      glDeleteProgram(m_shaderID);
+      RenderBackend::get().deleteProgram(m_shaderID);
   }
 
   // Prevent copy, allow move
@@ -26,15 +61,26 @@ public:
   Shader &operator=(Shader &&) = default;
 
   bool load(const char *vertexFile, const char *fragmentFile);
+  // Rebuild from the same files; the current program is kept if the new one fails to compile or link
+  bool reload();
+
+  // Finish a background build once the driver is done with it (never blocks on drivers with parallel compile).
+  // Returns false while still compiling; a failed build leaves the shader without a program.
+  bool update();
+  bool isPending() const;
   void use() const;
 
   // Uniforms
-  void setTex(const char *name, GLuint textureID, int textureUnit) const;
+  void setTex(const char *name, uint32_t textureID, int textureUnit) const;
   void setInt(const char *name, int value) const;
   void setFloat(const char *name, float value) const;
   void setVec3(const char *name, glm::vec3 value) const;
   void setMat3(const char *name, glm::mat3 value) const;
   void setMat4(const char *name, glm::mat4 value) const;
 
-  GLuint getShaderID() const;
+  uint32_t getShaderID() const;
+  uint32_t getFeatures() const;
+  int getMaxLights() const;
+  const std::string &getVertexFile() const;
+  const std::string &getFragmentFile() const;
 };
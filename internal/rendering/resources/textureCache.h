@@ -0,0 +1,49 @@
+#pragma once
+#include "rendering/resources/material.h"
+#include <cstdint>
+#include <string>
+
+// Texture cache: the imported (mip-mapped, block-compressed) texture written once and mmap'ed on later runs.
+// Layout: header | level table | level blobs, every level 16-byte aligned (a small DDS/KTX2-like container).
+namespace TextureCache {
+
+// Bump when the file layout changes
+constexpr uint32_t FORMAT_VERSION = 1;
+// Bump when the import pipeline output changes (mip filter, block encoders)
+constexpr uint32_t ENCODER_VERSION = 1;
+
+struct Header {
+  char magic[4];
+  uint32_t formatVersion;
+  uint32_t encoderVersion;
+  uint32_t format; // TextureFormat
+  uint32_t usage;  // TextureUsage
+  uint32_t width;
+  uint32_t height;
+  uint32_t levelCount;
+  uint64_t sourcePathHash;
+  int64_t sourceModified; // source file write time (file clock ticks)
+  uint64_t sourceSize;
+  uint64_t sourceBytes; // uncompressed size of the mip chain, for import statistics
+};
+
+struct Level {
+  uint64_t offset;
+  uint64_t size;
+};
+
+// Cache file used for a source image and usage
+std::string getCachePath(const std::string &sourcePath, TextureUsage usage);
+
+// Map the cache of sourcePath into image (levels point into the mapping, or into the asset pack if mounted
+// and holding it); false if missing or stale
+bool open(const std::string &sourcePath, TextureUsage usage, TextureImage &image, uint64_t *sourceBytes = nullptr);
+
+// Write the imported texture of sourcePath (atomic: temp file + rename)
+bool write(const std::string &sourcePath, TextureUsage usage, const TextureImage &image, uint64_t sourceBytes);
+
+// Point an existing cache at the current source file stamp (the source was touched but its contents,
+// and so the cooked data, did not change)
+bool updateSourceStamp(const std::string &sourcePath, TextureUsage usage);
+
+} // namespace TextureCache
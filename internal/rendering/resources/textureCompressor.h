@@ -0,0 +1,20 @@
+#pragma once
+#include "rendering/resources/material.h"
+
+// CPU block compression of textures and their mip chains:
+// BC1 (opaque color), BC3 (color + alpha), BC5 (normal map XY), BC7 mode 6 (color, higher quality).
+namespace TextureCompressor {
+
+// BC5 for normal maps; BC7 (TEXTURE_COMPRESSION_USE_BC7) or BC1/BC3 by alpha coverage for color
+TextureFormat chooseFormat(const TextureImage &image, TextureUsage usage);
+
+// Encode one level of 8-bit texels (3 or 4 channels) into 4x4 blocks written to output.
+// Block rows are spread over the job system when one is given.
+void encodeLevel(const unsigned char *pixels, int width, int height, int channels, TextureFormat format,
+                 unsigned char *output, JobSystem *jobSystem = nullptr);
+
+// Encode every level of an uncompressed image into compressed (levels packed in its levelData)
+void compress(const TextureImage &source, TextureFormat format, TextureImage &compressed,
+              JobSystem *jobSystem = nullptr);
+
+} // namespace TextureCompressor
@@ -0,0 +1,31 @@
+#pragma once
+#include "rendering/resources/material.h"
+#include <filesystem>
+#include <string>
+
+// Import statistics of one texture (source is the uncompressed mip chain)
+struct TextureImportStats {
+  bool cached = false;
+  size_t sourceBytes = 0;
+  size_t bytes = 0;
+  double encodeMs = 0.0;
+};
+
+// Image file to upload-ready texture: decode, CPU mips, block compression, texture cache.
+namespace TextureImporter {
+
+// First existing file for a path without extension, packed or loose ("" if none)
+std::string findFile(const std::filesystem::path &path, TextureUsage usage = TextureUsage::Color);
+
+// Whether an image file has a supported extension
+bool isSupportedFile(const std::filesystem::path &file);
+
+// Usage of a standalone image file by naming convention ("*normal*" files are normal maps)
+TextureUsage guessUsage(const std::filesystem::path &file);
+
+// Import an image file: the mapped texture cache if it is current, otherwise decode, build the mip chain and,
+// if enabled and supported by the backend, compress and write the cache. Safe to call from worker threads.
+bool import(const std::string &file, TextureUsage usage, TextureImage &image, JobSystem *jobSystem = nullptr,
+            TextureImportStats *stats = nullptr);
+
+} // namespace TextureImporter
@@ -0,0 +1,62 @@
+#pragma once
+
+#include "foundation/ecs/systemManager.h"
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Fixed worker pool shared by all CPU-heavy systems.
+// Threads that wait on a job group help executing that group's queued jobs instead of blocking.
+// Long-running loads go to a background queue that only workers take, after every queued frame job, so a
+// thread waiting on frame work never picks up an import or a texture encode.
+class JobSystem : public BaseSystem {
+public:
+  // Completion counter for a set of submitted jobs
+  struct Group {
+    std::atomic<uint32_t> pending{0};
+  };
+
+private:
+  struct Job {
+    std::function<void()> run;
+    Group *group = nullptr;
+  };
+
+  std::vector<std::thread> m_workers;
+  std::deque<Job> m_queue;
+  std::deque<std::function<void()>> m_backgroundQueue;
+  std::mutex m_mutex;
+  std::condition_variable m_condition;
+  bool m_stopping = false;
+
+  void workerLoop(unsigned int index);
+  bool runOne(Group &group);
+
+public:
+  // threadCount = 0 uses hardware concurrency - 1 (the caller thread also works)
+  explicit JobSystem(unsigned int threadCount = 0);
+  ~JobSystem();
+
+  JobSystem(const JobSystem &) = delete;
+  JobSystem &operator=(const JobSystem &) = delete;
+
+  // queue a job; if group is given it is counted until the job finishes
+  void submit(std::function<void()> job, Group *group = nullptr);
+
+  // queue a long-running job (file IO, import, encode) behind all frame jobs; never run by a waiting thread
+  void submitBackground(std::function<void()> job);
+
+  // block until every job of the group finished (helping with the group's jobs meanwhile)
+  void wait(Group &group);
+
+  // run fn(begin, end) over [0, count) in chunks of at most grain items and wait
+  void parallelFor(uint32_t count, uint32_t grain, const std::function<void(uint32_t, uint32_t)> &fn);
+
+  // number of threads that can execute jobs (workers + caller)
+  unsigned int getThreadCount() const;
+};
@@ -15,9 +15,10 @@ private:
 public:
   void createLight(Entity entity);
   void destroyLight(Entity entity);
+  void clearLights();
 
   const std::vector<Entity> &getLights() const;
 
-  // Upload all lights to shader uniform array
+  // Upload the lights to the shader uniform array (as many as the shader variant holds)
   void uploadLightsToShader(Shader &shader, ComponentManager &componentManager);
 };
@@ -3,12 +3,38 @@
 #include "foundation/ecs/componentManager.h"
 #include "foundation/ecs/entityManager.h"
 #include "foundation/ecs/systemManager.h"
+#include "foundation/core/config.h"
+#include "rendering/culling/occlusionCuller.h"
+#include "rendering/renderCommands.h"
 #include "rendering/renderer.h"
 
+#include <array>
+#include <unordered_set>
 #include <vector>
 
+// Forward declarations
+class JobSystem;
+class LightSystem;
+class ResourceSystem;
+class Shader;
+class TransformSystem;
+struct CameraComponent;
+struct TransformComponent;
+
+// Per-frame render statistics (reset at the start of every renderCall)
+struct RenderStats {
+  uint32_t drawCalls = 0;
+  uint32_t triangles = 0;       // main pass
+  uint32_t shadowTriangles = 0; // shadow pass
+  uint32_t culledEntities = 0;  // occluded or outside the view
+  uint32_t occluderTriangles = 0;
+  uint32_t meshBatches = 0; // runs of main pass draws sharing a mesh range (instancing candidates)
+  std::array<uint32_t, EngineConfig::MESH_LOD_COUNT> entitiesPerLod{};
+};
+
 // Handles the rendering process.
-// Stores renderable entities and performs shadow pass + main pass.
+// Stores renderable entities; scene processing records command lists on the job system,
+// then the GL thread submits the shadow pass + main pass.
 class RenderSystem : public BaseSystem {
 public:
   // add entity to render list
@@ -16,6 +42,8 @@ public:
 
   // remove entity from render list
   void removeRenderable(Entity entity);
+  void removeRenderables(const std::unordered_set<Entity> &entities); // one pass for many entities
+  void clearRenderables();
 
   // main render call
   void renderCall(SystemManager &systemManager, EntityManager &entityManager, ComponentManager &componentManager);
@@ -26,9 +54,56 @@ public:
   // return render queue list
   const std::vector<Entity> &getRenderQueue() const;
 
+  // statistics of the last rendered frame
+  const RenderStats &getStats() const;
+
+  // toggle CPU occlusion culling of the main pass
+  void setOcclusionCulling(bool enabled);
+  bool isOcclusionCullingEnabled() const;
+
+  // pick a detail level from projected screen size, with hysteresis around the thresholds
+  static uint32_t selectLod(float screenSize, uint32_t currentLod, uint32_t lodCount);
+
 private:
   std::vector<Entity> m_entries;
   Renderer m_renderer;
+  RenderStats m_stats;
+
+  OcclusionCuller m_occlusionCuller;
+  bool m_occlusionCulling = true;
+  std::vector<uint8_t> m_visible; // per m_entries slot, filled by cullOccluded
+
+  // Per m_entries slot, filled by extract
+  std::vector<glm::mat4> m_modelMatrices;
+
+  // Recorded frame: per-chunk lists (reused across frames) and merged per-pass lists
+  std::vector<RenderCommandList> m_shadowChunks;
+  std::vector<RenderCommandList> m_mainChunks;
+  RenderCommandList m_shadowCommands;
+  RenderCommandList m_mainCommands;
+
+  glm::mat4 computeLightSpaceMatrix(const glm::vec3 &direction) const;
+
+  static float projectedSize(const Mesh &mesh, const TransformComponent &transform, const glm::mat4 &modelMatrix,
+                             const glm::vec3 &viewPos, float tanHalfFov);
+
+  static void setPositionDecode(const Shader &shader, const Mesh &mesh);
+
+  // Extraction stage: model matrices + ModelComponent::lod for every renderable
+  void extract(ComponentManager &componentManager, ResourceSystem &resourceSystem, TransformSystem &transformSystem,
+               JobSystem &jobSystem, const CameraComponent &camera);
+
+  // Occlusion stage: rasterize occluders and test every renderable's bounds
+  void cullOccluded(ComponentManager &componentManager, ResourceSystem &resourceSystem, JobSystem &jobSystem,
+                    const glm::mat4 &viewProjection);
+
+  // Record stage: fill shadow/main command lists in parallel (no GL calls)
+  void recordCommands(ComponentManager &componentManager, ResourceSystem &resourceSystem, JobSystem &jobSystem,
+                      const FrameConstants &frame);
+
+  // Submit stage: replay command lists into GL on the context thread
+  void submitCommands(ResourceSystem &resourceSystem, LightSystem &lightSystem, ComponentManager &componentManager,
+                      const FrameConstants &frame);
 
   // prepare shader light uniforms
   void setupLights();
@@ -1,46 +1,185 @@
 #pragma once
 #include "foundation/ecs/systemManager.h"
+#include "rendering/resources/material.h"
 #include <cstdint>
+#include <deque>
+#include <glm/glm.hpp>
 #include <memory>
 #include <string>
 #include <unordered_map>
+#include <vector>
 
 // Forward declarations
-class Material;
+class FileWatcher;
+class JobSystem;
 class Mesh;
 class Shader;
 using GLuint = unsigned int;
 
+// Memory held per resource type (GPU bytes are estimated from formats and sizes)
+struct ResourceMemoryStats {
+  size_t meshCpuBytes = 0;
+  size_t meshGpuBytes = 0;
+  size_t textureCpuBytes = 0; // decoded images still streaming to the GPU
+  size_t textureGpuBytes = 0;
+  uint32_t cachedMeshes = 0;    // unreferenced, kept until evicted
+  uint32_t evictedTextures = 0; // placeholders until used again
+  uint32_t meshEvictions = 0;   // since startup
+  uint32_t textureEvictions = 0;
+};
+
+// Mesh node of a glTF scene, with its hierarchy flattened into a world transform
+struct GltfInstance {
+  std::string name;
+  uint32_t meshHandle = 0; // one reference per instance
+  glm::mat4 transform{1.0f};
+};
+
 class ResourceSystem : public BaseSystem {
 private:
-  std::unordered_map<uint32_t, std::unique_ptr<Mesh>> m_meshes;
-  std::unordered_map<uint32_t, std::unique_ptr<Material>> m_materials;
+  // Meshes are shared by canonical path. A mesh whose last reference is released stays cached (a later
+  // loadMesh of the path is free) until the mesh budget evicts it with its GPU buffers.
+  // mesh is null while a background load is in flight (getMesh returns the placeholder).
+  struct MeshEntry {
+    std::unique_ptr<Mesh> mesh;
+    std::string path;
+    uint32_t refCount = 0;
+    uint64_t releasedFrame = 0; // frame the last reference was released (LRU order of cached meshes)
+  };
+
+  // Materials are immutable parameter blocks shared by every user with equal parameters, reference counted.
+  // The default material (handle 0) is never released.
+  struct MaterialEntry {
+    std::unique_ptr<Material> material;
+    uint64_t hash = 0;
+    uint32_t refCount = 0;
+  };
+
+  // Cached texture, by texture name. An evicted texture is a 1x1 placeholder under the same name until
+  // markMaterialUsed sees it again and streams it back in.
+  struct TextureEntry {
+    std::string path;
+    TextureUsage usage = TextureUsage::Color;
+    size_t gpuBytes = 0;
+    uint64_t lastUsedFrame = 0;
+    bool evicted = false;
+  };
+
+  // Background loads decoded on the job system, waiting for their GPU upload.
+  // Shared with the load jobs so a job finishing after shutdown has somewhere to go.
+  struct UploadQueue;
+
+  // Decoded texture whose mip levels go to the GPU coarsest first, in row bands across frames
+  struct TextureStream;
+
+  // Shader or texture rebuilt in place when one of its files changes on disk
+  struct WatchedResource {
+    uint32_t shader = 0; // shader handle, if texture is 0
+    GLuint texture = 0;
+    std::string path;
+    TextureUsage usage = TextureUsage::Color;
+  };
+
+  JobSystem &m_jobSystem;
+  std::shared_ptr<UploadQueue> m_uploads;
+  std::deque<std::unique_ptr<TextureStream>> m_textureStreams;
+  std::unique_ptr<Mesh> m_placeholderMesh;
+  uint32_t m_pendingLoads = 0;
+
+  std::unique_ptr<FileWatcher> m_fileWatcher;
+  std::unordered_multimap<std::string, WatchedResource> m_watchedFiles; // normalized file -> resources
+
+  std::unordered_map<uint32_t, MeshEntry> m_meshes;
+  std::unordered_map<std::string, uint32_t> m_meshPaths;
+  std::unordered_map<uint32_t, MaterialEntry> m_materials;
+  std::unordered_multimap<uint64_t, uint32_t> m_materialHashes; // parameter hash -> material handles
   std::unordered_map<uint32_t, std::unique_ptr<Shader>> m_shaders;
+  // (base shader << 32 | features) -> variant shader handle; variants are regular shaders in m_shaders
+  std::unordered_map<uint64_t, uint32_t> m_shaderVariants;
+  std::vector<uint32_t> m_pendingShaders; // variants still building in the background
   std::unordered_map<std::string, GLuint> m_textures;
+  std::unordered_map<GLuint, TextureEntry> m_textureEntries;
+
+  uint64_t m_frame = 0;
+  uint32_t m_meshEvictions = 0;
+  uint32_t m_textureEvictions = 0;
 
   uint32_t m_nextMesh = 0;
   uint32_t m_nextMaterial = 0;
   uint32_t m_nextShader = 0;
 
+  std::string meshKey(const std::string &path) const;
+  void streamTextures(uint64_t start, size_t &bytes);
+  void submitTextureDecode(GLuint texture, const std::string &path, TextureUsage usage);
+  void watchFile(const std::string &file, const WatchedResource &resource);
+  void finishShaderBuilds();
+  GLuint addTexture(const std::string &key, GLuint texture, const std::string &path, TextureUsage usage,
+                    size_t gpuBytes);
+  void touchTexture(GLuint texture);
+  void evictMeshes(size_t bytes, size_t budget);
+  void evictTextures(size_t bytes, size_t budget);
+
 public:
-  ResourceSystem();
+  explicit ResourceSystem(JobSystem &jobSystem);
   ~ResourceSystem(); // Explicit destructor needed for unique_ptr with forward declarations
 
-  // Mesh management
+  // Mesh management (cached by canonical path, reference counted; unreferenced meshes stay cached until evicted)
   uint32_t loadMesh(const std::string &path);
   Mesh &getMesh(uint32_t handle);
   void unloadMesh(uint32_t handle);
+  uint32_t getMeshRefCount(uint32_t handle) const;
+  size_t getMeshCount() const;
+  void retainMesh(uint32_t handle, uint32_t count = 1); // add references (bulk instancing)
+  const std::string &getMeshPath(uint32_t handle) const; // canonical path the mesh is cached under
+
+  // Binary glTF (.glb): uploads each mesh of the file (straight from the mapped file when its layout allows),
+  // cached as "<path>#<mesh index>", and lists the mesh nodes of the default scene. Synchronous.
+  // loadMesh and loadMeshAsync accept these "<path>#<mesh index>" paths too.
+  bool loadGltf(const std::string &path, std::vector<GltfInstance> &instances);
+
+  // Returns at once; the handle shows a placeholder cube until the mesh is loaded on a worker and uploaded
+  uint32_t loadMeshAsync(const std::string &path);
+  bool isMeshReady(uint32_t handle) const;
 
   // Texture management (cached by path)
-  GLuint loadTexture(const std::string &path);
+  std::string getTexturePath(GLuint texture) const; // path a texture was loaded from, empty if none
+  GLuint loadTexture(const std::string &path, TextureUsage usage = TextureUsage::Color);
 
-  // Material management
-  uint32_t createMaterial();
-  Material &getMaterial(uint32_t handle);
-  void unloadMaterial(uint32_t handle);
+  // Returns a 1x1 placeholder texture at once (gray, or flat for normal maps); a worker imports the image
+  // (mip chain, block compression or the texture cache), then the same texture name is streamed in level
+  // by level (coarsest first) within the upload budget
+  GLuint loadTextureAsync(const std::string &path, TextureUsage usage = TextureUsage::Color);
+
+  // Upload finished background loads within the per-frame budget (render thread, once per frame)
+  void processUploads();
+  uint32_t getPendingLoadCount() const;
+
+  // Memory budgets (render thread, once per frame after processUploads): evict least recently used
+  // unreferenced meshes and idle textures while their type is over budget
+  void enforceBudgets();
+  ResourceMemoryStats getMemoryStats() const;
+  // Record that a material is drawn this frame; evicted textures of it are streamed back in
+  void markMaterialUsed(const Material &material);
+
+  // Hot reload (render thread, once per frame): recompile changed shaders behind their handles (keeping the
+  // old program on errors) and re-import changed textures into their existing names through the upload queue
+  void processFileChanges();
+
+  // Material management. To change a material, copy it, edit the copy, create a material from it and release
+  // the old handle: handles are shared, so a material never changes behind one.
+  // Returns the existing material with these parameters (one more reference) or a new one.
+  uint32_t createMaterial(const Material &material = Material());
+  const Material &getMaterial(uint32_t handle) const;
+  void unloadMaterial(uint32_t handle); // release one reference
+  void retainMaterial(uint32_t handle, uint32_t count = 1);
+  size_t getMaterialCount() const;
 
   // Shader management
   uint32_t loadShader(const std::string &vertexPath, const std::string &fragmentPath);
   Shader &getShader(uint32_t handle);
   void unloadShader(uint32_t handle);
+
+  // Variant of a shader built with only the given ShaderFeatures (render thread). The first request starts a
+  // background build; until it is done (or if it fails) the full shader is returned in its place.
+  uint32_t getShaderVariant(uint32_t shader, uint32_t features);
 };
@@ -1,11 +1,25 @@
 #pragma once
 
 #include "components/lightComponent.h"
+#include "foundation/core/sceneFile.h"
 #include "foundation/ecs/componentManager.h"
 #include "foundation/ecs/entityManager.h"
 #include "foundation/ecs/systemManager.h"
 #include "glm/ext/vector_float3.hpp"
 #include <string>
+#include <vector>
+
+// Saved scene being instantiated a batch of components at a time. Holds one reference to each of its assets
+// from beginSceneLoad to endSceneLoad.
+struct SceneLoad {
+  SceneFile::Data data;
+  std::vector<Entity> entities; // created so far, by file entity number
+  std::vector<uint32_t> meshHandles;     // per mesh table entry (used entries only)
+  std::vector<uint32_t> materialHandles; // per material table entry (used entries only)
+  std::vector<uint32_t> heldMeshes;      // references owned by the load
+  std::vector<uint32_t> heldMaterials;
+  size_t cursor = 0; // components instantiated, over all pools in order
+};
 
 class SceneSystem : public BaseSystem {
 private:
@@ -13,14 +27,39 @@ private:
   ComponentManager &componentManager;
   SystemManager &systemManager;
 
+  void captureScene(SceneFile::Data &data, const std::vector<Entity> &entities, const std::string &directory);
+
 public:
   SceneSystem(EntityManager &em, ComponentManager &cm, SystemManager &sm)
       : entityManager(em), componentManager(cm), systemManager(sm) {}
 
   void destroyEntity(Entity entity);
+  void destroyEntities(const std::vector<Entity> &entities); // bulk destroyEntity
+  void clearScene();                                         // destroy every entity
+
+  // Scene files (SceneFile): save every entity with its name, transform, model, light and camera, or replace
+  // the scene with a saved one of either format. Meshes and textures are referenced by path and requested once
+  // per distinct path, in the background. Materials keep their textures and shininess, not their shader.
+  bool saveScene(const std::string &path, SceneFile::Format format = SceneFile::Format::Json);
+  bool loadScene(const std::string &path);
+
+  // loadScene in steps, without clearing the scene (world streaming): beginSceneLoad requests the assets, each
+  // continueSceneLoad instantiates up to budget more components (true once complete), endSceneLoad drops the
+  // load's asset references, after completion or to abandon it (entities created so far stay)
+  void beginSceneLoad(SceneLoad &load, SceneFile::Data data, const std::string &directory);
+  bool continueSceneLoad(SceneLoad &load, size_t budget);
+  void endSceneLoad(SceneLoad &load);
+
+  // World: every entity with a transform saved into the snapshot of its cellSize x cellSize cell of the XZ grid,
+  // plus the world index (StreamingSystem streams it back). Entities without a transform are not saved.
+  bool saveWorld(const std::string &directory, float cellSize);
+
   void createCameraEntity(glm::vec3 position, float yaw, float pitch, float fov);
+  // async: the mesh loads in the background, the entity shows a placeholder until it is uploaded
   void createModelEntity(const std::string name, const std::string &modelPath, glm::vec3 position, glm::vec3 rotation,
-                         glm::vec3 scale);
+                         glm::vec3 scale, bool async = false);
+  // One entity per mesh node of a binary glTF scene, placed by the root transform; false if the file fails
+  bool createGltfEntities(const std::string &path, glm::vec3 position, glm::vec3 rotation, glm::vec3 scale);
   void createLightEntity(const std::string &name, glm::vec3 position, glm::vec3 direction, glm::vec3 color,
                          LightType type, float intensity, float cutOff, float outerCutOff);
 };
\ No newline at end of file
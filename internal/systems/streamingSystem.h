@@ -0,0 +1,73 @@
+#pragma once
+
+#include "foundation/core/sceneFile.h"
+#include "foundation/ecs/componentManager.h"
+#include "foundation/ecs/systemManager.h"
+#include "systems/sceneSystem.h"
+#include <glm/glm.hpp>
+#include <memory>
+#include <string>
+#include <vector>
+
+class JobSystem;
+
+// World streaming statistics (counts since the world was opened)
+struct StreamingStats {
+  uint32_t cells = 0;
+  uint32_t residentCells = 0; // fully instantiated
+  uint32_t loadingCells = 0;  // reading or instantiating
+  uint32_t residentEntities = 0;
+  uint32_t cellLoads = 0;
+  uint32_t cellUnloads = 0;
+};
+
+// Streams a world (SceneFile::World) around the active camera. Cells near the camera, or near where its
+// velocity is taking it, are read on the job system nearest first, then instantiated through SceneSystem a
+// bounded number of components per frame; cells out of range are destroyed. Entities that are not part of a
+// cell (the resident scene: camera, global lights, ...) are left alone.
+class StreamingSystem : public BaseSystem {
+private:
+  enum class CellState { Unloaded, Reading, Instantiating, Resident, Failed };
+
+  // Snapshot read on a worker; shared with the job so an abandoned read has somewhere to finish
+  struct CellRead;
+
+  struct Cell {
+    SceneFile::WorldCell info;
+    glm::vec2 min{0.0f}; // XZ square
+    glm::vec2 max{0.0f};
+    CellState state = CellState::Unloaded;
+    std::shared_ptr<CellRead> read;
+    SceneLoad load; // entities of the cell while instantiating or resident
+    float priority = 0.0f; // distance to the predicted camera position, this frame
+  };
+
+  ComponentManager &m_componentManager;
+  JobSystem &m_jobSystem;
+  SceneSystem &m_sceneSystem;
+
+  std::string m_directory;
+  std::vector<Cell> m_cells;
+  StreamingStats m_stats;
+
+  glm::vec3 m_lastCameraPosition{0.0f};
+  glm::vec3 m_velocity{0.0f};
+  bool m_hasCameraPosition = false;
+
+  void unloadCell(Cell &cell);
+
+public:
+  StreamingSystem(ComponentManager &cm, JobSystem &jobSystem, SceneSystem &sceneSystem)
+      : m_componentManager(cm), m_jobSystem(jobSystem), m_sceneSystem(sceneSystem) {}
+
+  // Start streaming the world saved in directory (SceneSystem::saveWorld); closes any open world
+  bool openWorld(const std::string &directory);
+  // Destroy every streamed entity
+  void closeWorld();
+  bool isWorldOpen() const;
+
+  // Once per frame, after the camera moved
+  void update(float deltaTime, SystemManager &systemManager);
+
+  StreamingStats getStats() const;
+};
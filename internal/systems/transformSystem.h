@@ -11,4 +11,7 @@ public:
 
   // compute model matrix for a transform component
   glm::mat4 calculateModelMatrix(const TransformComponent &transform);
+
+  // inverse of calculateModelMatrix for matrices without shear (imported node transforms)
+  TransformComponent decomposeModelMatrix(const glm::mat4 &modelMatrix);
 };
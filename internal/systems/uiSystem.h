@@ -1,6 +1,7 @@
 #pragma once
 #include "foundation/ecs/systemManager.h"
 #include <SDL3/SDL_video.h>
+#include <string>
 
 // Forward declarations
 class EntityManager;
@@ -17,4 +18,13 @@ public:
   void beginFrame();
   void render(EntityManager &entityManager, SystemManager &systemManager, ComponentManager &componentManager);
   void endFrame();
+
+private:
+  std::string m_traceStatus;
+
+  // frame statistics overlay (top-right corner)
+  void renderStats(SystemManager &systemManager);
+
+  // GPU pass timings, CPU zone timings and flame graph of the last frame
+  void renderProfiler(SystemManager &systemManager);
 };
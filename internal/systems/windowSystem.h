@@ -8,14 +8,16 @@
 
 // Manages the main window and OpenGL context.
 // Handles initialization, resize events, and cursor settings.
+// In headless mode no window or context is created.
 class WindowSystem : public BaseSystem {
 private:
   SDL_Window *m_window;
   SDL_GLContext m_glContext;
+  bool m_headless;
 
 public:
   // create window system with target screen size
-  WindowSystem(float screenWidth, float screenHeight);
+  WindowSystem(float screenWidth, float screenHeight, bool headless = false);
 
   // initialize window and GL context
   bool initialize(float screenWidth, float screenHeight);
@@ -26,6 +28,7 @@ public:
   // getters
   SDL_Window *getWindow() const;
   SDL_GLContext getContext() const;
+  bool isHeadless() const;
 
   // enable/disable mouse cursor visibility
   void setCursor(bool boolean);
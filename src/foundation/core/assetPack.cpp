@@ -0,0 +1,153 @@
+#include "foundation/core/assetPack.h"
+#include "foundation/core/config.h"
+#include "foundation/core/fileUtils.h"
+#include <cstring>
+#include <filesystem>
+#include <iostream>
+
+namespace fs = std::filesystem;
+
+namespace {
+constexpr char MAGIC[4] = {'A', 'P', 'A', 'K'};
+constexpr uint64_t ALIGNMENT = 16;
+
+uint64_t alignUp(uint64_t offset) { return (offset + ALIGNMENT - 1) & ~(ALIGNMENT - 1); }
+} // namespace
+
+AssetPack &AssetPack::get() {
+  static AssetPack pack;
+  return pack;
+}
+
+bool AssetPack::open(const std::string &path) {
+  close();
+  MappedFile file;
+  if (!file.open(path) || file.getSize() < sizeof(Header))
+    return false;
+
+  const Header *header = reinterpret_cast<const Header *>(file.getData());
+  uint32_t slotCount = header->slotCount;
+  if (std::memcmp(header->magic, MAGIC, sizeof(MAGIC)) != 0 || header->formatVersion != FORMAT_VERSION ||
+      slotCount == 0 || (slotCount & (slotCount - 1)) != 0 ||
+      header->directoryOffset + uint64_t(slotCount) * sizeof(Entry) > file.getSize()) {
+    std::cerr << "[AssetPack] Invalid pack: " << path << std::endl;
+    return false;
+  }
+
+  m_slots = reinterpret_cast<const Entry *>(file.getData() + header->directoryOffset);
+  m_slotMask = slotCount - 1;
+  m_entryCount = header->entryCount;
+  m_file = std::move(file);
+  return true;
+}
+
+void AssetPack::close() {
+  m_file.close();
+  m_slots = nullptr;
+  m_slotMask = 0;
+  m_entryCount = 0;
+}
+
+bool AssetPack::isOpen() const { return m_file.isOpen(); }
+
+uint32_t AssetPack::getEntryCount() const { return m_entryCount; }
+
+bool AssetPack::find(const std::string &path, AssetType type, AssetBlob &blob) const {
+  if (!m_slots)
+    return false;
+
+  // Linear probing; the table is at most half full so probe runs stay short, and a corrupt table with no empty
+  // slot stops after visiting every slot once
+  std::string key = getKey(path);
+  uint64_t hash = hashKey(key, type);
+  uint32_t slot = static_cast<uint32_t>(hash) & m_slotMask;
+  for (uint32_t probe = 0; probe <= m_slotMask; ++probe, slot = (slot + 1) & m_slotMask) {
+    const Entry &entry = m_slots[slot];
+    if (entry.hash == 0)
+      return false;
+    if (entry.hash != hash || entry.type != static_cast<uint32_t>(type) || entry.keySize != key.size() ||
+        entry.keyOffset + entry.keySize > m_file.getSize() ||
+        std::memcmp(m_file.getData() + entry.keyOffset, key.data(), key.size()) != 0)
+      continue;
+
+    if (entry.compression != static_cast<uint32_t>(Compression::None) || entry.offset + entry.size > m_file.getSize())
+      return false;
+    blob.data = m_file.getData() + entry.offset;
+    blob.size = entry.size;
+    return true;
+  }
+  return false;
+}
+
+std::string AssetPack::getKey(const std::string &path) {
+  fs::path normalized = fs::path(path).lexically_normal();
+  fs::path relative = normalized.lexically_relative(fs::path(EngineConfig::ASSET_BASE_PATH).lexically_normal());
+  if (relative.empty() || *relative.begin() == "..")
+    return normalized.generic_string();
+  return relative.generic_string();
+}
+
+uint64_t AssetPack::hashKey(const std::string &key, AssetType type) {
+  uint64_t hash = 1469598103934665603ull;
+  for (unsigned char c : key)
+    hash = (hash ^ c) * 1099511628211ull;
+  hash = (hash ^ static_cast<uint32_t>(type)) * 1099511628211ull;
+  return hash != 0 ? hash : 1;
+}
+
+void AssetPackWriter::add(const std::string &path, AssetType type, const void *data, size_t size) {
+  std::string key = AssetPack::getKey(path);
+  const uint8_t *bytes = static_cast<const uint8_t *>(data);
+  auto [it, inserted] =
+      m_indices.try_emplace(std::to_string(static_cast<uint32_t>(type)) + ":" + key, m_assets.size());
+  if (!inserted) {
+    m_assets[it->second].data.assign(bytes, bytes + size);
+    return;
+  }
+  uint64_t hash = AssetPack::hashKey(key, type);
+  m_assets.push_back({std::move(key), hash, type, std::vector<uint8_t>(bytes, bytes + size)});
+}
+
+size_t AssetPackWriter::getAssetCount() const { return m_assets.size(); }
+
+bool AssetPackWriter::write(const std::string &outputPath) const {
+  uint32_t slotCount = 16;
+  while (slotCount < m_assets.size() * 2)
+    slotCount *= 2;
+
+  AssetPack::Header header{};
+  std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+  header.formatVersion = AssetPack::FORMAT_VERSION;
+  header.entryCount = static_cast<uint32_t>(m_assets.size());
+  header.slotCount = slotCount;
+  header.directoryOffset = alignUp(sizeof(AssetPack::Header));
+
+  // Keys are packed right after the directory, blobs after the keys
+  std::vector<AssetPack::Entry> slots(slotCount);
+  std::vector<uint64_t> keyOffsets, offsets;
+  uint64_t offset = header.directoryOffset + slotCount * sizeof(AssetPack::Entry);
+  for (const auto &asset : m_assets) {
+    keyOffsets.push_back(offset);
+    offset += asset.key.size();
+  }
+  offset = alignUp(offset);
+  for (size_t i = 0; i < m_assets.size(); ++i) {
+    const Pending &asset = m_assets[i];
+    uint32_t slot = static_cast<uint32_t>(asset.hash) & (slotCount - 1);
+    while (slots[slot].hash != 0)
+      slot = (slot + 1) & (slotCount - 1);
+    slots[slot] = {asset.hash, offset, asset.data.size(), keyOffsets[i], static_cast<uint32_t>(asset.key.size()),
+                   static_cast<uint32_t>(asset.type), static_cast<uint32_t>(AssetPack::Compression::None), 0};
+    offsets.push_back(offset);
+    offset = alignUp(offset + asset.data.size());
+  }
+
+  std::vector<uint8_t> file(offset);
+  std::memcpy(file.data(), &header, sizeof(header));
+  std::memcpy(file.data() + header.directoryOffset, slots.data(), slots.size() * sizeof(AssetPack::Entry));
+  for (size_t i = 0; i < m_assets.size(); ++i) {
+    std::memcpy(file.data() + keyOffsets[i], m_assets[i].key.data(), m_assets[i].key.size());
+    std::memcpy(file.data() + offsets[i], m_assets[i].data.data(), m_assets[i].data.size());
+  }
+  return FileUtils::writeFileAtomic(outputPath, file.data(), file.size());
+}
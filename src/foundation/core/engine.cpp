@@ -1,12 +1,20 @@
 #include "foundation/core/engine.h"
+#include "components/cameraComponent.h"
+#include "foundation/core/assetPack.h"
 #include "foundation/core/config.h"
+#include "foundation/core/profiler.h"
+#include "rendering/backend/glBackend.h"
+#include "rendering/backend/nullBackend.h"
+#include "rendering/resources/programCache.h"
 
 #include "systems/cameraSystem.h"
 #include "systems/inputSystem.h"
+#include "systems/jobSystem.h"
 #include "systems/lightSystem.h"
 #include "systems/renderSystem.h"
 #include "systems/resourceSystem.h"
 #include "systems/sceneSystem.h"
+#include "systems/streamingSystem.h"
 #include "systems/timeSystem.h"
 #include "systems/transformSystem.h"
 #include "systems/uiSystem.h"
@@ -14,12 +22,21 @@
 
 #include <SDL3/SDL.h>
 
-Engine::Engine()
-    : m_screenWidth(EngineConfig::DEFAULT_SCREEN_WIDTH), m_screenHeight(EngineConfig::DEFAULT_SCREEN_HEIGHT) {}
+Engine::Engine(bool headless)
+    : m_screenWidth(EngineConfig::DEFAULT_SCREEN_WIDTH), m_screenHeight(EngineConfig::DEFAULT_SCREEN_HEIGHT),
+      m_headless(headless) {}
 
 Engine::~Engine() { SDL_Quit(); }
 
 bool Engine::init() {
+  // Register before the job workers so the main thread is thread 0 in traces
+  Profiler::setThreadName("Main");
+  PROFILE_ZONE("Init");
+
+  // Pre-cooked assets if shipped; assets missing from the pack still load from loose files
+  if (AssetPack::get().open(EngineConfig::ASSET_PACK_PATH))
+    SDL_Log("Mounted asset pack %s (%u assets)", EngineConfig::ASSET_PACK_PATH, AssetPack::get().getEntryCount());
+
   registerSystems();
 
   if (!loadResources()) {
@@ -32,32 +49,52 @@ bool Engine::init() {
 
 // Register all systems in dependency order
 void Engine::registerSystems() {
-  systemManager.insert<WindowSystem>(m_screenWidth, m_screenHeight);
+  systemManager.insert<JobSystem>();
+  systemManager.insert<WindowSystem>(m_screenWidth, m_screenHeight, m_headless);
+
+  // Backend must exist before any GPU resource is created
+  if (m_headless)
+    RenderBackend::set(std::make_unique<NullBackend>());
+  else
+    RenderBackend::set(std::make_unique<GLBackend>(systemManager.getSystem<WindowSystem>().getWindow()));
+
   systemManager.insert<InputSystem>();
   systemManager.insert<TimeSystem>();
-  systemManager.insert<ResourceSystem>();
+  systemManager.insert<ResourceSystem>(systemManager.getSystem<JobSystem>());
   systemManager.insert<RenderSystem>();
   systemManager.insert<TransformSystem>();
   systemManager.insert<CameraSystem>(componentManager, systemManager.getSystem<InputSystem>());
   systemManager.insert<LightSystem>();
   systemManager.insert<SceneSystem>(entityManager, componentManager, systemManager);
-  systemManager.insert<UISystem>(systemManager.getSystem<WindowSystem>().getWindow(),
-                                 systemManager.getSystem<WindowSystem>().getContext());
+  systemManager.insert<StreamingSystem>(componentManager, systemManager.getSystem<JobSystem>(),
+                                        systemManager.getSystem<SceneSystem>());
+
+  if (!m_headless) {
+    systemManager.insert<UISystem>(systemManager.getSystem<WindowSystem>().getWindow(),
+                                   systemManager.getSystem<WindowSystem>().getContext());
+  }
 }
 
 // Load shaders and initialize renderer
 bool Engine::loadResources() {
+  PROFILE_ZONE("LoadResources");
   auto &renderer = systemManager.getSystem<RenderSystem>().getRenderer();
-  auto &windowSystem = systemManager.getSystem<WindowSystem>();
   auto &resourceSystem = systemManager.getSystem<ResourceSystem>();
 
-  renderer.init(windowSystem.getWindow());
+  renderer.init();
 
   // Load base and shadow shaders
   uint32_t baseShader = resourceSystem.loadShader(EngineConfig::SHADER_VERTEX, EngineConfig::SHADER_FRAGMENT);
   uint32_t shadowShader =
       resourceSystem.loadShader(EngineConfig::SHADER_VERTEX_SHADOW, EngineConfig::SHADER_FRAGMENT_SHADOW);
 
+  const ProgramCache::Stats &programs = ProgramCache::getStats();
+  if (programs.hits + programs.misses > 0)
+    SDL_Log("Program cache: %u hits, %u misses (%u rejected), %.2f ms loading binaries, %.2f ms compiling, "
+            "%.2f ms saved",
+            programs.hits, programs.misses, programs.rejected, programs.loadMs, programs.compileMs,
+            programs.savedMs);
+
   if (baseShader == 0 && shadowShader == 1) {
     return true;
   }
@@ -72,38 +109,93 @@ void Engine::run() {
 }
 
 void Engine::loop(bool &running) {
-  while (running) {
+  while (running)
+    frame(running);
+}
+
+void Engine::runFrames(uint32_t frameCount) {
+  bool running = true;
+  for (uint32_t i = 0; i < frameCount && running; ++i)
+    frame(running);
+}
+
+void Engine::frame(bool &running) {
+  {
+    PROFILE_ZONE("Frame");
     update(running);
     render();
   }
+  Profiler::endFrame();
+}
+
+bool Engine::isHeadless() const { return m_headless; }
+
+const RenderStats &Engine::getRenderStats() { return systemManager.getSystem<RenderSystem>().getStats(); }
+
+ResourceMemoryStats Engine::getResourceMemoryStats() {
+  return systemManager.getSystem<ResourceSystem>().getMemoryStats();
 }
 
+JobSystem &Engine::getJobSystem() { return systemManager.getSystem<JobSystem>(); }
+
 // Update all game logic systems
 void Engine::update(bool &running) {
+  PROFILE_ZONE("Update");
   auto &inputSystem = systemManager.getSystem<InputSystem>();
   auto &timeSystem = systemManager.getSystem<TimeSystem>();
   auto &cameraSystem = systemManager.getSystem<CameraSystem>();
 
-  inputSystem.update(&running, systemManager);
+  // No window means no events to poll
+  if (!m_headless) {
+    PROFILE_ZONE("Input");
+    inputSystem.update(&running, systemManager);
+  }
   timeSystem.update();
-  cameraSystem.update(timeSystem.getDeltaTime(), systemManager);
+  {
+    PROFILE_ZONE("Camera");
+    cameraSystem.update(timeSystem.getDeltaTime(), systemManager);
+  }
+  {
+    PROFILE_ZONE("Streaming");
+    systemManager.getSystem<StreamingSystem>().update(timeSystem.getDeltaTime(), systemManager);
+  }
 }
 
 // Render frame: scene + UI
 void Engine::render() {
+  PROFILE_ZONE("Render");
   auto &renderSystem = systemManager.getSystem<RenderSystem>();
   auto &renderer = renderSystem.getRenderer();
-  auto &uiSystem = systemManager.getSystem<UISystem>();
 
   renderer.beginFrame();
 
+  // Pick up edited shaders/textures, then finish background asset loads before the scene is recorded
+  auto &resourceSystem = systemManager.getSystem<ResourceSystem>();
+  resourceSystem.processFileChanges();
+  resourceSystem.processUploads();
+  resourceSystem.enforceBudgets();
+
+  if (m_headless) {
+    renderSystem.renderCall(systemManager, entityManager, componentManager);
+    PROFILE_ZONE("Present");
+    renderer.endFrame();
+    return;
+  }
+
+  auto &uiSystem = systemManager.getSystem<UISystem>();
   uiSystem.beginFrame();
 
   renderSystem.renderCall(systemManager, entityManager, componentManager);
 
-  uiSystem.render(entityManager, systemManager, componentManager);
-  uiSystem.endFrame();
+  {
+    PROFILE_ZONE("UI");
+    uiSystem.render(entityManager, systemManager, componentManager);
+    renderer.getGpuTimer().begin(GpuPass::UI);
+    uiSystem.endFrame();
+    renderer.getGpuTimer().end(GpuPass::UI);
+  }
 
+  PROFILE_ZONE("Present");
   renderer.endFrame();
 }
 
@@ -120,8 +212,44 @@ void Engine::createModelEntity(const std::string &name, const std::string &model
   sceneSystem.createModelEntity(name, modelPath, position, rotation, scale);
 }
 
+bool Engine::createGltfEntities(const std::string &path, glm::vec3 position, glm::vec3 rotation, glm::vec3 scale) {
+  auto &sceneSystem = systemManager.getSystem<SceneSystem>();
+  return sceneSystem.createGltfEntities(path, position, rotation, scale);
+}
+
 void Engine::createLightEntity(const std::string &name, glm::vec3 position, glm::vec3 direction, glm::vec3 color,
                                LightType type, float intensity, float cutOff, float outerCutOff) {
   auto &sceneSystem = systemManager.getSystem<SceneSystem>();
   sceneSystem.createLightEntity(name, position, direction, color, type, intensity, cutOff, outerCutOff);
 }
+
+bool Engine::saveScene(const std::string &path, SceneFile::Format format) {
+  auto &sceneSystem = systemManager.getSystem<SceneSystem>();
+  return sceneSystem.saveScene(path, format);
+}
+
+bool Engine::loadScene(const std::string &path) {
+  auto &sceneSystem = systemManager.getSystem<SceneSystem>();
+  systemManager.getSystem<StreamingSystem>().closeWorld();
+  return sceneSystem.loadScene(path);
+}
+
+bool Engine::saveWorld(const std::string &directory, float cellSize) {
+  auto &sceneSystem = systemManager.getSystem<SceneSystem>();
+  return sceneSystem.saveWorld(directory, cellSize);
+}
+
+bool Engine::openWorld(const std::string &directory) {
+  auto &streamingSystem = systemManager.getSystem<StreamingSystem>();
+  return streamingSystem.openWorld(directory);
+}
+
+void Engine::closeWorld() { systemManager.getSystem<StreamingSystem>().closeWorld(); }
+
+StreamingStats Engine::getStreamingStats() { return systemManager.getSystem<StreamingSystem>().getStats(); }
+
+void Engine::setCameraPosition(glm::vec3 position) {
+  Entity activeCamera = systemManager.getSystem<CameraSystem>().getActiveCamera();
+  if (auto *camera = componentManager.tryGet<CameraComponent>(activeCamera))
+    camera->position = position;
+}
@@ -0,0 +1,68 @@
+#include "foundation/core/fileUtils.h"
+#include "foundation/core/mappedFile.h"
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+
+namespace fs = std::filesystem;
+
+uint64_t FileUtils::hashData(const void *data, size_t size, uint64_t hash) {
+  const uint8_t *bytes = static_cast<const uint8_t *>(data);
+  for (size_t i = 0; i < size; ++i)
+    hash = (hash ^ bytes[i]) * 1099511628211ull;
+  return hash;
+}
+
+uint64_t FileUtils::hashPath(const std::string &path) {
+  std::string normalized = fs::path(path).lexically_normal().generic_string();
+  return hashData(normalized.data(), normalized.size());
+}
+
+bool FileUtils::getFileStamp(const std::string &path, int64_t &modified, uint64_t &size) {
+  std::error_code error;
+  auto time = fs::last_write_time(path, error);
+  if (error)
+    return false;
+  size = fs::file_size(path, error);
+  if (error)
+    return false;
+  modified = static_cast<int64_t>(time.time_since_epoch().count());
+  return true;
+}
+
+bool FileUtils::hashFile(const std::string &path, uint64_t &hash) {
+  std::error_code error;
+  if (!fs::is_regular_file(path, error))
+    return false;
+
+  hash = 1469598103934665603ull;
+  MappedFile file;
+  if (!file.open(path))
+    return fs::file_size(path, error) == 0 && !error; // empty files cannot be mapped
+
+  hash = hashData(file.getData(), file.getSize(), hash);
+  return true;
+}
+
+bool FileUtils::writeFileAtomic(const std::string &path, const void *data, size_t size) {
+  std::error_code error;
+  fs::create_directories(fs::path(path).parent_path(), error);
+
+  std::string tempPath = path + ".tmp";
+  {
+    std::ofstream file(tempPath, std::ios::binary | std::ios::trunc);
+    if (!file)
+      return false;
+    file.write(static_cast<const char *>(data), static_cast<std::streamsize>(size));
+    if (!file)
+      return false;
+  }
+
+  fs::rename(tempPath, path, error);
+  if (error) {
+    std::cerr << "[FileUtils] Cannot write " << path << ": " << error.message() << std::endl;
+    fs::remove(tempPath, error);
+    return false;
+  }
+  return true;
+}
@@ -0,0 +1,118 @@
+#include "foundation/core/fileWatcher.h"
+#include "foundation/core/config.h"
+#include <algorithm>
+#include <iostream>
+
+#ifdef __linux__
+#include <cerrno>
+#include <cstring>
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+namespace fs = std::filesystem;
+
+// "shaders/a.vert" and "../assets/shaders/a.vert" must report the same file
+std::string FileWatcher::normalize(const std::string &path) {
+  std::error_code error;
+  fs::path absolute = fs::absolute(path, error);
+  return (error ? fs::path(path) : absolute).lexically_normal().generic_string();
+}
+
+// Report a file once per poll
+static void addChanged(std::vector<std::string> &changed, const std::string &path) {
+  if (std::find(changed.begin(), changed.end(), path) == changed.end())
+    changed.push_back(path);
+}
+
+size_t FileWatcher::getWatchCount() const { return m_files.size(); }
+
+#ifdef __linux__
+FileWatcher::FileWatcher() {
+  m_fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+  if (m_fd < 0)
+    std::cerr << "[FileWatcher] inotify unavailable: " << std::strerror(errno) << std::endl;
+}
+
+FileWatcher::~FileWatcher() {
+  if (m_fd >= 0)
+    close(m_fd);
+}
+
+std::string FileWatcher::watch(const std::string &path) {
+  std::string file = normalize(path);
+  if (m_fd < 0 || !m_files.insert(file).second)
+    return file;
+
+  // One watch per directory; inotify returns the existing descriptor for a directory watched before
+  std::string directory = fs::path(file).parent_path().generic_string();
+  int wd = inotify_add_watch(m_fd, directory.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO);
+  if (wd < 0) {
+    std::cerr << "[FileWatcher] Cannot watch " << directory << ": " << std::strerror(errno) << std::endl;
+    m_files.erase(file);
+    return file;
+  }
+  m_directories[wd] = directory;
+  return file;
+}
+
+void FileWatcher::poll(std::vector<std::string> &changed) {
+  if (m_fd < 0)
+    return;
+
+  alignas(inotify_event) char buffer[4096];
+  for (;;) {
+    ssize_t length = read(m_fd, buffer, sizeof(buffer));
+    if (length <= 0)
+      break; // EAGAIN: no more events
+
+    for (char *p = buffer; p < buffer + length;) {
+      const auto *event = reinterpret_cast<const inotify_event *>(p);
+      p += sizeof(inotify_event) + event->len;
+
+      // Events were dropped: assume everything changed
+      if (event->mask & IN_Q_OVERFLOW) {
+        for (const auto &file : m_files)
+          addChanged(changed, file);
+        continue;
+      }
+
+      auto directory = m_directories.find(event->wd);
+      if (directory == m_directories.end() || event->len == 0)
+        continue;
+      std::string file = directory->second + "/" + event->name;
+      if (m_files.count(file))
+        addChanged(changed, file);
+    }
+  }
+}
+#else
+FileWatcher::FileWatcher() = default;
+FileWatcher::~FileWatcher() = default;
+
+std::string FileWatcher::watch(const std::string &path) {
+  std::string file = normalize(path);
+  if (!m_files.insert(file).second)
+    return file;
+
+  std::error_code error;
+  m_writeTimes[file] = fs::last_write_time(file, error);
+  return file;
+}
+
+void FileWatcher::poll(std::vector<std::string> &changed) {
+  auto now = std::chrono::steady_clock::now();
+  if (now - m_lastPoll < std::chrono::milliseconds(EngineConfig::HOT_RELOAD_POLL_MS))
+    return;
+  m_lastPoll = now;
+
+  for (auto &[file, writeTime] : m_writeTimes) {
+    std::error_code error;
+    auto time = fs::last_write_time(file, error);
+    if (error || time == writeTime)
+      continue;
+    writeTime = time;
+    addChanged(changed, file);
+  }
+}
+#endif
@@ -1,28 +1,84 @@
 #include "foundation/core/config.h"
 #include "foundation/core/engine.h"
+#include "rendering/backend/nullBackend.h"
+#include "systems/renderSystem.h"
+#include "systems/resourceSystem.h"
+#include <SDL3/SDL.h>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
 
 // Scene setup helpers
 void createDefaultModel(const std::string &name, Engine &engine, glm::vec3 position = glm::vec3(0.0f),
                         glm::vec3 scale = glm::vec3(1.0f));
 void createDirectionalLight(const std::string &name, Engine &engine);
 void createCamera(Engine &engine);
+void runHeadless(Engine &engine, uint32_t frameCount, uint32_t modelCount);
 
-int main() {
-  Engine engine;
+// Usage: engine [--headless [frames] [models]] | [--scene path] | [--world dir]
+int main(int argc, char *argv[]) {
+  bool headless = argc > 1 && std::strcmp(argv[1], "--headless") == 0;
+  Engine engine(headless);
 
   if (!engine.init()) {
     return 1;
   }
 
-  // Setup default scene
-  createDefaultModel("Object", engine, glm::vec3(0.0f), glm::vec3(1.0f));
-  createDirectionalLight("Directional", engine);
-  createCamera(engine);
+  // Saved scene, or the default one
+  bool sceneLoaded = argc > 2 && std::strcmp(argv[1], "--scene") == 0 && engine.loadScene(argv[2]);
+  if (!sceneLoaded) {
+    createDefaultModel("Object", engine, glm::vec3(0.0f), glm::vec3(1.0f));
+    createDirectionalLight("Directional", engine);
+    createCamera(engine);
+  }
+  if (argc > 2 && std::strcmp(argv[1], "--world") == 0 && !engine.openWorld(argv[2]))
+    SDL_Log("Failed to open world %s", argv[2]);
+
+  if (headless) {
+    uint32_t frameCount = argc > 2 ? std::atoi(argv[2]) : 300;
+    uint32_t modelCount = argc > 3 ? std::atoi(argv[3]) : 1000;
+    runHeadless(engine, frameCount, modelCount);
+    return 0;
+  }
 
   engine.run();
   return 0;
 }
 
+// Spawn a grid of models, run the frame loop without a GPU and print the recorded workload
+void runHeadless(Engine &engine, uint32_t frameCount, uint32_t modelCount) {
+  const uint32_t gridWidth = 32;
+  for (uint32_t i = 0; i < modelCount; ++i) {
+    glm::vec3 position((i % gridWidth) * 3.0f - gridWidth * 1.5f, 0.0f, -3.0f - (i / gridWidth) * 3.0f);
+    createDefaultModel("Object " + std::to_string(i), engine, position);
+  }
+
+  auto start = std::chrono::steady_clock::now();
+  engine.runFrames(frameCount);
+  auto end = std::chrono::steady_clock::now();
+
+  double totalMs = std::chrono::duration<double, std::milli>(end - start).count();
+  const RenderStats &stats = engine.getRenderStats();
+  auto &backend = static_cast<NullBackend &>(RenderBackend::get());
+  const BackendCounters &frame = backend.getFrameCounters();
+
+  SDL_Log("Headless: %u frames, %u models, %.3f ms/frame", frameCount, modelCount + 1,
+          frameCount ? totalMs / frameCount : 0.0);
+  SDL_Log("  render: %u draws, %u triangles, %u shadow triangles, %u culled, %u mesh batches", stats.drawCalls,
+          stats.triangles, stats.shadowTriangles, stats.culledEntities, stats.meshBatches);
+  SDL_Log("  backend: %llu draws, %llu program binds, %llu texture binds, %llu uniform uploads",
+          (unsigned long long)frame.drawCalls, (unsigned long long)frame.programBinds,
+          (unsigned long long)frame.textureBinds, (unsigned long long)frame.uniformUploads);
+  SDL_Log("  resident: %zu buffer bytes, %zu texture bytes", backend.getResidentBufferBytes(),
+          backend.getResidentTextureBytes());
+
+  ResourceMemoryStats memory = engine.getResourceMemoryStats();
+  SDL_Log("  resources: meshes %zu CPU + %zu GPU bytes (%u cached, %u evicted), textures %zu CPU + %zu GPU bytes "
+          "(%u evicted, %u now placeholders)",
+          memory.meshCpuBytes, memory.meshGpuBytes, memory.cachedMeshes, memory.meshEvictions, memory.textureCpuBytes,
+          memory.textureGpuBytes, memory.textureEvictions, memory.evictedTextures);
+}
+
 void createDefaultModel(const std::string &name, Engine &engine, glm::vec3 position, glm::vec3 scale) {
   glm::vec3 rotation(0.0f);
   engine.createModelEntity(name, EngineConfig::MODEL_BOX, position, rotation, scale);
@@ -41,3 +97,4 @@ void createCamera(Engine &engine) {
   glm::vec3 position(0.0f, 3.0f, 8.0f);
   engine.createCameraEntity(position, 0.0f, -15.0f, 90.0f);
 }
+
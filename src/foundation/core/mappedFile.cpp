@@ -0,0 +1,111 @@
+#include "foundation/core/mappedFile.h"
+#include <utility>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+MappedFile::~MappedFile() { close(); }
+
+MappedFile::MappedFile(MappedFile &&other) noexcept { *this = std::move(other); }
+
+MappedFile &MappedFile::operator=(MappedFile &&other) noexcept {
+  if (this != &other) {
+    close();
+    std::swap(m_data, other.m_data);
+    std::swap(m_size, other.m_size);
+#ifdef _WIN32
+    std::swap(m_file, other.m_file);
+    std::swap(m_mapping, other.m_mapping);
+#endif
+  }
+  return *this;
+}
+
+#ifdef _WIN32
+bool MappedFile::open(const std::string &path) {
+  close();
+
+  HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                            FILE_ATTRIBUTE_NORMAL, nullptr);
+  if (file == INVALID_HANDLE_VALUE)
+    return false;
+
+  LARGE_INTEGER size;
+  if (!GetFileSizeEx(file, &size) || size.QuadPart == 0) {
+    CloseHandle(file);
+    return false;
+  }
+
+  HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+  void *view = mapping ? MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0) : nullptr;
+  if (!view) {
+    if (mapping)
+      CloseHandle(mapping);
+    CloseHandle(file);
+    return false;
+  }
+
+  m_file = file;
+  m_mapping = mapping;
+  m_data = static_cast<const uint8_t *>(view);
+  m_size = static_cast<size_t>(size.QuadPart);
+  return true;
+}
+
+void MappedFile::close() {
+  if (m_data)
+    UnmapViewOfFile(m_data);
+  if (m_mapping)
+    CloseHandle(m_mapping);
+  if (m_file)
+    CloseHandle(m_file);
+  m_data = nullptr;
+  m_mapping = nullptr;
+  m_file = nullptr;
+  m_size = 0;
+}
+#else
+bool MappedFile::open(const std::string &path) {
+  close();
+
+  int fd = ::open(path.c_str(), O_RDONLY);
+  if (fd < 0)
+    return false;
+
+  struct stat info;
+  if (fstat(fd, &info) != 0 || info.st_size == 0) {
+    ::close(fd);
+    return false;
+  }
+
+  // The mapping keeps the file referenced, the descriptor is not needed anymore
+  void *view = mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+  ::close(fd);
+  if (view == MAP_FAILED)
+    return false;
+
+  m_data = static_cast<const uint8_t *>(view);
+  m_size = static_cast<size_t>(info.st_size);
+  return true;
+}
+
+void MappedFile::close() {
+  if (m_data)
+    munmap(const_cast<uint8_t *>(m_data), m_size);
+  m_data = nullptr;
+  m_size = 0;
+}
+#endif
+
+bool MappedFile::isOpen() const { return m_data != nullptr; }
+
+const uint8_t *MappedFile::getData() const { return m_data; }
+
+size_t MappedFile::getSize() const { return m_size; }
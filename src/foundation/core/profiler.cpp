@@ -0,0 +1,215 @@
+#include "foundation/core/profiler.h"
+#include "foundation/core/config.h"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <deque>
+#include <fstream>
+#include <iostream>
+#include <json/json.hpp>
+#include <memory>
+#include <mutex>
+
+namespace {
+constexpr uint32_t MAX_ZONE_DEPTH = 64;
+
+// Per-thread event ring: written by its thread only, drained by endFrame()
+struct ThreadBuffer {
+  uint32_t id = 0;
+  std::string name;
+  std::vector<ProfileEvent> ring;
+  std::atomic<uint64_t> written{0};
+  uint64_t read = 0;
+
+  // open zones of the owning thread
+  std::array<const char *, MAX_ZONE_DEPTH> openNames{};
+  std::array<uint64_t, MAX_ZONE_DEPTH> openStarts{};
+  uint32_t depth = 0;
+};
+
+const auto s_epoch = std::chrono::steady_clock::now();
+std::atomic<bool> s_enabled{EngineConfig::PROFILER_ENABLED};
+
+std::mutex s_registryMutex;
+std::vector<std::shared_ptr<ThreadBuffer>> s_threads;
+
+// main thread only
+std::deque<ProfileFrame> s_history;
+uint64_t s_frameStart = 0;
+
+// Buffers outlive their thread so late events can still be collected
+ThreadBuffer &localBuffer() {
+  thread_local std::shared_ptr<ThreadBuffer> buffer = [] {
+    auto created = std::make_shared<ThreadBuffer>();
+    created->ring.resize(EngineConfig::PROFILER_RING_CAPACITY);
+
+    std::lock_guard<std::mutex> lock(s_registryMutex);
+    created->id = static_cast<uint32_t>(s_threads.size());
+    created->name = "Thread " + std::to_string(created->id);
+    s_threads.push_back(created);
+    return created;
+  }();
+  return *buffer;
+}
+
+// Copy the unread events of one thread. The owning thread keeps writing meanwhile, so this reads like a seqlock:
+// take the head (everything before it is published), copy at most one ring of events behind it, then look at the
+// head again and drop every copied slot the writer may have reused since, including the one it is writing now.
+void drain(ThreadBuffer &buffer, std::vector<ProfileEvent> &out) {
+  const uint64_t capacity = buffer.ring.size();
+  const uint64_t head = buffer.written.load(std::memory_order_acquire);
+  const uint64_t first = std::max(buffer.read, head > capacity ? head - capacity : 0);
+
+  size_t outStart = out.size();
+  for (uint64_t i = first; i < head; ++i)
+    out.push_back(buffer.ring[i % capacity]);
+
+  // Slot of event i is rewritten by event i + capacity, which may be in progress once the head reached it
+  std::atomic_thread_fence(std::memory_order_acquire);
+  const uint64_t after = buffer.written.load(std::memory_order_relaxed);
+  if (after >= capacity && after - capacity >= first) {
+    uint64_t torn = std::min(after - capacity + 1, head) - first;
+    out.erase(out.begin() + outStart, out.begin() + outStart + torn);
+  }
+
+  buffer.read = head;
+}
+} // namespace
+
+void Profiler::setEnabled(bool enabled) { s_enabled.store(enabled, std::memory_order_relaxed); }
+
+bool Profiler::isEnabled() { return s_enabled.load(std::memory_order_relaxed); }
+
+uint64_t Profiler::now() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - s_epoch).count();
+}
+
+void Profiler::beginZone(const char *name) {
+  ThreadBuffer &buffer = localBuffer();
+  if (buffer.depth < MAX_ZONE_DEPTH) {
+    buffer.openNames[buffer.depth] = name;
+    buffer.openStarts[buffer.depth] = now();
+  }
+  buffer.depth++;
+}
+
+void Profiler::endZone() {
+  ThreadBuffer &buffer = localBuffer();
+  if (buffer.depth == 0)
+    return;
+
+  buffer.depth--;
+  if (buffer.depth >= MAX_ZONE_DEPTH)
+    return;
+
+  ProfileEvent event;
+  event.name = buffer.openNames[buffer.depth];
+  event.start = buffer.openStarts[buffer.depth];
+  event.end = now();
+  event.threadId = buffer.id;
+  event.depth = buffer.depth;
+
+  // The fence orders the previous publish before this slot write, so drain() can tell a reused slot by the head
+  uint64_t index = buffer.written.load(std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+  buffer.ring[index % buffer.ring.size()] = event;
+  buffer.written.store(index + 1, std::memory_order_release);
+}
+
+void Profiler::setThreadName(const std::string &name) {
+  ThreadBuffer &buffer = localBuffer();
+  std::lock_guard<std::mutex> lock(s_registryMutex);
+  buffer.name = name;
+}
+
+std::string Profiler::getThreadName(uint32_t threadId) {
+  std::lock_guard<std::mutex> lock(s_registryMutex);
+  return threadId < s_threads.size() ? s_threads[threadId]->name : std::string();
+}
+
+void Profiler::endFrame() {
+  ProfileFrame frame;
+  frame.start = s_frameStart;
+  frame.end = now();
+  s_frameStart = frame.end;
+
+  std::vector<std::shared_ptr<ThreadBuffer>> threads;
+  {
+    std::lock_guard<std::mutex> lock(s_registryMutex);
+    threads = s_threads;
+  }
+  for (auto &thread : threads)
+    drain(*thread, frame.events);
+
+  // Events are written when a zone ends; order them by start for display
+  std::sort(frame.events.begin(), frame.events.end(), [](const ProfileEvent &a, const ProfileEvent &b) {
+    return a.threadId != b.threadId ? a.threadId < b.threadId : a.start < b.start;
+  });
+
+  s_history.push_back(std::move(frame));
+  while (s_history.size() > EngineConfig::PROFILER_HISTORY_FRAMES)
+    s_history.pop_front();
+}
+
+const ProfileFrame &Profiler::getLastFrame() {
+  static const ProfileFrame empty;
+  return s_history.empty() ? empty : s_history.back();
+}
+
+std::vector<ProfileZoneStats> Profiler::getZoneStats() {
+  std::vector<ProfileZoneStats> zones;
+
+  for (const ProfileEvent &event : getLastFrame().events) {
+    auto it = std::find_if(zones.begin(), zones.end(),
+                           [&](const ProfileZoneStats &zone) { return std::strcmp(zone.name, event.name) == 0; });
+    if (it == zones.end()) {
+      zones.push_back({event.name, event.depth});
+      it = zones.end() - 1;
+    }
+    it->depth = std::min(it->depth, event.depth);
+    it->calls++;
+    it->totalMs += (event.end - event.start) / 1e6;
+  }
+
+  return zones;
+}
+
+bool Profiler::writeChromeTrace(const std::string &path) {
+  nlohmann::json events = nlohmann::json::array();
+
+  {
+    std::lock_guard<std::mutex> lock(s_registryMutex);
+    for (const auto &thread : s_threads) {
+      events.push_back({{"name", "thread_name"},
+                        {"ph", "M"},
+                        {"pid", 0},
+                        {"tid", thread->id},
+                        {"args", {{"name", thread->name}}}});
+    }
+  }
+
+  // Complete events ("X"), timestamps in microseconds
+  for (const ProfileFrame &frame : s_history) {
+    for (const ProfileEvent &event : frame.events) {
+      events.push_back({{"name", event.name},
+                        {"cat", "cpu"},
+                        {"ph", "X"},
+                        {"ts", event.start / 1000.0},
+                        {"dur", (event.end - event.start) / 1000.0},
+                        {"pid", 0},
+                        {"tid", event.threadId}});
+    }
+  }
+
+  std::ofstream file(path);
+  if (!file) {
+    std::cerr << "[Profiler] Cannot write trace: " << path << std::endl;
+    return false;
+  }
+
+  nlohmann::json trace = {{"traceEvents", std::move(events)}, {"displayTimeUnit", "ms"}};
+  file << trace.dump();
+  return static_cast<bool>(file);
+}
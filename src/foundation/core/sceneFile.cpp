@@ -0,0 +1,467 @@
+#include "foundation/core/sceneFile.h"
+#include "components/cameraComponent.h"
+#include "components/lightComponent.h"
+#include "foundation/core/fileUtils.h"
+#include "foundation/core/mappedFile.h"
+#include "foundation/core/profiler.h"
+#include <cstring>
+#include <iostream>
+#include <json/json.hpp>
+#include <map>
+#include <type_traits>
+
+// Single precision numbers, so values print as the floats they are (0.2, not 0.20000000298023224)
+using json = nlohmann::basic_json<std::map, std::vector, std::string, bool, std::int64_t, std::uint64_t, float>;
+
+static_assert(std::is_trivially_copyable_v<glm::vec3> && sizeof(glm::vec3) == 12, "vec3 columns are stored raw");
+static_assert(std::is_trivially_copyable_v<SceneFile::LightRecord>, "LightRecord is stored raw");
+static_assert(std::is_trivially_copyable_v<SceneFile::CameraRecord>, "CameraRecord is stored raw");
+
+namespace {
+constexpr char MAGIC[4] = {'S', 'C', 'N', 'S'};
+constexpr uint64_t ALIGNMENT = 8;
+constexpr const char *SLOT_NAMES[4] = {"diffuse", "specular", "normal", "emission"};
+constexpr const char *LIGHT_TYPE_NAMES[3] = {"directional", "point", "spot"};
+
+uint64_t alignUp(uint64_t offset) { return (offset + ALIGNMENT - 1) & ~(ALIGNMENT - 1); }
+
+// Snapshot columns, in file order
+enum Column {
+  StringEnds, // end offset of each string in StringBytes
+  StringBytes,
+  Names,
+  TransformEntities,
+  Positions,
+  Rotations,
+  Scales,
+  ModelEntities,
+  ModelMeshes,
+  ModelMaterialStarts,
+  ModelMaterialCounts,
+  ModelMaterials,
+  Meshes,
+  Materials,
+  Occluders,
+  Lights,
+  Cameras,
+  ColumnCount
+};
+
+struct ColumnRange {
+  uint64_t offset;
+  uint64_t bytes;
+};
+
+struct Header {
+  char magic[4];
+  uint32_t formatVersion;
+  uint32_t entityCount;
+  uint32_t columnCount;
+  ColumnRange columns[ColumnCount];
+};
+
+// ---------- validation ----------
+
+bool isIndexColumn(const std::vector<uint32_t> &values, size_t limit, bool allowNone = false) {
+  for (uint32_t value : values)
+    if (value >= limit && !(allowNone && value == SceneFile::NO_STRING))
+      return false;
+  return true;
+}
+
+bool validate(const SceneFile::Data &data) {
+  const size_t transforms = data.transformEntities.size(), models = data.modelEntities.size();
+  if (data.names.size() != data.entityCount || data.positions.size() != transforms ||
+      data.rotations.size() != transforms || data.scales.size() != transforms || data.modelMeshes.size() != models ||
+      data.modelMaterialStarts.size() != models || data.modelMaterialCounts.size() != models)
+    return false;
+
+  if (!isIndexColumn(data.names, data.strings.size(), true) || !isIndexColumn(data.meshes, data.strings.size()) ||
+      !isIndexColumn(data.transformEntities, data.entityCount) ||
+      !isIndexColumn(data.modelEntities, data.entityCount) || !isIndexColumn(data.occluders, data.entityCount) ||
+      !isIndexColumn(data.modelMeshes, data.meshes.size()) ||
+      !isIndexColumn(data.modelMaterials, data.materials.size()))
+    return false;
+
+  for (size_t i = 0; i < models; ++i)
+    if (uint64_t(data.modelMaterialStarts[i]) + data.modelMaterialCounts[i] > data.modelMaterials.size())
+      return false;
+  for (const SceneFile::MaterialRecord &material : data.materials)
+    for (uint32_t texture : material.textures)
+      if (texture >= data.strings.size() && texture != SceneFile::NO_STRING)
+        return false;
+  for (const SceneFile::LightRecord &light : data.lights)
+    if (light.entity >= data.entityCount || light.type > static_cast<uint32_t>(LightType::Spot))
+      return false;
+  for (const SceneFile::CameraRecord &camera : data.cameras)
+    if (camera.entity >= data.entityCount)
+      return false;
+  return true;
+}
+
+// ---------- snapshot ----------
+
+template <typename T> void appendColumn(std::vector<uint8_t> &file, Header &header, Column column, const T *values,
+                                        size_t count) {
+  header.columns[column].offset = file.size();
+  header.columns[column].bytes = count * sizeof(T);
+  file.resize(alignUp(file.size() + count * sizeof(T)));
+  if (count > 0)
+    std::memcpy(file.data() + header.columns[column].offset, values, count * sizeof(T));
+}
+
+template <typename T>
+void appendColumn(std::vector<uint8_t> &file, Header &header, Column column, const std::vector<T> &values) {
+  appendColumn(file, header, column, values.data(), values.size());
+}
+
+bool writeSnapshot(const std::string &path, const SceneFile::Data &data) {
+  Header header{};
+  std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+  header.formatVersion = SceneFile::FORMAT_VERSION;
+  header.entityCount = data.entityCount;
+  header.columnCount = ColumnCount;
+
+  std::vector<uint32_t> stringEnds;
+  std::string stringBytes;
+  for (const std::string &value : data.strings) {
+    stringBytes += value;
+    stringEnds.push_back(static_cast<uint32_t>(stringBytes.size()));
+  }
+
+  std::vector<uint8_t> file(alignUp(sizeof(Header)));
+  appendColumn(file, header, StringEnds, stringEnds);
+  appendColumn(file, header, StringBytes, stringBytes.data(), stringBytes.size());
+  appendColumn(file, header, Names, data.names);
+  appendColumn(file, header, TransformEntities, data.transformEntities);
+  appendColumn(file, header, Positions, data.positions);
+  appendColumn(file, header, Rotations, data.rotations);
+  appendColumn(file, header, Scales, data.scales);
+  appendColumn(file, header, ModelEntities, data.modelEntities);
+  appendColumn(file, header, ModelMeshes, data.modelMeshes);
+  appendColumn(file, header, ModelMaterialStarts, data.modelMaterialStarts);
+  appendColumn(file, header, ModelMaterialCounts, data.modelMaterialCounts);
+  appendColumn(file, header, ModelMaterials, data.modelMaterials);
+  appendColumn(file, header, Meshes, data.meshes);
+  appendColumn(file, header, Materials, data.materials);
+  appendColumn(file, header, Occluders, data.occluders);
+  appendColumn(file, header, Lights, data.lights);
+  appendColumn(file, header, Cameras, data.cameras);
+  std::memcpy(file.data(), &header, sizeof(Header));
+  return FileUtils::writeFileAtomic(path, file.data(), file.size());
+}
+
+// Copy a column out of the mapped file; false if it lies outside the file or is not whole elements
+template <typename T>
+bool readColumn(const MappedFile &file, const Header &header, Column column, std::vector<T> &values) {
+  const ColumnRange &range = header.columns[column];
+  if (range.offset > file.getSize() || range.bytes > file.getSize() - range.offset || range.bytes % sizeof(T) != 0)
+    return false;
+  values.resize(range.bytes / sizeof(T));
+  if (range.bytes > 0)
+    std::memcpy(values.data(), file.getData() + range.offset, range.bytes);
+  return true;
+}
+
+bool readSnapshot(const MappedFile &file, SceneFile::Data &data) {
+  Header header;
+  std::memcpy(&header, file.getData(), sizeof(Header));
+  if (header.formatVersion != SceneFile::FORMAT_VERSION || header.columnCount != ColumnCount)
+    return false;
+  data.entityCount = header.entityCount;
+
+  std::vector<uint32_t> stringEnds;
+  std::vector<char> stringBytes;
+  if (!readColumn(file, header, StringEnds, stringEnds) || !readColumn(file, header, StringBytes, stringBytes))
+    return false;
+  data.strings.reserve(stringEnds.size());
+  for (uint32_t i = 0, start = 0; i < stringEnds.size(); start = stringEnds[i++]) {
+    if (stringEnds[i] < start || stringEnds[i] > stringBytes.size())
+      return false;
+    data.strings.emplace_back(stringBytes.data() + start, stringEnds[i] - start);
+  }
+
+  return readColumn(file, header, Names, data.names) &&
+         readColumn(file, header, TransformEntities, data.transformEntities) &&
+         readColumn(file, header, Positions, data.positions) && readColumn(file, header, Rotations, data.rotations) &&
+         readColumn(file, header, Scales, data.scales) &&
+         readColumn(file, header, ModelEntities, data.modelEntities) &&
+         readColumn(file, header, ModelMeshes, data.modelMeshes) &&
+         readColumn(file, header, ModelMaterialStarts, data.modelMaterialStarts) &&
+         readColumn(file, header, ModelMaterialCounts, data.modelMaterialCounts) &&
+         readColumn(file, header, ModelMaterials, data.modelMaterials) &&
+         readColumn(file, header, Meshes, data.meshes) && readColumn(file, header, Materials, data.materials) &&
+         readColumn(file, header, Occluders, data.occluders) && readColumn(file, header, Lights, data.lights) &&
+         readColumn(file, header, Cameras, data.cameras);
+}
+
+// ---------- JSON ----------
+
+json toJson(const glm::vec3 &value) { return json::array({value.x, value.y, value.z}); }
+
+// Typed lookups that never throw (missing or mistyped members keep the fallback)
+glm::vec3 getVec3(const json &object, const char *key, const glm::vec3 &fallback) {
+  auto it = object.find(key);
+  if (it == object.end() || !it->is_array() || it->size() != 3)
+    return fallback;
+  glm::vec3 value;
+  for (int i = 0; i < 3; ++i) {
+    if (!(*it)[i].is_number())
+      return fallback;
+    value[i] = (*it)[i].get<float>();
+  }
+  return value;
+}
+
+float getFloat(const json &object, const char *key, float fallback) {
+  auto it = object.find(key);
+  return it != object.end() && it->is_number() ? it->get<float>() : fallback;
+}
+
+std::string getString(const json &object, const char *key) {
+  auto it = object.find(key);
+  return it != object.end() && it->is_string() ? it->get<std::string>() : std::string();
+}
+
+const json *getObject(const json &object, const char *key) {
+  auto it = object.find(key);
+  return it != object.end() && it->is_object() ? &*it : nullptr;
+}
+
+bool writeJson(const std::string &path, const SceneFile::Data &data) {
+  std::vector<json> entities(data.entityCount, json::object());
+  for (uint32_t i = 0; i < data.entityCount; ++i)
+    if (data.names[i] != SceneFile::NO_STRING)
+      entities[i]["name"] = data.strings[data.names[i]];
+
+  for (size_t i = 0; i < data.transformEntities.size(); ++i)
+    entities[data.transformEntities[i]]["transform"] = {{"position", toJson(data.positions[i])},
+                                                        {"rotation", toJson(data.rotations[i])},
+                                                        {"scale", toJson(data.scales[i])}};
+
+  for (size_t i = 0; i < data.modelEntities.size(); ++i) {
+    json materials = json::array();
+    for (uint32_t m = 0; m < data.modelMaterialCounts[i]; ++m) {
+      const SceneFile::MaterialRecord &record = data.materials[data.modelMaterials[data.modelMaterialStarts[i] + m]];
+      json material = {{"shininess", record.shininess}};
+      for (int slot = 0; slot < 4; ++slot)
+        if (record.textures[slot] != SceneFile::NO_STRING)
+          material[SLOT_NAMES[slot]] = data.strings[record.textures[slot]];
+      materials.push_back(std::move(material));
+    }
+    entities[data.modelEntities[i]]["model"] = {{"mesh", data.strings[data.meshes[data.modelMeshes[i]]]},
+                                                {"materials", std::move(materials)}};
+  }
+
+  for (uint32_t entity : data.occluders)
+    entities[entity]["occluder"] = true;
+
+  for (const SceneFile::LightRecord &light : data.lights)
+    entities[light.entity]["light"] = {
+        {"type", LIGHT_TYPE_NAMES[light.type]}, {"position", toJson(light.position)},
+        {"direction", toJson(light.direction)}, {"color", toJson(light.color)},
+        {"intensity", light.intensity},         {"ambient", light.ambient},
+        {"constant", light.constant},           {"linear", light.linear},
+        {"quadratic", light.quadratic},         {"cutOff", light.cutOff},
+        {"outerCutOff", light.outerCutOff}};
+
+  for (const SceneFile::CameraRecord &camera : data.cameras)
+    entities[camera.entity]["camera"] = {{"position", toJson(camera.position)},
+                                         {"yaw", camera.yaw},
+                                         {"pitch", camera.pitch},
+                                         {"fov", camera.fov},
+                                         {"moveSpeed", camera.moveSpeed},
+                                         {"mouseSensitivity", camera.mouseSensitivity},
+                                         {"smoothFactor", camera.smoothFactor},
+                                         {"active", camera.active != 0}};
+
+  json document = {{"version", SceneFile::FORMAT_VERSION}, {"entities", std::move(entities)}};
+  std::string text = document.dump(2);
+  return FileUtils::writeFileAtomic(path, text.data(), text.size());
+}
+
+// Missing members take the component defaults, so a hand-written scene only needs what differs
+bool readJson(const MappedFile &file, SceneFile::Data &data) {
+  const char *text = reinterpret_cast<const char *>(file.getData());
+  json document = json::parse(text, text + file.getSize(), nullptr, false);
+  const json *entities = document.is_object() ? &document["entities"] : nullptr;
+  if (!entities || !entities->is_array())
+    return false;
+
+  const LightComponent lightDefaults(LightType::Point);
+  const CameraComponent cameraDefaults;
+  std::unordered_map<std::string, uint32_t> meshIndices;
+  std::unordered_map<std::string, uint32_t> materialIndices; // by the material's JSON text
+
+  data.entityCount = static_cast<uint32_t>(entities->size());
+  data.names.assign(data.entityCount, SceneFile::NO_STRING);
+  for (uint32_t entity = 0; entity < data.entityCount; ++entity) {
+    const json &object = (*entities)[entity];
+    if (!object.is_object())
+      return false;
+    std::string name = getString(object, "name");
+    if (!name.empty())
+      data.names[entity] = data.addString(name);
+
+    if (const json *transform = getObject(object, "transform")) {
+      data.transformEntities.push_back(entity);
+      data.positions.push_back(getVec3(*transform, "position", glm::vec3(0.0f)));
+      data.rotations.push_back(getVec3(*transform, "rotation", glm::vec3(0.0f)));
+      data.scales.push_back(getVec3(*transform, "scale", glm::vec3(1.0f)));
+    }
+
+    if (const json *model = getObject(object, "model")) {
+      std::string mesh = getString(*model, "mesh");
+      if (mesh.empty())
+        return false;
+      auto [meshIt, newMesh] = meshIndices.try_emplace(mesh, static_cast<uint32_t>(data.meshes.size()));
+      if (newMesh)
+        data.meshes.push_back(data.addString(mesh));
+
+      data.modelEntities.push_back(entity);
+      data.modelMeshes.push_back(meshIt->second);
+      data.modelMaterialStarts.push_back(static_cast<uint32_t>(data.modelMaterials.size()));
+      auto materials = model->find("materials");
+      if (materials != model->end() && materials->is_array()) {
+        for (const json &material : *materials) {
+          if (!material.is_object())
+            return false;
+          auto [materialIt, newMaterial] =
+              materialIndices.try_emplace(material.dump(), static_cast<uint32_t>(data.materials.size()));
+          if (newMaterial) {
+            SceneFile::MaterialRecord record;
+            for (int slot = 0; slot < 4; ++slot) {
+              std::string texture = getString(material, SLOT_NAMES[slot]);
+              record.textures[slot] = texture.empty() ? SceneFile::NO_STRING : data.addString(texture);
+            }
+            record.shininess = getFloat(material, "shininess", 16.0f);
+            data.materials.push_back(record);
+          }
+          data.modelMaterials.push_back(materialIt->second);
+        }
+      }
+      data.modelMaterialCounts.push_back(static_cast<uint32_t>(data.modelMaterials.size()) -
+                                         data.modelMaterialStarts.back());
+    }
+
+    auto occluder = object.find("occluder");
+    if (occluder != object.end() && occluder->is_boolean() && occluder->get<bool>())
+      data.occluders.push_back(entity);
+
+    if (const json *light = getObject(object, "light")) {
+      SceneFile::LightRecord record;
+      record.entity = entity;
+      std::string type = getString(*light, "type");
+      record.type = static_cast<uint32_t>(lightDefaults.type);
+      for (uint32_t t = 0; t < 3; ++t)
+        if (type == LIGHT_TYPE_NAMES[t])
+          record.type = t;
+      record.position = getVec3(*light, "position", lightDefaults.position);
+      record.direction = getVec3(*light, "direction", lightDefaults.direction);
+      record.color = getVec3(*light, "color", lightDefaults.color);
+      record.intensity = getFloat(*light, "intensity", lightDefaults.intensity);
+      record.ambient = getFloat(*light, "ambient", lightDefaults.ambient);
+      record.constant = getFloat(*light, "constant", lightDefaults.constant);
+      record.linear = getFloat(*light, "linear", lightDefaults.linear);
+      record.quadratic = getFloat(*light, "quadratic", lightDefaults.quadratic);
+      record.cutOff = getFloat(*light, "cutOff", lightDefaults.cutOff);
+      record.outerCutOff = getFloat(*light, "outerCutOff", lightDefaults.outerCutOff);
+      data.lights.push_back(record);
+    }
+
+    if (const json *camera = getObject(object, "camera")) {
+      SceneFile::CameraRecord record;
+      record.entity = entity;
+      auto active = camera->find("active");
+      record.active = active != camera->end() && active->is_boolean() && active->get<bool>();
+      record.position = getVec3(*camera, "position", cameraDefaults.position);
+      record.yaw = getFloat(*camera, "yaw", cameraDefaults.yaw);
+      record.pitch = getFloat(*camera, "pitch", cameraDefaults.pitch);
+      record.fov = getFloat(*camera, "fov", cameraDefaults.fov);
+      record.moveSpeed = getFloat(*camera, "moveSpeed", cameraDefaults.moveSpeed);
+      record.mouseSensitivity = getFloat(*camera, "mouseSensitivity", cameraDefaults.mouseSensitivity);
+      record.smoothFactor = getFloat(*camera, "smoothFactor", cameraDefaults.smoothFactor);
+      data.cameras.push_back(record);
+    }
+  }
+  return true;
+}
+} // namespace
+
+uint32_t SceneFile::Data::addString(const std::string &value) {
+  auto [it, inserted] = m_stringIndices.try_emplace(value, static_cast<uint32_t>(strings.size()));
+  if (inserted)
+    strings.push_back(value);
+  return it->second;
+}
+
+bool SceneFile::write(const std::string &path, const Data &data, Format format) {
+  PROFILE_ZONE("WriteScene");
+  if (!validate(data)) {
+    std::cerr << "[SceneFile] Inconsistent scene data, not writing " << path << std::endl;
+    return false;
+  }
+  return format == Format::Snapshot ? writeSnapshot(path, data) : writeJson(path, data);
+}
+
+bool SceneFile::read(const std::string &path, Data &data) {
+  PROFILE_ZONE("ReadScene");
+  MappedFile file;
+  if (!file.open(path)) {
+    std::cerr << "[SceneFile] Cannot open " << path << std::endl;
+    return false;
+  }
+
+  data = Data();
+  bool snapshot = file.getSize() >= sizeof(Header) && std::memcmp(file.getData(), MAGIC, sizeof(MAGIC)) == 0;
+  if (!(snapshot ? readSnapshot(file, data) : readJson(file, data)) || !validate(data)) {
+    std::cerr << "[SceneFile] Invalid scene file " << path << std::endl;
+    return false;
+  }
+  return true;
+}
+
+bool SceneFile::writeWorld(const std::string &path, const World &world) {
+  json cells = json::array();
+  for (const WorldCell &cell : world.cells)
+    cells.push_back({{"x", cell.x}, {"z", cell.z}, {"file", cell.file}, {"entities", cell.entityCount}});
+  json document = {{"version", FORMAT_VERSION}, {"cellSize", world.cellSize}, {"cells", std::move(cells)}};
+  std::string text = document.dump(2);
+  return FileUtils::writeFileAtomic(path, text.data(), text.size());
+}
+
+bool SceneFile::readWorld(const std::string &path, World &world) {
+  MappedFile file;
+  if (!file.open(path)) {
+    std::cerr << "[SceneFile] Cannot open " << path << std::endl;
+    return false;
+  }
+
+  const char *text = reinterpret_cast<const char *>(file.getData());
+  json document = json::parse(text, text + file.getSize(), nullptr, false);
+  world = World();
+  world.cellSize = document.is_object() ? getFloat(document, "cellSize", 0.0f) : 0.0f;
+  auto cells = document.is_object() ? document.find("cells") : document.end();
+  if (!(world.cellSize > 0.0f) || cells == document.end() || !cells->is_array()) {
+    std::cerr << "[SceneFile] Invalid world index " << path << std::endl;
+    return false;
+  }
+
+  for (const json &object : *cells) {
+    auto x = object.find("x"), z = object.find("z");
+    WorldCell cell;
+    cell.file = getString(object, "file");
+    if (x == object.end() || z == object.end() || !x->is_number_integer() || !z->is_number_integer() ||
+        cell.file.empty()) {
+      std::cerr << "[SceneFile] Invalid cell in world index " << path << std::endl;
+      return false;
+    }
+    cell.x = x->get<int32_t>();
+    cell.z = z->get<int32_t>();
+    auto entities = object.find("entities");
+    if (entities != object.end() && entities->is_number_unsigned())
+      cell.entityCount = entities->get<uint32_t>();
+    world.cells.push_back(std::move(cell));
+  }
+  return true;
+}
@@ -7,3 +7,5 @@ Entity EntityManager::createEntity() {
 }
 
 void EntityManager::destroyEntity(Entity entity) { m_activeEntities.erase(entity); }
+
+void EntityManager::clear() { m_activeEntities.clear(); }
@@ -0,0 +1,494 @@
+#include "rendering/backend/glBackend.h"
+#include <algorithm>
+#include <cstring>
+#include <glad/glad.h>
+#include <glm/gtc/type_ptr.hpp>
+
+// S3TC is an extension everywhere, glad does not carry its enums
+#ifndef GL_COMPRESSED_RGB_S3TC_DXT1_EXT
+#define GL_COMPRESSED_RGB_S3TC_DXT1_EXT 0x83F0
+#endif
+#ifndef GL_COMPRESSED_RGBA_S3TC_DXT5_EXT
+#define GL_COMPRESSED_RGBA_S3TC_DXT5_EXT 0x83F3
+#endif
+// KHR_parallel_shader_compile is not in the glad loader either
+#ifndef GL_COMPLETION_STATUS_KHR
+#define GL_MAX_SHADER_COMPILER_THREADS_KHR 0x91B0
+#define GL_COMPLETION_STATUS_KHR 0x91B1
+#endif
+
+namespace {
+GLenum toGLInternalFormat(TextureFormat format) {
+  switch (format) {
+  case TextureFormat::RGB8:
+    return GL_RGB;
+  case TextureFormat::RGBA8:
+    return GL_RGBA;
+  case TextureFormat::BC1:
+    return GL_COMPRESSED_RGB_S3TC_DXT1_EXT;
+  case TextureFormat::BC3:
+    return GL_COMPRESSED_RGBA_S3TC_DXT5_EXT;
+  case TextureFormat::BC5:
+    return GL_COMPRESSED_RG_RGTC2;
+  case TextureFormat::BC7:
+    return GL_COMPRESSED_RGBA_BPTC_UNORM;
+  }
+  return GL_RGBA;
+}
+
+GLenum toGLAttributeType(AttributeType type) {
+  switch (type) {
+  case AttributeType::Float:
+    return GL_FLOAT;
+  case AttributeType::HalfFloat:
+    return GL_HALF_FLOAT;
+  case AttributeType::UnsignedShort:
+    return GL_UNSIGNED_SHORT;
+  case AttributeType::Int2101010:
+    return GL_INT_2_10_10_10_REV;
+  }
+  return GL_FLOAT;
+}
+} // namespace
+
+GLBackend::GLBackend(SDL_Window *window) : m_window(window) {
+  GLint extensionCount = 0;
+  glGetIntegerv(GL_NUM_EXTENSIONS, &extensionCount);
+  for (GLint i = 0; i < extensionCount; ++i) {
+    const char *name = reinterpret_cast<const char *>(glGetStringi(GL_EXTENSIONS, i));
+    if (std::strcmp(name, "GL_EXT_texture_compression_s3tc") == 0)
+      m_supportsS3tc = true;
+    else if (std::strcmp(name, "GL_ARB_texture_compression_bptc") == 0)
+      m_supportsBptc = true;
+    else if (std::strcmp(name, "GL_KHR_parallel_shader_compile") == 0 ||
+             std::strcmp(name, "GL_ARB_parallel_shader_compile") == 0)
+      m_supportsParallelCompile = true;
+  }
+  m_supportsBptc = m_supportsBptc || GLAD_GL_VERSION_4_2;
+
+  GLint binaryFormats = 0;
+  if (glGetProgramBinary && glProgramBinary)
+    glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &binaryFormats);
+  m_supportsProgramBinary = binaryFormats > 0;
+
+  // Let the driver pick its compiler thread count (0xFFFFFFFF = implementation maximum)
+  if (m_supportsParallelCompile) {
+    using MaxShaderCompilerThreads = void(APIENTRYP)(GLuint count);
+    auto setThreads = reinterpret_cast<MaxShaderCompilerThreads>(SDL_GL_GetProcAddress("glMaxShaderCompilerThreadsKHR"));
+    if (!setThreads)
+      setThreads = reinterpret_cast<MaxShaderCompilerThreads>(SDL_GL_GetProcAddress("glMaxShaderCompilerThreadsARB"));
+    if (setThreads)
+      setThreads(0xFFFFFFFFu);
+  }
+}
+
+const char *GLBackend::getName() const { return "OpenGL"; }
+
+void GLBackend::clear() { glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT); }
+
+void GLBackend::present() {
+  // Fence the staging segment filled this frame and move on to the next one
+  StagingSegment &segment = m_staging[m_stagingSegment];
+  if (segment.used > 0 && !segment.fence) {
+    segment.fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    m_stagingSegment = (m_stagingSegment + 1) % m_staging.size();
+  }
+
+  SDL_GL_SwapWindow(m_window);
+}
+
+void GLBackend::setViewport(int x, int y, int width, int height) { glViewport(x, y, width, height); }
+
+void GLBackend::bindFramebuffer(uint32_t framebuffer) { glBindFramebuffer(GL_FRAMEBUFFER, framebuffer); }
+
+// Setup VAO/VBO/EBO with the given interleaved layout
+MeshBuffers GLBackend::createMeshBuffers(const void *vertices, size_t vertexBytes, size_t vertexStride,
+                                         const std::vector<VertexAttribute> &layout, const uint32_t *indices,
+                                         size_t indexCount) {
+  MeshBuffers buffers;
+
+  glGenVertexArrays(1, &buffers.vertexArray);
+  glBindVertexArray(buffers.vertexArray);
+
+  glGenBuffers(1, &buffers.vertexBuffer);
+  glBindBuffer(GL_ARRAY_BUFFER, buffers.vertexBuffer);
+  glBufferData(GL_ARRAY_BUFFER, vertexBytes, vertices, GL_STATIC_DRAW);
+
+  glGenBuffers(1, &buffers.indexBuffer);
+  glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, buffers.indexBuffer);
+  glBufferData(GL_ELEMENT_ARRAY_BUFFER, indexCount * sizeof(uint32_t), indices, GL_STATIC_DRAW);
+
+  for (const auto &attribute : layout) {
+    glVertexAttribPointer(attribute.location, attribute.components, toGLAttributeType(attribute.type),
+                          attribute.normalized ? GL_TRUE : GL_FALSE,
+                          static_cast<GLsizei>(attribute.stride ? attribute.stride : vertexStride),
+                          (void *)attribute.offset);
+    glEnableVertexAttribArray(attribute.location);
+  }
+
+  glBindVertexArray(0);
+  return buffers;
+}
+
+void GLBackend::destroyMeshBuffers(const MeshBuffers &buffers) {
+  glDeleteVertexArrays(1, &buffers.vertexArray);
+  glDeleteBuffers(1, &buffers.vertexBuffer);
+  glDeleteBuffers(1, &buffers.indexBuffer);
+}
+
+void GLBackend::drawIndexed(uint32_t vertexArray, uint32_t indexStart, uint32_t indexCount) {
+  glBindVertexArray(vertexArray);
+  glDrawElements(GL_TRIANGLES, static_cast<GLsizei>(indexCount), GL_UNSIGNED_INT,
+                 (void *)(indexStart * sizeof(uint32_t)));
+  glBindVertexArray(0);
+}
+
+bool GLBackend::supportsTextureFormat(TextureFormat format) const {
+  switch (format) {
+  case TextureFormat::BC1:
+  case TextureFormat::BC3:
+    return m_supportsS3tc;
+  case TextureFormat::BC7:
+    return m_supportsBptc;
+  default:
+    return true; // RGTC (BC5) is core since GL 3.0
+  }
+}
+
+uint32_t GLBackend::createTexture2D(int width, int height, TextureFormat format, const void *pixels,
+                                    bool generateMipmaps) {
+  GLuint textureID;
+  glGenTextures(1, &textureID);
+  updateTexture2D(textureID, width, height, format, pixels, generateMipmaps);
+  return textureID;
+}
+
+// Respecify storage and sampling of an existing texture name
+void GLBackend::updateTexture2D(uint32_t texture, int width, int height, TextureFormat format, const void *pixels,
+                                bool generateMipmaps) {
+  glBindTexture(GL_TEXTURE_2D, texture);
+
+  GLenum glFormat = (format == TextureFormat::RGBA8 ? GL_RGBA : GL_RGB);
+  glTexImage2D(GL_TEXTURE_2D, 0, glFormat, width, height, 0, glFormat, GL_UNSIGNED_BYTE, pixels);
+  if (generateMipmaps)
+    glGenerateMipmap(GL_TEXTURE_2D);
+
+  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
+  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
+  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, generateMipmaps ? GL_LINEAR_MIPMAP_LINEAR : GL_LINEAR);
+  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+}
+
+void GLBackend::deleteTexture(uint32_t texture) { glDeleteTextures(1, &texture); }
+
+void GLBackend::allocateTexture2D(uint32_t texture, int width, int height, TextureFormat format, int levelCount) {
+  glBindTexture(GL_TEXTURE_2D, texture);
+
+  GLenum glFormat = toGLInternalFormat(format);
+  for (int level = 0; level < levelCount; ++level) {
+    int levelWidth = std::max(1, width >> level);
+    int levelHeight = std::max(1, height >> level);
+    if (isCompressedFormat(format)) {
+      GLsizei bytes = static_cast<GLsizei>(getTextureLevelBytes(format, levelWidth, levelHeight));
+      glCompressedTexImage2D(GL_TEXTURE_2D, level, glFormat, levelWidth, levelHeight, 0, bytes, nullptr);
+    } else {
+      glTexImage2D(GL_TEXTURE_2D, level, glFormat, levelWidth, levelHeight, 0, glFormat, GL_UNSIGNED_BYTE, nullptr);
+    }
+  }
+
+  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_BASE_LEVEL, levelCount - 1);
+  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, levelCount - 1);
+  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
+  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
+  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+}
+
+void GLBackend::createStagingRing() {
+  const GLsizeiptr size = static_cast<GLsizeiptr>(EngineConfig::TEXTURE_STAGING_SEGMENT_BYTES) * m_staging.size();
+  glGenBuffers(1, &m_stagingBuffer);
+  glBindBuffer(GL_PIXEL_UNPACK_BUFFER, m_stagingBuffer);
+
+  if (GLAD_GL_VERSION_4_4) {
+    const GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+    glBufferStorage(GL_PIXEL_UNPACK_BUFFER, size, nullptr, flags);
+    m_stagingData = static_cast<unsigned char *>(glMapBufferRange(GL_PIXEL_UNPACK_BUFFER, 0, size, flags));
+  } else {
+    glBufferData(GL_PIXEL_UNPACK_BUFFER, size, nullptr, GL_STREAM_DRAW);
+  }
+
+  glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+}
+
+// Free bytes in this frame's segment; 0 while the GPU may still read it (never waits)
+size_t GLBackend::getTextureStagingSpace() {
+  if (m_stagingBuffer == 0)
+    createStagingRing();
+
+  StagingSegment &segment = m_staging[m_stagingSegment];
+  if (segment.fence) {
+    GLsync fence = static_cast<GLsync>(segment.fence);
+    if (glClientWaitSync(fence, 0, 0) == GL_TIMEOUT_EXPIRED)
+      return 0;
+    glDeleteSync(fence);
+    segment.fence = nullptr;
+    segment.used = 0;
+  }
+  return EngineConfig::TEXTURE_STAGING_SEGMENT_BYTES - segment.used;
+}
+
+bool GLBackend::uploadTextureRows(uint32_t texture, int level, int y, int width, int rows, TextureFormat format,
+                                  const void *pixels) {
+  const size_t bytes = getTextureLevelBytes(format, width, rows);
+  if (getTextureStagingSpace() < bytes)
+    return false;
+
+  StagingSegment &segment = m_staging[m_stagingSegment];
+  const size_t segmentBytes = EngineConfig::TEXTURE_STAGING_SEGMENT_BYTES;
+  const size_t offset = m_stagingSegment * segmentBytes + segment.used;
+  segment.used = std::min((segment.used + bytes + 15) & ~size_t(15), segmentBytes); // keep copies 16-byte aligned
+
+  glBindBuffer(GL_PIXEL_UNPACK_BUFFER, m_stagingBuffer);
+  if (m_stagingData)
+    std::memcpy(m_stagingData + offset, pixels, bytes);
+  else
+    glBufferSubData(GL_PIXEL_UNPACK_BUFFER, static_cast<GLintptr>(offset), static_cast<GLsizeiptr>(bytes), pixels);
+
+  // The source pointer is an offset into the bound unpack buffer
+  glBindTexture(GL_TEXTURE_2D, texture);
+  uploadRows(level, y, width, rows, format, reinterpret_cast<const void *>(offset));
+  glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+  return true;
+}
+
+void GLBackend::uploadTextureLevel(uint32_t texture, int level, int width, int height, TextureFormat format,
+                                   const void *pixels) {
+  glBindTexture(GL_TEXTURE_2D, texture);
+  uploadRows(level, 0, width, height, format, pixels);
+}
+
+// Sub-image upload of the bound texture; rows are tightly packed
+void GLBackend::uploadRows(int level, int y, int width, int rows, TextureFormat format, const void *pixels) {
+  GLenum glFormat = toGLInternalFormat(format);
+  if (isCompressedFormat(format)) {
+    GLsizei bytes = static_cast<GLsizei>(getTextureLevelBytes(format, width, rows));
+    glCompressedTexSubImage2D(GL_TEXTURE_2D, level, 0, y, width, rows, glFormat, bytes, pixels);
+    return;
+  }
+
+  glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+  glTexSubImage2D(GL_TEXTURE_2D, level, 0, y, width, rows, glFormat, GL_UNSIGNED_BYTE, pixels);
+  glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+}
+
+void GLBackend::setTextureBaseLevel(uint32_t texture, int level) {
+  glBindTexture(GL_TEXTURE_2D, texture);
+  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_BASE_LEVEL, level);
+}
+
+void GLBackend::bindTexture(int unit, uint32_t texture) {
+  glActiveTexture(GL_TEXTURE0 + unit);
+  glBindTexture(GL_TEXTURE_2D, texture);
+}
+
+// Depth texture + FBO for shadow mapping
+void GLBackend::createDepthTarget(int width, int height, uint32_t &framebuffer, uint32_t &depthTexture) {
+  glGenFramebuffers(1, &framebuffer);
+  glGenTextures(1, &depthTexture);
+
+  glBindTexture(GL_TEXTURE_2D, depthTexture);
+  glTexImage2D(GL_TEXTURE_2D, 0, GL_DEPTH_COMPONENT, width, height, 0, GL_DEPTH_COMPONENT, GL_FLOAT, nullptr);
+
+  // Linear filtering for PCF
+  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+
+  // Clamp to border (white = no shadow outside frustum)
+  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_BORDER);
+  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_BORDER);
+  float borderColor[] = {1.0f, 1.0f, 1.0f, 1.0f};
+  glTexParameterfv(GL_TEXTURE_2D, GL_TEXTURE_BORDER_COLOR, borderColor);
+
+  // Attach depth texture to FBO
+  glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+  glFramebufferTexture2D(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_TEXTURE_2D, depthTexture, 0);
+  glDrawBuffer(GL_NONE);
+  glReadBuffer(GL_NONE);
+  glBindFramebuffer(GL_FRAMEBUFFER, 0);
+}
+
+// Start compiling a shader stage (vertex/fragment); the status is read when the program is finished
+uint32_t GLBackend::compileStage(unsigned int type, const std::string &source) {
+  const char *sourceCStr = source.c_str();
+  GLuint shader = glCreateShader(type);
+  glShaderSource(shader, 1, &sourceCStr, nullptr);
+  glCompileShader(shader);
+  return shader;
+}
+
+// Compile + link vertex and fragment into a program, waiting for the result
+uint32_t GLBackend::createProgram(const std::string &vertexSource, const std::string &fragmentSource,
+                                  std::string &errorLog) {
+  uint32_t programID = compileProgram(vertexSource, fragmentSource);
+  return finishProgram(programID, errorLog) ? programID : 0;
+}
+
+// Issue compile and link without querying any status, so the driver can build in the background
+uint32_t GLBackend::compileProgram(const std::string &vertexSource, const std::string &fragmentSource) {
+  GLuint vertexShader = compileStage(GL_VERTEX_SHADER, vertexSource);
+  GLuint fragmentShader = compileStage(GL_FRAGMENT_SHADER, fragmentSource);
+
+  GLuint programID = glCreateProgram();
+  glAttachShader(programID, vertexShader);
+  glAttachShader(programID, fragmentShader);
+  if (m_supportsProgramBinary)
+    glProgramParameteri(programID, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+  glLinkProgram(programID);
+
+  m_pendingPrograms[programID] = {vertexShader, fragmentShader};
+  return programID;
+}
+
+// Without KHR_parallel_shader_compile the result is only known by waiting for it
+bool GLBackend::isProgramReady(uint32_t program) {
+  if (!m_supportsParallelCompile)
+    return true;
+  GLint done = GL_FALSE;
+  glGetProgramiv(program, GL_COMPLETION_STATUS_KHR, &done);
+  return done == GL_TRUE;
+}
+
+bool GLBackend::finishProgram(uint32_t program, std::string &errorLog) {
+  auto pending = m_pendingPrograms.find(program);
+  if (pending == m_pendingPrograms.end())
+    return program != 0;
+  const GLuint stages[2] = {pending->second.vertexShader, pending->second.fragmentShader};
+  m_pendingPrograms.erase(pending);
+
+  GLint success;
+  glGetProgramiv(program, GL_LINK_STATUS, &success);
+  if (!success) {
+    // Report the first stage that failed, or the link itself
+    for (GLuint stage : stages) {
+      GLint compiled;
+      glGetShaderiv(stage, GL_COMPILE_STATUS, &compiled);
+      if (compiled)
+        continue;
+      GLint logLength;
+      glGetShaderiv(stage, GL_INFO_LOG_LENGTH, &logLength);
+      std::vector<char> log(logLength + 1);
+      glGetShaderInfoLog(stage, logLength, nullptr, log.data());
+      errorLog = (stage == stages[0] ? "vertex: " : "fragment: ") + std::string(log.data());
+      break;
+    }
+    if (errorLog.empty()) {
+      GLint logLength;
+      glGetProgramiv(program, GL_INFO_LOG_LENGTH, &logLength);
+      std::vector<char> log(logLength + 1);
+      glGetProgramInfoLog(program, logLength, nullptr, log.data());
+      errorLog = "link: " + std::string(log.data());
+    }
+  }
+
+  for (GLuint stage : stages)
+    glDeleteShader(stage);
+  if (!success)
+    glDeleteProgram(program);
+  return success == GL_TRUE;
+}
+
+void GLBackend::deleteProgram(uint32_t program) {
+  auto pending = m_pendingPrograms.find(program);
+  if (pending != m_pendingPrograms.end()) {
+    glDeleteShader(pending->second.vertexShader);
+    glDeleteShader(pending->second.fragmentShader);
+    m_pendingPrograms.erase(pending);
+  }
+  glDeleteProgram(program);
+}
+
+void GLBackend::useProgram(uint32_t program) { glUseProgram(program); }
+
+int GLBackend::getUniformLocation(uint32_t program, const char *name) { return glGetUniformLocation(program, name); }
+
+// Binaries are only valid for the exact driver build that produced them
+std::string GLBackend::getProgramBinaryDriver() const {
+  if (!m_supportsProgramBinary)
+    return "";
+  auto get = [](GLenum name) {
+    const char *value = reinterpret_cast<const char *>(glGetString(name));
+    return std::string(value ? value : "");
+  };
+  return get(GL_VENDOR) + "|" + get(GL_RENDERER) + "|" + get(GL_VERSION);
+}
+
+bool GLBackend::getProgramBinary(uint32_t program, uint32_t &format, std::vector<uint8_t> &binary) {
+  if (!m_supportsProgramBinary)
+    return false;
+
+  GLint length = 0;
+  glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &length);
+  if (length <= 0)
+    return false;
+
+  binary.resize(length);
+  GLenum binaryFormat = 0;
+  glGetProgramBinary(program, length, nullptr, &binaryFormat, binary.data());
+  format = binaryFormat;
+  return true;
+}
+
+uint32_t GLBackend::createProgramFromBinary(uint32_t format, const void *binary, size_t size) {
+  if (!m_supportsProgramBinary)
+    return 0;
+
+  GLuint programID = glCreateProgram();
+  glProgramBinary(programID, format, binary, static_cast<GLsizei>(size));
+
+  // Another driver version or an unknown format fails like a link error
+  GLint success = GL_FALSE;
+  glGetProgramiv(programID, GL_LINK_STATUS, &success);
+  if (!success) {
+    while (glGetError() != GL_NO_ERROR) {
+    }
+    glDeleteProgram(programID);
+    return 0;
+  }
+  return programID;
+}
+
+void GLBackend::setUniform(int location, int value) { glUniform1i(location, value); }
+
+void GLBackend::setUniform(int location, float value) { glUniform1f(location, value); }
+
+void GLBackend::setUniform(int location, const glm::vec3 &value) { glUniform3fv(location, 1, glm::value_ptr(value)); }
+
+void GLBackend::setUniform(int location, const glm::mat3 &value) {
+  glUniformMatrix3fv(location, 1, GL_FALSE, glm::value_ptr(value));
+}
+
+void GLBackend::setUniform(int location, const glm::mat4 &value) {
+  glUniformMatrix4fv(location, 1, GL_FALSE, glm::value_ptr(value));
+}
+
+uint32_t GLBackend::createTimestampQuery() {
+  GLuint query;
+  glGenQueries(1, &query);
+  return query;
+}
+
+void GLBackend::deleteQuery(uint32_t query) { glDeleteQueries(1, &query); }
+
+void GLBackend::writeTimestamp(uint32_t query) { glQueryCounter(query, GL_TIMESTAMP); }
+
+bool GLBackend::readTimestamp(uint32_t query, uint64_t &timestamp) {
+  GLint available = 0;
+  glGetQueryObjectiv(query, GL_QUERY_RESULT_AVAILABLE, &available);
+  if (!available)
+    return false;
+
+  GLuint64 result = 0;
+  glGetQueryObjectui64v(query, GL_QUERY_RESULT, &result);
+  timestamp = result;
+  return true;
+}
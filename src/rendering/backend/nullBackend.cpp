@@ -0,0 +1,205 @@
+#include "rendering/backend/nullBackend.h"
+#include "foundation/core/config.h"
+#include <algorithm>
+#include <chrono>
+
+void NullBackend::count(uint64_t BackendCounters::*counter, uint64_t amount) {
+  m_current.*counter += amount;
+  m_total.*counter += amount;
+}
+
+const char *NullBackend::getName() const { return "Null"; }
+
+void NullBackend::clear() {}
+
+// End of frame: publish the frame counters
+void NullBackend::present() {
+  m_lastFrame = m_current;
+  m_current = BackendCounters{};
+  m_frameCount++;
+  m_stagingUsed = 0;
+}
+
+void NullBackend::setViewport(int, int, int, int) { count(&BackendCounters::viewportChanges); }
+
+void NullBackend::bindFramebuffer(uint32_t) { count(&BackendCounters::framebufferBinds); }
+
+MeshBuffers NullBackend::createMeshBuffers(const void *, size_t vertexBytes, size_t,
+                                           const std::vector<VertexAttribute> &, const uint32_t *,
+                                           size_t indexCount) {
+  MeshBuffers buffers;
+  buffers.vertexArray = m_nextObject++;
+  buffers.vertexBuffer = m_nextObject++;
+  buffers.indexBuffer = m_nextObject++;
+
+  m_bufferBytes[buffers.vertexBuffer] = vertexBytes;
+  m_bufferBytes[buffers.indexBuffer] = indexCount * sizeof(uint32_t);
+  count(&BackendCounters::bufferBytesUploaded, vertexBytes + indexCount * sizeof(uint32_t));
+  return buffers;
+}
+
+void NullBackend::destroyMeshBuffers(const MeshBuffers &buffers) {
+  m_bufferBytes.erase(buffers.vertexBuffer);
+  m_bufferBytes.erase(buffers.indexBuffer);
+}
+
+void NullBackend::drawIndexed(uint32_t, uint32_t, uint32_t indexCount) {
+  count(&BackendCounters::drawCalls);
+  count(&BackendCounters::indices, indexCount);
+}
+
+bool NullBackend::supportsTextureFormat(TextureFormat) const { return true; }
+
+uint32_t NullBackend::createTexture2D(int width, int height, TextureFormat format, const void *pixels,
+                                     bool generateMipmaps) {
+  uint32_t texture = m_nextObject++;
+  updateTexture2D(texture, width, height, format, pixels, generateMipmaps);
+  return texture;
+}
+
+void NullBackend::updateTexture2D(uint32_t texture, int width, int height, TextureFormat format, const void *,
+                                  bool generateMipmaps) {
+  size_t bytes = static_cast<size_t>(width) * height * (format == TextureFormat::RGBA8 ? 4 : 3);
+  m_textureBytes[texture] = generateMipmaps ? bytes * 4 / 3 : bytes;
+  count(&BackendCounters::textureBytesUploaded, bytes);
+}
+
+void NullBackend::deleteTexture(uint32_t texture) { m_textureBytes.erase(texture); }
+
+void NullBackend::allocateTexture2D(uint32_t texture, int width, int height, TextureFormat format, int levelCount) {
+  size_t bytes = 0;
+  for (int level = 0; level < levelCount; ++level)
+    bytes += getTextureLevelBytes(format, std::max(1, width >> level), std::max(1, height >> level));
+  m_textureBytes[texture] = bytes;
+}
+
+size_t NullBackend::getTextureStagingSpace() { return EngineConfig::TEXTURE_STAGING_SEGMENT_BYTES - m_stagingUsed; }
+
+bool NullBackend::uploadTextureRows(uint32_t, int, int, int width, int rows, TextureFormat format, const void *) {
+  size_t bytes = getTextureLevelBytes(format, width, rows);
+  if (getTextureStagingSpace() < bytes)
+    return false;
+  m_stagingUsed += bytes;
+  count(&BackendCounters::textureBytesUploaded, bytes);
+  return true;
+}
+
+void NullBackend::setTextureBaseLevel(uint32_t, int) {}
+
+void NullBackend::uploadTextureLevel(uint32_t, int, int width, int height, TextureFormat format, const void *) {
+  count(&BackendCounters::textureBytesUploaded, getTextureLevelBytes(format, width, height));
+}
+
+void NullBackend::bindTexture(int, uint32_t) { count(&BackendCounters::textureBinds); }
+
+void NullBackend::createDepthTarget(int width, int height, uint32_t &framebuffer, uint32_t &depthTexture) {
+  framebuffer = m_nextObject++;
+  depthTexture = m_nextObject++;
+  m_textureBytes[depthTexture] = static_cast<size_t>(width) * height * sizeof(float);
+}
+
+// Any non-empty source "compiles"
+uint32_t NullBackend::createProgram(const std::string &vertexSource, const std::string &fragmentSource,
+                                    std::string &errorLog) {
+  if (vertexSource.empty() || fragmentSource.empty()) {
+    errorLog = "empty shader source";
+    return 0;
+  }
+  return m_nextObject++;
+}
+
+// Builds complete at once; a failed one is reported by finishProgram
+uint32_t NullBackend::compileProgram(const std::string &vertexSource, const std::string &fragmentSource) {
+  std::string errorLog;
+  uint32_t program = createProgram(vertexSource, fragmentSource, errorLog);
+  if (program == 0) {
+    program = m_nextObject++;
+    m_failedPrograms.insert(program);
+  }
+  return program;
+}
+
+bool NullBackend::isProgramReady(uint32_t) { return true; }
+
+bool NullBackend::finishProgram(uint32_t program, std::string &errorLog) {
+  if (m_failedPrograms.erase(program) == 0)
+    return true;
+  errorLog = "empty shader source";
+  return false;
+}
+
+void NullBackend::deleteProgram(uint32_t program) {
+  m_uniforms.erase(program);
+  m_failedPrograms.erase(program);
+}
+
+void NullBackend::useProgram(uint32_t) { count(&BackendCounters::programBinds); }
+
+// Stable fake locations per (program, name)
+int NullBackend::getUniformLocation(uint32_t program, const char *name) {
+  auto &locations = m_uniforms[program];
+  auto it = locations.find(name);
+  if (it != locations.end())
+    return it->second;
+  int location = static_cast<int>(locations.size());
+  locations.emplace(name, location);
+  return location;
+}
+
+// No driver, no binaries: the program cache stays off
+std::string NullBackend::getProgramBinaryDriver() const { return ""; }
+
+bool NullBackend::getProgramBinary(uint32_t, uint32_t &, std::vector<uint8_t> &) { return false; }
+
+uint32_t NullBackend::createProgramFromBinary(uint32_t, const void *, size_t) { return 0; }
+
+void NullBackend::setUniform(int, int) { count(&BackendCounters::uniformUploads); }
+
+void NullBackend::setUniform(int, float) { count(&BackendCounters::uniformUploads); }
+
+void NullBackend::setUniform(int, const glm::vec3 &) { count(&BackendCounters::uniformUploads); }
+
+void NullBackend::setUniform(int, const glm::mat3 &) { count(&BackendCounters::uniformUploads); }
+
+void NullBackend::setUniform(int, const glm::mat4 &) { count(&BackendCounters::uniformUploads); }
+
+uint32_t NullBackend::createTimestampQuery() {
+  uint32_t query = m_nextObject++;
+  m_timestamps[query] = 0;
+  return query;
+}
+
+void NullBackend::deleteQuery(uint32_t query) { m_timestamps.erase(query); }
+
+void NullBackend::writeTimestamp(uint32_t query) {
+  auto now = std::chrono::steady_clock::now().time_since_epoch();
+  m_timestamps[query] = std::chrono::duration_cast<std::chrono::nanoseconds>(now).count();
+}
+
+bool NullBackend::readTimestamp(uint32_t query, uint64_t &timestamp) {
+  auto it = m_timestamps.find(query);
+  if (it == m_timestamps.end())
+    return false;
+  timestamp = it->second;
+  return true;
+}
+
+const BackendCounters &NullBackend::getFrameCounters() const { return m_lastFrame; }
+
+const BackendCounters &NullBackend::getTotalCounters() const { return m_total; }
+
+uint32_t NullBackend::getFrameCount() const { return m_frameCount; }
+
+size_t NullBackend::getResidentBufferBytes() const {
+  size_t total = 0;
+  for (const auto &[buffer, bytes] : m_bufferBytes)
+    total += bytes;
+  return total;
+}
+
+size_t NullBackend::getResidentTextureBytes() const {
+  size_t total = 0;
+  for (const auto &[texture, bytes] : m_textureBytes)
+    total += bytes;
+  return total;
+}
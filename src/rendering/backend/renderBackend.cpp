@@ -0,0 +1,12 @@
+#include "rendering/backend/renderBackend.h"
+#include <stdexcept>
+
+static std::unique_ptr<RenderBackend> s_backend;
+
+RenderBackend &RenderBackend::get() {
+  if (!s_backend)
+    throw std::runtime_error("No render backend set");
+  return *s_backend;
+}
+
+void RenderBackend::set(std::unique_ptr<RenderBackend> backend) { s_backend = std::move(backend); }
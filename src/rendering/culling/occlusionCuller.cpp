@@ -0,0 +1,268 @@
+#include "rendering/culling/occlusionCuller.h"
+#include "systems/jobSystem.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define OCCLUSION_USE_SSE 1
+#endif
+
+namespace {
+constexpr float kMinClipW = 1e-4f;
+}
+
+OcclusionCuller::OcclusionCuller(int width, int height)
+    : m_width((std::max(width, 4) + 3) & ~3), m_height(std::max(height, 1)) {
+  m_tilesX = (m_width + EngineConfig::OCCLUSION_TILE_WIDTH - 1) / EngineConfig::OCCLUSION_TILE_WIDTH;
+  m_tilesY = (m_height + EngineConfig::OCCLUSION_TILE_HEIGHT - 1) / EngineConfig::OCCLUSION_TILE_HEIGHT;
+  m_tileBins.resize(m_tilesX * m_tilesY);
+
+  // Allocate the whole pyramid once
+  glm::ivec2 size(m_width, m_height);
+  for (;;) {
+    m_levelSizes.push_back(size);
+    m_pyramid.emplace_back(static_cast<size_t>(size.x) * size.y, 1.0f);
+    if (size.x == 1 && size.y == 1)
+      break;
+    size = glm::max((size + 1) / 2, glm::ivec2(1));
+  }
+}
+
+void OcclusionCuller::beginFrame(const glm::mat4 &viewProjection) {
+  m_viewProjection = viewProjection;
+  m_triangles.clear();
+  std::fill(m_pyramid[0].begin(), m_pyramid[0].end(), 1.0f);
+}
+
+// Triangle setup: project to the depth buffer, drop back faces and near-clipped triangles
+void OcclusionCuller::addOccluder(const glm::vec3 *positions, size_t positionStride, const uint32_t *indices,
+                                  size_t indexCount, const glm::mat4 &model) {
+  glm::mat4 mvp = m_viewProjection * model;
+  const auto *positionBytes = reinterpret_cast<const unsigned char *>(positions);
+
+  for (size_t i = 0; i + 2 < indexCount; i += 3) {
+    glm::vec2 screen[3];
+    float depth[3];
+    bool clipped = false;
+
+    for (int k = 0; k < 3; ++k) {
+      const auto &position = *reinterpret_cast<const glm::vec3 *>(positionBytes + indices[i + k] * positionStride);
+      glm::vec4 clip = mvp * glm::vec4(position, 1.0f);
+      if (clip.w < kMinClipW || clip.z < -clip.w) {
+        clipped = true;
+        break;
+      }
+      float invW = 1.0f / clip.w;
+      screen[k] = {(clip.x * invW * 0.5f + 0.5f) * m_width, (clip.y * invW * 0.5f + 0.5f) * m_height};
+      depth[k] = clip.z * invW * 0.5f + 0.5f;
+    }
+    if (clipped || (depth[0] > 1.0f && depth[1] > 1.0f && depth[2] > 1.0f))
+      continue;
+
+    float area = (screen[1].x - screen[0].x) * (screen[2].y - screen[0].y) -
+                 (screen[2].x - screen[0].x) * (screen[1].y - screen[0].y);
+    if (area <= 0.0f)
+      continue;
+
+    ScreenTriangle tri;
+    tri.minX = std::max(0, static_cast<int>(std::floor(std::min({screen[0].x, screen[1].x, screen[2].x}))));
+    tri.minY = std::max(0, static_cast<int>(std::floor(std::min({screen[0].y, screen[1].y, screen[2].y}))));
+    tri.maxX = std::min(m_width - 1, static_cast<int>(std::ceil(std::max({screen[0].x, screen[1].x, screen[2].x}))));
+    tri.maxY = std::min(m_height - 1, static_cast<int>(std::ceil(std::max({screen[0].y, screen[1].y, screen[2].y}))));
+    if (tri.minX > tri.maxX || tri.minY > tri.maxY)
+      continue;
+
+    // Edge k goes from vertex k to k+1 and is positive inside (counter-clockwise)
+    for (int k = 0; k < 3; ++k) {
+      const glm::vec2 &a = screen[k];
+      const glm::vec2 &b = screen[(k + 1) % 3];
+      tri.edgeA[k] = a.y - b.y;
+      tri.edgeB[k] = b.x - a.x;
+      tri.edgeC[k] = a.x * b.y - a.y * b.x;
+    }
+
+    // z/w is linear in screen space: z = sum(edge opposite vertex * vertex depth) / area
+    float invArea = 1.0f / area;
+    tri.depthA = (tri.edgeA[1] * depth[0] + tri.edgeA[2] * depth[1] + tri.edgeA[0] * depth[2]) * invArea;
+    tri.depthB = (tri.edgeB[1] * depth[0] + tri.edgeB[2] * depth[1] + tri.edgeB[0] * depth[2]) * invArea;
+    tri.depthC = (tri.edgeC[1] * depth[0] + tri.edgeC[2] * depth[1] + tri.edgeC[0] * depth[2]) * invArea;
+
+    m_triangles.push_back(tri);
+  }
+}
+
+void OcclusionCuller::rasterize(JobSystem *jobs) {
+  // Bin triangles to every tile their bounds overlap
+  for (auto &bin : m_tileBins)
+    bin.clear();
+
+  for (uint32_t i = 0; i < m_triangles.size(); ++i) {
+    const ScreenTriangle &tri = m_triangles[i];
+    int tileX0 = tri.minX / EngineConfig::OCCLUSION_TILE_WIDTH;
+    int tileX1 = tri.maxX / EngineConfig::OCCLUSION_TILE_WIDTH;
+    int tileY0 = tri.minY / EngineConfig::OCCLUSION_TILE_HEIGHT;
+    int tileY1 = tri.maxY / EngineConfig::OCCLUSION_TILE_HEIGHT;
+    for (int ty = tileY0; ty <= tileY1; ++ty)
+      for (int tx = tileX0; tx <= tileX1; ++tx)
+        m_tileBins[ty * m_tilesX + tx].push_back(i);
+  }
+
+  uint32_t tileCount = static_cast<uint32_t>(m_tileBins.size());
+  if (jobs) {
+    jobs->parallelFor(tileCount, 1, [this](uint32_t begin, uint32_t end) {
+      for (uint32_t tile = begin; tile < end; ++tile)
+        rasterizeTile(static_cast<int>(tile));
+    });
+  } else {
+    for (uint32_t tile = 0; tile < tileCount; ++tile)
+      rasterizeTile(static_cast<int>(tile));
+  }
+
+  buildPyramid();
+}
+
+// Rasterize binned triangles into one tile, keeping the nearest depth (4 pixels per step)
+void OcclusionCuller::rasterizeTile(int tile) {
+  const auto &bin = m_tileBins[tile];
+  if (bin.empty())
+    return;
+
+  int tileX0 = (tile % m_tilesX) * EngineConfig::OCCLUSION_TILE_WIDTH;
+  int tileY0 = (tile / m_tilesX) * EngineConfig::OCCLUSION_TILE_HEIGHT;
+  int tileX1 = std::min(tileX0 + EngineConfig::OCCLUSION_TILE_WIDTH, m_width) - 1;
+  int tileY1 = std::min(tileY0 + EngineConfig::OCCLUSION_TILE_HEIGHT, m_height) - 1;
+  float *depthBuffer = m_pyramid[0].data();
+
+  for (uint32_t index : bin) {
+    const ScreenTriangle &tri = m_triangles[index];
+
+    // Tile and buffer widths are multiples of 4, so aligned spans never leave the tile
+    int minX = std::max(tri.minX, tileX0) & ~3;
+    int maxX = std::min(tri.maxX, tileX1);
+    int minY = std::max(tri.minY, tileY0);
+    int maxY = std::min(tri.maxY, tileY1);
+
+    for (int y = minY; y <= maxY; ++y) {
+      float py = y + 0.5f;
+      float row[3];
+      for (int k = 0; k < 3; ++k)
+        row[k] = tri.edgeB[k] * py + tri.edgeC[k];
+      float depthRow = tri.depthB * py + tri.depthC;
+      float *line = depthBuffer + static_cast<size_t>(y) * m_width;
+
+#ifdef OCCLUSION_USE_SSE
+      const __m128 laneOffsets = _mm_setr_ps(0.5f, 1.5f, 2.5f, 3.5f);
+      const __m128 zero = _mm_setzero_ps();
+      for (int x = minX; x <= maxX; x += 4) {
+        __m128 px = _mm_add_ps(_mm_set1_ps(static_cast<float>(x)), laneOffsets);
+        __m128 e0 = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(tri.edgeA[0]), px), _mm_set1_ps(row[0]));
+        __m128 e1 = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(tri.edgeA[1]), px), _mm_set1_ps(row[1]));
+        __m128 e2 = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(tri.edgeA[2]), px), _mm_set1_ps(row[2]));
+        __m128 inside = _mm_and_ps(_mm_and_ps(_mm_cmpge_ps(e0, zero), _mm_cmpge_ps(e1, zero)), _mm_cmpge_ps(e2, zero));
+        if (_mm_movemask_ps(inside) == 0)
+          continue;
+
+        __m128 z = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(tri.depthA), px), _mm_set1_ps(depthRow));
+        __m128 current = _mm_loadu_ps(line + x);
+        __m128 nearest = _mm_min_ps(current, z);
+        _mm_storeu_ps(line + x, _mm_or_ps(_mm_and_ps(inside, nearest), _mm_andnot_ps(inside, current)));
+      }
+#else
+      for (int x = minX; x <= maxX; ++x) {
+        float px = x + 0.5f;
+        if (tri.edgeA[0] * px + row[0] < 0.0f || tri.edgeA[1] * px + row[1] < 0.0f ||
+            tri.edgeA[2] * px + row[2] < 0.0f)
+          continue;
+        float z = tri.depthA * px + depthRow;
+        line[x] = std::min(line[x], z);
+      }
+#endif
+    }
+  }
+}
+
+// Each pyramid texel stores the farthest occluder depth of the texels below it
+void OcclusionCuller::buildPyramid() {
+  for (size_t level = 1; level < m_pyramid.size(); ++level) {
+    const auto &src = m_pyramid[level - 1];
+    auto &dst = m_pyramid[level];
+    glm::ivec2 srcSize = m_levelSizes[level - 1];
+    glm::ivec2 dstSize = m_levelSizes[level];
+
+    for (int y = 0; y < dstSize.y; ++y) {
+      int sy0 = std::min(y * 2, srcSize.y - 1);
+      int sy1 = std::min(y * 2 + 1, srcSize.y - 1);
+      for (int x = 0; x < dstSize.x; ++x) {
+        int sx0 = std::min(x * 2, srcSize.x - 1);
+        int sx1 = std::min(x * 2 + 1, srcSize.x - 1);
+        dst[y * dstSize.x + x] = std::max(std::max(src[sy0 * srcSize.x + sx0], src[sy0 * srcSize.x + sx1]),
+                                          std::max(src[sy1 * srcSize.x + sx0], src[sy1 * srcSize.x + sx1]));
+      }
+    }
+  }
+}
+
+bool OcclusionCuller::isVisible(const glm::vec3 &boundsMin, const glm::vec3 &boundsMax, const glm::mat4 &model) const {
+  glm::mat4 mvp = m_viewProjection * model;
+
+  glm::vec2 ndcMin(std::numeric_limits<float>::max());
+  glm::vec2 ndcMax(std::numeric_limits<float>::lowest());
+  float nearestDepth = std::numeric_limits<float>::max();
+
+  for (int corner = 0; corner < 8; ++corner) {
+    glm::vec3 local((corner & 1) ? boundsMax.x : boundsMin.x, (corner & 2) ? boundsMax.y : boundsMin.y,
+                    (corner & 4) ? boundsMax.z : boundsMin.z);
+    glm::vec4 clip = mvp * glm::vec4(local, 1.0f);
+
+    // Crossing the near plane: cannot bound it on screen, treat as visible
+    if (clip.w < kMinClipW)
+      return true;
+
+    glm::vec3 ndc = glm::vec3(clip) / clip.w;
+    ndcMin = glm::min(ndcMin, glm::vec2(ndc));
+    ndcMax = glm::max(ndcMax, glm::vec2(ndc));
+    nearestDepth = std::min(nearestDepth, ndc.z * 0.5f + 0.5f);
+  }
+
+  // Outside the view
+  if (ndcMax.x < -1.0f || ndcMin.x > 1.0f || ndcMax.y < -1.0f || ndcMin.y > 1.0f || nearestDepth > 1.0f)
+    return false;
+
+  if (m_triangles.empty())
+    return true;
+
+  int x0 = std::clamp(static_cast<int>((ndcMin.x * 0.5f + 0.5f) * m_width), 0, m_width - 1);
+  int x1 = std::clamp(static_cast<int>((ndcMax.x * 0.5f + 0.5f) * m_width), 0, m_width - 1);
+  int y0 = std::clamp(static_cast<int>((ndcMin.y * 0.5f + 0.5f) * m_height), 0, m_height - 1);
+  int y1 = std::clamp(static_cast<int>((ndcMax.y * 0.5f + 0.5f) * m_height), 0, m_height - 1);
+
+  // Coarsest level where the rectangle still spans at most ~2x2 texels
+  size_t level = 0;
+  int extent = std::max(x1 - x0, y1 - y0) + 1;
+  while (extent > 2 && level + 1 < m_pyramid.size()) {
+    extent = (extent + 1) / 2;
+    level++;
+  }
+
+  const auto &depth = m_pyramid[level];
+  glm::ivec2 size = m_levelSizes[level];
+  int lx0 = std::min(x0 >> level, size.x - 1), lx1 = std::min(x1 >> level, size.x - 1);
+  int ly0 = std::min(y0 >> level, size.y - 1), ly1 = std::min(y1 >> level, size.y - 1);
+
+  for (int y = ly0; y <= ly1; ++y)
+    for (int x = lx0; x <= lx1; ++x)
+      if (depth[y * size.x + x] >= nearestDepth)
+        return true;
+
+  return false;
+}
+
+int OcclusionCuller::getWidth() const { return m_width; }
+
+int OcclusionCuller::getHeight() const { return m_height; }
+
+size_t OcclusionCuller::getOccluderTriangleCount() const { return m_triangles.size(); }
+
+const std::vector<float> &OcclusionCuller::getDepthBuffer() const { return m_pyramid[0]; }
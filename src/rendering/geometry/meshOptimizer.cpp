@@ -0,0 +1,199 @@
+#include "rendering/geometry/meshOptimizer.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <unordered_map>
+
+namespace {
+// Forsyth scoring parameters
+constexpr int CACHE_SIZE = 32;
+constexpr float CACHE_DECAY_POWER = 1.5f;
+constexpr float LAST_TRIANGLE_SCORE = 0.75f;
+constexpr float VALENCE_BOOST_SCALE = 2.0f;
+constexpr float VALENCE_BOOST_POWER = 0.5f;
+
+// Hash/equality on the raw vertex bytes (Vertex has no padding)
+struct VertexHash {
+  size_t operator()(const Vertex &vertex) const {
+    const unsigned char *bytes = reinterpret_cast<const unsigned char *>(&vertex);
+    uint64_t hash = 1469598103934665603ull;
+    for (size_t i = 0; i < sizeof(Vertex); ++i)
+      hash = (hash ^ bytes[i]) * 1099511628211ull;
+    return static_cast<size_t>(hash);
+  }
+};
+
+struct VertexEqual {
+  bool operator()(const Vertex &a, const Vertex &b) const { return std::memcmp(&a, &b, sizeof(Vertex)) == 0; }
+};
+
+float vertexScore(int cachePosition, uint32_t remainingTriangles) {
+  if (remainingTriangles == 0)
+    return -1.0f;
+
+  float score = 0.0f;
+  if (cachePosition >= 0) {
+    // The last triangle's vertices get a fixed score so the strip does not just continue blindly
+    if (cachePosition < 3)
+      score = LAST_TRIANGLE_SCORE;
+    else
+      score = std::pow(1.0f - float(cachePosition - 3) / float(CACHE_SIZE - 3), CACHE_DECAY_POWER);
+  }
+
+  // Favor vertices with few triangles left to finish them off
+  score += VALENCE_BOOST_SCALE * std::pow(float(remainingTriangles), -VALENCE_BOOST_POWER);
+  return score;
+}
+} // namespace
+
+static_assert(sizeof(Vertex) == 8 * sizeof(float), "Vertex must stay padding-free for byte hashing");
+
+std::vector<Vertex> MeshOptimizer::deduplicateVertices(const std::vector<Vertex> &vertices,
+                                                       std::vector<uint32_t> &indices) {
+  std::vector<Vertex> unique;
+  std::unordered_map<Vertex, uint32_t, VertexHash, VertexEqual> lookup;
+  lookup.reserve(indices.size());
+
+  for (uint32_t &index : indices) {
+    auto [it, inserted] = lookup.try_emplace(vertices[index], static_cast<uint32_t>(unique.size()));
+    if (inserted)
+      unique.push_back(vertices[index]);
+    index = it->second;
+  }
+
+  return unique;
+}
+
+void MeshOptimizer::optimizeVertexCache(uint32_t *indices, size_t indexCount, size_t vertexCount) {
+  const size_t triangleCount = indexCount / 3;
+  if (triangleCount == 0)
+    return;
+
+  // Vertex -> triangles adjacency (CSR); each vertex's list shrinks as triangles are emitted
+  std::vector<uint32_t> remaining(vertexCount, 0);
+  for (size_t i = 0; i < indexCount; ++i)
+    remaining[indices[i]]++;
+
+  std::vector<uint32_t> offsets(vertexCount + 1, 0);
+  for (size_t v = 0; v < vertexCount; ++v)
+    offsets[v + 1] = offsets[v] + remaining[v];
+
+  std::vector<uint32_t> adjacency(indexCount);
+  std::vector<uint32_t> fill(offsets.begin(), offsets.end() - 1);
+  for (size_t i = 0; i < indexCount; ++i)
+    adjacency[fill[indices[i]]++] = static_cast<uint32_t>(i / 3);
+
+  std::vector<int> cachePosition(vertexCount, -1);
+  std::vector<float> score(vertexCount);
+  for (size_t v = 0; v < vertexCount; ++v)
+    score[v] = vertexScore(-1, remaining[v]);
+
+  std::vector<float> triangleScore(triangleCount);
+  for (size_t t = 0; t < triangleCount; ++t)
+    triangleScore[t] = score[indices[t * 3]] + score[indices[t * 3 + 1]] + score[indices[t * 3 + 2]];
+
+  std::vector<uint8_t> emitted(triangleCount, 0);
+  std::vector<uint32_t> output;
+  output.reserve(indexCount);
+
+  std::vector<uint32_t> cache, nextCache;
+  cache.reserve(CACHE_SIZE + 3);
+  nextCache.reserve(CACHE_SIZE + 3);
+
+  size_t best = 0;
+  for (size_t t = 1; t < triangleCount; ++t) {
+    if (triangleScore[t] > triangleScore[best])
+      best = t;
+  }
+  size_t scanCursor = 0;
+
+  for (size_t emittedCount = 0; emittedCount < triangleCount; ++emittedCount) {
+    // Dead end: continue with the next unemitted triangle in input order
+    if (best == SIZE_MAX) {
+      while (emitted[scanCursor])
+        scanCursor++;
+      best = scanCursor;
+    }
+
+    const uint32_t *triangle = indices + best * 3;
+    emitted[best] = 1;
+    output.insert(output.end(), triangle, triangle + 3);
+
+    // Detach the triangle from its vertices
+    for (int k = 0; k < 3; ++k) {
+      uint32_t v = triangle[k];
+      uint32_t *begin = adjacency.data() + offsets[v];
+      uint32_t *end = begin + remaining[v];
+      *std::find(begin, end, static_cast<uint32_t>(best)) = *(end - 1);
+      remaining[v]--;
+    }
+
+    // New cache: this triangle's vertices in front, older entries pushed back
+    nextCache.assign(triangle, triangle + 3);
+    for (uint32_t v : cache) {
+      if (v != triangle[0] && v != triangle[1] && v != triangle[2])
+        nextCache.push_back(v);
+    }
+
+    for (size_t i = 0; i < nextCache.size(); ++i) {
+      uint32_t v = nextCache[i];
+      cachePosition[v] = i < CACHE_SIZE ? static_cast<int>(i) : -1;
+      score[v] = vertexScore(cachePosition[v], remaining[v]);
+    }
+
+    // Rescore triangles touching the cache and pick the best for the next step
+    best = SIZE_MAX;
+    float bestScore = -1.0f;
+    for (uint32_t v : nextCache) {
+      for (uint32_t a = offsets[v]; a < offsets[v] + remaining[v]; ++a) {
+        uint32_t t = adjacency[a];
+        triangleScore[t] = score[indices[t * 3]] + score[indices[t * 3 + 1]] + score[indices[t * 3 + 2]];
+        if (triangleScore[t] > bestScore) {
+          bestScore = triangleScore[t];
+          best = t;
+        }
+      }
+    }
+
+    if (nextCache.size() > CACHE_SIZE)
+      nextCache.resize(CACHE_SIZE);
+    std::swap(cache, nextCache);
+  }
+
+  std::copy(output.begin(), output.end(), indices);
+}
+
+void MeshOptimizer::optimizeVertexFetch(std::vector<Vertex> &vertices, std::vector<uint32_t> &indices) {
+  constexpr uint32_t UNUSED = UINT32_MAX;
+  std::vector<uint32_t> remap(vertices.size(), UNUSED);
+  std::vector<Vertex> reordered;
+  reordered.reserve(vertices.size());
+
+  for (uint32_t &index : indices) {
+    if (remap[index] == UNUSED) {
+      remap[index] = static_cast<uint32_t>(reordered.size());
+      reordered.push_back(vertices[index]);
+    }
+    index = remap[index];
+  }
+
+  vertices = std::move(reordered);
+}
+
+float MeshOptimizer::computeAcmr(const uint32_t *indices, size_t indexCount, size_t vertexCount, uint32_t cacheSize) {
+  if (indexCount < 3)
+    return 0.0f;
+
+  // FIFO cache: a vertex is a hit while fewer than cacheSize misses happened since it was loaded
+  std::vector<size_t> loadedAt(vertexCount, 0);
+  size_t misses = 0;
+  for (size_t i = 0; i < indexCount; ++i) {
+    uint32_t v = indices[i];
+    if (loadedAt[v] == 0 || misses - loadedAt[v] >= cacheSize) {
+      misses++;
+      loadedAt[v] = misses;
+    }
+  }
+
+  return float(misses) / float(indexCount / 3);
+}
@@ -0,0 +1,274 @@
+#include "rendering/geometry/meshSimplifier.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <unordered_map>
+
+namespace {
+
+constexpr uint32_t kInvalid = std::numeric_limits<uint32_t>::max();
+constexpr double kBorderWeight = 10.0;
+
+// Symmetric 4x4 plane quadric, stored as upper triangle + accumulated weight
+struct Quadric {
+  double a2 = 0, ab = 0, ac = 0, ad = 0;
+  double b2 = 0, bc = 0, bd = 0;
+  double c2 = 0, cd = 0;
+  double d2 = 0;
+  double weight = 0;
+
+  void addPlane(const glm::dvec3 &n, double d, double w) {
+    a2 += w * n.x * n.x;
+    ab += w * n.x * n.y;
+    ac += w * n.x * n.z;
+    ad += w * n.x * d;
+    b2 += w * n.y * n.y;
+    bc += w * n.y * n.z;
+    bd += w * n.y * d;
+    c2 += w * n.z * n.z;
+    cd += w * n.z * d;
+    d2 += w * d * d;
+    weight += w;
+  }
+
+  void add(const Quadric &q) {
+    a2 += q.a2, ab += q.ab, ac += q.ac, ad += q.ad;
+    b2 += q.b2, bc += q.bc, bd += q.bd;
+    c2 += q.c2, cd += q.cd;
+    d2 += q.d2;
+    weight += q.weight;
+  }
+
+  // Weighted mean squared distance of p to the accumulated planes
+  double error(const glm::dvec3 &p) const {
+    double e = a2 * p.x * p.x + 2 * ab * p.x * p.y + 2 * ac * p.x * p.z + 2 * ad * p.x + b2 * p.y * p.y +
+               2 * bc * p.y * p.z + 2 * bd * p.y + c2 * p.z * p.z + 2 * cd * p.z + d2;
+    return weight > 0 ? std::abs(e) / weight : std::abs(e);
+  }
+};
+
+struct Collapse {
+  uint32_t from;
+  uint32_t to;
+  double cost;
+};
+
+uint64_t edgeKey(uint32_t a, uint32_t b) {
+  return a < b ? (uint64_t(a) << 32) | b : (uint64_t(b) << 32) | a;
+}
+
+struct PositionHash {
+  size_t operator()(const glm::vec3 &p) const {
+    uint32_t h[3];
+    std::memcpy(h, &p, sizeof(h));
+    return (h[0] * 73856093u) ^ (h[1] * 19349663u) ^ (h[2] * 83492791u);
+  }
+};
+
+// Pick the vertex at the destination position whose attributes best match v
+uint32_t closestAttributeVertex(const std::vector<Vertex> &vertices, uint32_t v, const std::vector<uint32_t> &candidates) {
+  uint32_t best = candidates.front();
+  float bestScore = std::numeric_limits<float>::max();
+  for (uint32_t c : candidates) {
+    float score = (1.0f - glm::dot(vertices[v].normal, vertices[c].normal)) +
+                  glm::dot(vertices[v].texCoord - vertices[c].texCoord, vertices[v].texCoord - vertices[c].texCoord);
+    if (score < bestScore) {
+      bestScore = score;
+      best = c;
+    }
+  }
+  return best;
+}
+
+} // namespace
+
+std::vector<uint32_t> MeshSimplifier::simplify(const std::vector<Vertex> &vertices, const uint32_t *indices,
+                                               size_t indexCount, size_t targetIndexCount, float maxError) {
+  std::vector<uint32_t> result(indices, indices + indexCount);
+  if (indexCount < 3 || targetIndexCount >= indexCount)
+    return result;
+
+  // Weld vertices by position; connectivity and quadrics live on welded ids
+  std::vector<uint32_t> weld(vertices.size(), kInvalid);
+  std::vector<glm::dvec3> positions;
+  std::vector<std::vector<uint32_t>> weldVertices;
+  std::unordered_map<glm::vec3, uint32_t, PositionHash> positionIds;
+
+  glm::vec3 boundsMin(std::numeric_limits<float>::max());
+  glm::vec3 boundsMax(std::numeric_limits<float>::lowest());
+
+  for (uint32_t v : result) {
+    if (weld[v] != kInvalid)
+      continue;
+    auto [it, inserted] = positionIds.try_emplace(vertices[v].position, static_cast<uint32_t>(positions.size()));
+    if (inserted) {
+      positions.emplace_back(vertices[v].position);
+      weldVertices.emplace_back();
+      boundsMin = glm::min(boundsMin, vertices[v].position);
+      boundsMax = glm::max(boundsMax, vertices[v].position);
+    }
+    weld[v] = it->second;
+    weldVertices[it->second].push_back(v);
+  }
+
+  // Triangles that are degenerate after welding (e.g. at UV sphere poles) have no edges to collapse
+  size_t kept = 0;
+  for (size_t t = 0; t + 2 < result.size(); t += 3) {
+    uint32_t w0 = weld[result[t]], w1 = weld[result[t + 1]], w2 = weld[result[t + 2]];
+    if (w0 == w1 || w1 == w2 || w0 == w2)
+      continue;
+    std::copy(result.begin() + t, result.begin() + t + 3, result.begin() + kept);
+    kept += 3;
+  }
+  result.resize(kept);
+
+  double extent = glm::length(glm::dvec3(boundsMax - boundsMin));
+  double errorLimit = (maxError * extent) * (maxError * extent);
+
+  // Face quadrics (area weighted)
+  std::vector<Quadric> quadrics(positions.size());
+  std::unordered_map<uint64_t, int> edgeUse;
+  for (size_t t = 0; t + 2 < result.size(); t += 3) {
+    uint32_t w[3] = {weld[result[t]], weld[result[t + 1]], weld[result[t + 2]]};
+    glm::dvec3 n = glm::cross(positions[w[1]] - positions[w[0]], positions[w[2]] - positions[w[0]]);
+    double len = glm::length(n);
+    if (len <= 0.0)
+      continue;
+    n /= len;
+    double d = -glm::dot(n, positions[w[0]]);
+    for (uint32_t k : w)
+      quadrics[k].addPlane(n, d, len * 0.5);
+    for (int e = 0; e < 3; ++e)
+      edgeUse[edgeKey(w[e], w[(e + 1) % 3])]++;
+  }
+
+  // Border edges get a perpendicular constraint plane to preserve silhouettes
+  for (size_t t = 0; t + 2 < result.size(); t += 3) {
+    uint32_t w[3] = {weld[result[t]], weld[result[t + 1]], weld[result[t + 2]]};
+    glm::dvec3 faceNormal = glm::cross(positions[w[1]] - positions[w[0]], positions[w[2]] - positions[w[0]]);
+    if (glm::length(faceNormal) <= 0.0)
+      continue;
+    faceNormal = glm::normalize(faceNormal);
+    for (int e = 0; e < 3; ++e) {
+      uint32_t a = w[e], b = w[(e + 1) % 3];
+      if (edgeUse[edgeKey(a, b)] != 1)
+        continue;
+      glm::dvec3 edge = positions[b] - positions[a];
+      double edgeLength = glm::length(edge);
+      if (edgeLength <= 0.0)
+        continue;
+      glm::dvec3 n = glm::normalize(glm::cross(edge, faceNormal));
+      double d = -glm::dot(n, positions[a]);
+      quadrics[a].addPlane(n, d, edgeLength * edgeLength * kBorderWeight);
+      quadrics[b].addPlane(n, d, edgeLength * edgeLength * kBorderWeight);
+    }
+  }
+
+  std::vector<uint32_t> remap(vertices.size());
+  std::vector<uint8_t> locked(positions.size());
+  std::vector<std::vector<uint32_t>> adjacency(positions.size());
+
+  while (result.size() > targetIndexCount) {
+    // Per-pass adjacency (welded id -> triangles) and unique edge list
+    for (auto &list : adjacency)
+      list.clear();
+    std::vector<uint64_t> edges;
+    edges.reserve(result.size());
+    for (size_t t = 0; t + 2 < result.size(); t += 3) {
+      uint32_t w[3] = {weld[result[t]], weld[result[t + 1]], weld[result[t + 2]]};
+      for (int e = 0; e < 3; ++e) {
+        adjacency[w[e]].push_back(static_cast<uint32_t>(t / 3));
+        edges.push_back(edgeKey(w[e], w[(e + 1) % 3]));
+      }
+    }
+    std::sort(edges.begin(), edges.end());
+    edges.erase(std::unique(edges.begin(), edges.end()), edges.end());
+
+    std::vector<Collapse> collapses;
+    collapses.reserve(edges.size());
+    for (uint64_t key : edges) {
+      uint32_t a = static_cast<uint32_t>(key >> 32);
+      uint32_t b = static_cast<uint32_t>(key & 0xffffffffu);
+      Quadric q = quadrics[a];
+      q.add(quadrics[b]);
+      double costAB = q.error(positions[b]);
+      double costBA = q.error(positions[a]);
+      if (costAB <= costBA)
+        collapses.push_back({a, b, costAB});
+      else
+        collapses.push_back({b, a, costBA});
+    }
+    std::sort(collapses.begin(), collapses.end(),
+              [](const Collapse &l, const Collapse &r) { return l.cost < r.cost; });
+
+    std::fill(locked.begin(), locked.end(), 0);
+    for (size_t v = 0; v < remap.size(); ++v)
+      remap[v] = static_cast<uint32_t>(v);
+
+    // Each collapse removes ~2 triangles; stop once the target is in reach
+    size_t trianglesToRemove = (result.size() - targetIndexCount) / 3;
+    size_t removed = 0;
+    size_t applied = 0;
+
+    for (const Collapse &c : collapses) {
+      if (removed >= trianglesToRemove || c.cost > errorLimit)
+        break;
+      if (locked[c.from] || locked[c.to])
+        continue;
+
+      // Reject collapses that flip or degenerate surrounding triangles
+      bool flips = false;
+      for (uint32_t tri : adjacency[c.from]) {
+        uint32_t w[3] = {weld[result[tri * 3]], weld[result[tri * 3 + 1]], weld[result[tri * 3 + 2]]};
+        if (w[0] == c.to || w[1] == c.to || w[2] == c.to)
+          continue;
+        glm::dvec3 p[3] = {positions[w[0]], positions[w[1]], positions[w[2]]};
+        glm::dvec3 before = glm::cross(p[1] - p[0], p[2] - p[0]);
+        for (auto &pos : p)
+          if (pos == positions[c.from])
+            pos = positions[c.to];
+        glm::dvec3 after = glm::cross(p[1] - p[0], p[2] - p[0]);
+        if (glm::dot(before, after) <= 0.0) {
+          flips = true;
+          break;
+        }
+      }
+      if (flips)
+        continue;
+
+      for (uint32_t v : weldVertices[c.from])
+        remap[v] = closestAttributeVertex(vertices, v, weldVertices[c.to]);
+
+      // Lock the whole neighbourhood so adjacency stays valid for this pass
+      for (uint32_t tri : adjacency[c.from]) {
+        for (int k = 0; k < 3; ++k)
+          locked[weld[result[tri * 3 + k]]] = 1;
+        uint32_t w[3] = {weld[result[tri * 3]], weld[result[tri * 3 + 1]], weld[result[tri * 3 + 2]]};
+        if (w[0] == c.to || w[1] == c.to || w[2] == c.to)
+          removed++;
+      }
+
+      quadrics[c.to].add(quadrics[c.from]);
+      weldVertices[c.from].clear();
+      applied++;
+    }
+
+    if (applied == 0)
+      break;
+
+    // Rewrite triangles and drop the degenerate ones
+    size_t write = 0;
+    for (size_t t = 0; t + 2 < result.size(); t += 3) {
+      uint32_t v0 = remap[result[t]], v1 = remap[result[t + 1]], v2 = remap[result[t + 2]];
+      if (weld[v0] == weld[v1] || weld[v1] == weld[v2] || weld[v0] == weld[v2])
+        continue;
+      result[write++] = v0;
+      result[write++] = v1;
+      result[write++] = v2;
+    }
+    result.resize(write);
+  }
+
+  return result;
+}
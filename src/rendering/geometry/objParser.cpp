@@ -0,0 +1,368 @@
+#include "rendering/geometry/objParser.h"
+#include "foundation/core/config.h"
+#include "foundation/core/mappedFile.h"
+#include "systems/jobSystem.h"
+#include <algorithm>
+#include <charconv>
+#include <cstring>
+#include <functional>
+#include <iostream>
+
+namespace {
+constexpr uint32_t NO_VERTEX = ~0u;
+
+// Face corner as 0-based attribute indices (-1 if absent)
+struct Corner {
+  int32_t position;
+  int32_t texCoord;
+  int32_t normal;
+};
+
+// Lines [begin, end) of the file, parsed by one job
+struct Chunk {
+  const char *begin = nullptr;
+  const char *end = nullptr;
+
+  // Attribute statements in the chunk (counting pass), then where they start in the whole file
+  uint32_t positionCount = 0, texCoordCount = 0, normalCount = 0, faceCount = 0;
+  uint32_t positionStart = 0, texCoordStart = 0, normalStart = 0;
+
+  std::vector<Corner> corners;       // triangulated faces
+  std::vector<uint32_t> groupStarts; // corners.size() at each 'o'/'g' statement
+  const char *error = nullptr;
+};
+
+// Attributes of the whole file, written by the chunks at their start offsets
+struct Attributes {
+  std::vector<glm::vec3> positions;
+  std::vector<glm::vec2> texCoords;
+  std::vector<glm::vec3> normals;
+};
+
+enum class Statement { Position, TexCoord, Normal, Face, Group, Other };
+
+bool isSpace(char c) { return c == ' ' || c == '\t' || c == '\r'; }
+
+const char *skipSpaces(const char *p, const char *end) {
+  while (p < end && isSpace(*p))
+    ++p;
+  return p;
+}
+
+// Statement keyword of a line; p is moved past it
+Statement readStatement(const char *&p, const char *end) {
+  p = skipSpaces(p, end);
+  const char *keyword = p;
+  while (p < end && !isSpace(*p))
+    ++p;
+
+  if (p - keyword == 1) {
+    switch (keyword[0]) {
+    case 'v':
+      return Statement::Position;
+    case 'f':
+      return Statement::Face;
+    case 'o':
+    case 'g':
+      return Statement::Group;
+    }
+  } else if (p - keyword == 2 && keyword[0] == 'v') {
+    if (keyword[1] == 't')
+      return Statement::TexCoord;
+    if (keyword[1] == 'n')
+      return Statement::Normal;
+  }
+  return Statement::Other;
+}
+
+// Next float of the line, nullptr if there is none
+const char *readFloat(const char *p, const char *end, float &value) {
+  p = skipSpaces(p, end);
+  if (p < end && *p == '+')
+    ++p;
+  auto [next, error] = std::from_chars(p, end, value);
+  if (error == std::errc::result_out_of_range)
+    value = 0.0f; // denormal or huge literal
+  else if (error != std::errc())
+    return nullptr;
+  return next;
+}
+
+// Face indices are short digit runs; a plain loop beats from_chars here
+const char *readInt(const char *p, const char *end, int32_t &value) {
+  bool negative = p < end && *p == '-';
+  if (negative || (p < end && *p == '+'))
+    ++p;
+
+  const char *digits = p;
+  uint32_t result = 0;
+  while (p < end && static_cast<unsigned char>(*p - '0') < 10)
+    result = result * 10 + static_cast<uint32_t>(*p++ - '0');
+  if (p == digits || p - digits > 9)
+    return nullptr;
+  value = negative ? -static_cast<int32_t>(result) : static_cast<int32_t>(result);
+  return p;
+}
+
+// 1-based, or negative relative to the attributes read so far; -1 if invalid
+int32_t resolveIndex(int32_t index, uint32_t count) {
+  if (index > 0)
+    return index - 1;
+  return index < 0 ? static_cast<int32_t>(count) + index : -1;
+}
+
+// One "v", "v/vt", "v//vn" or "v/vt/vn" corner
+const char *readCorner(const char *p, const char *end, const Chunk &chunk, const uint32_t counts[3], Corner &corner) {
+  int32_t index = 0;
+  if (!(p = readInt(p, end, index)))
+    return nullptr;
+  corner = {resolveIndex(index, chunk.positionStart + counts[0]), -1, -1};
+  if (corner.position < 0)
+    return nullptr;
+  if (p == end || *p != '/')
+    return p;
+
+  ++p;
+  if (p < end && *p != '/') {
+    if (!(p = readInt(p, end, index)) || (corner.texCoord = resolveIndex(index, chunk.texCoordStart + counts[1])) < 0)
+      return nullptr;
+  }
+  if (p == end || *p != '/')
+    return p;
+
+  ++p;
+  if (!(p = readInt(p, end, index)) || (corner.normal = resolveIndex(index, chunk.normalStart + counts[2])) < 0)
+    return nullptr;
+  return p;
+}
+
+const char *nextLine(const char *line, const char *end) {
+  const char *newline = static_cast<const char *>(std::memchr(line, '\n', end - line));
+  return newline ? newline : end;
+}
+
+// First pass: how many attributes each chunk defines, so the second pass knows where they land
+void countChunk(Chunk &chunk) {
+  for (const char *line = chunk.begin; line < chunk.end;) {
+    const char *lineEnd = nextLine(line, chunk.end);
+    const char *p = line;
+    switch (readStatement(p, lineEnd)) {
+    case Statement::Position:
+      chunk.positionCount++;
+      break;
+    case Statement::TexCoord:
+      chunk.texCoordCount++;
+      break;
+    case Statement::Normal:
+      chunk.normalCount++;
+      break;
+    case Statement::Face:
+      chunk.faceCount++;
+      break;
+    default:
+      break;
+    }
+    line = lineEnd + 1;
+  }
+}
+
+void parseChunk(Chunk &chunk, Attributes &attributes) {
+  uint32_t counts[3] = {0, 0, 0}; // positions, texCoords, normals read so far in this chunk
+  std::vector<Corner> polygon;
+  chunk.corners.reserve(chunk.faceCount * 3); // exact for triangles, quads grow once
+
+  for (const char *line = chunk.begin; line < chunk.end && !chunk.error;) {
+    const char *lineEnd = nextLine(line, chunk.end);
+    const char *p = line;
+    line = lineEnd + 1;
+
+    switch (readStatement(p, lineEnd)) {
+    case Statement::Position: {
+      glm::vec3 &position = attributes.positions[chunk.positionStart + counts[0]++];
+      if (!(p = readFloat(p, lineEnd, position.x)) || !(p = readFloat(p, lineEnd, position.y)) ||
+          !readFloat(p, lineEnd, position.z))
+        chunk.error = "malformed vertex position";
+      break;
+    }
+    case Statement::TexCoord: {
+      glm::vec2 &texCoord = attributes.texCoords[chunk.texCoordStart + counts[1]++];
+      texCoord.y = 0.0f;
+      if (!(p = readFloat(p, lineEnd, texCoord.x)))
+        chunk.error = "malformed texture coordinate";
+      else
+        readFloat(p, lineEnd, texCoord.y); // V is optional
+      texCoord.y = 1.0f - texCoord.y;      // flip for OpenGL
+      break;
+    }
+    case Statement::Normal: {
+      glm::vec3 &normal = attributes.normals[chunk.normalStart + counts[2]++];
+      if (!(p = readFloat(p, lineEnd, normal.x)) || !(p = readFloat(p, lineEnd, normal.y)) ||
+          !readFloat(p, lineEnd, normal.z))
+        chunk.error = "malformed vertex normal";
+      break;
+    }
+    case Statement::Face: {
+      polygon.clear();
+      for (p = skipSpaces(p, lineEnd); p < lineEnd && *p != '#'; p = skipSpaces(p, lineEnd)) {
+        Corner corner;
+        if (!(p = readCorner(p, lineEnd, chunk, counts, corner))) {
+          chunk.error = "malformed face";
+          break;
+        }
+        polygon.push_back(corner);
+      }
+      for (size_t i = 2; i < polygon.size(); ++i) {
+        chunk.corners.push_back(polygon[0]);
+        chunk.corners.push_back(polygon[i - 1]);
+        chunk.corners.push_back(polygon[i]);
+      }
+      break;
+    }
+    case Statement::Group:
+      chunk.groupStarts.push_back(static_cast<uint32_t>(chunk.corners.size()));
+      break;
+    case Statement::Other:
+      break;
+    }
+  }
+}
+
+// Chunks of about OBJ_PARSE_CHUNK_BYTES, each ending after a newline
+std::vector<Chunk> splitChunks(const char *data, size_t size) {
+  size_t chunkCount = size / EngineConfig::OBJ_PARSE_CHUNK_BYTES + 1;
+  std::vector<Chunk> chunks;
+  chunks.reserve(chunkCount);
+
+  const char *end = data + size;
+  const char *begin = data;
+  for (size_t i = 1; i <= chunkCount && begin < end; ++i) {
+    const char *split = i == chunkCount ? end : nextLine(std::max(begin, data + size * i / chunkCount), end);
+    split = split < end ? split + 1 : end;
+
+    Chunk chunk;
+    chunk.begin = begin;
+    chunk.end = split;
+    chunks.push_back(std::move(chunk));
+    begin = split;
+  }
+  return chunks;
+}
+
+void forEachChunk(std::vector<Chunk> &chunks, JobSystem *jobSystem, const std::function<void(Chunk &)> &fn) {
+  if (!jobSystem) {
+    for (Chunk &chunk : chunks)
+      fn(chunk);
+    return;
+  }
+  jobSystem->parallelFor(static_cast<uint32_t>(chunks.size()), 1, [&](uint32_t begin, uint32_t end) {
+    for (uint32_t i = begin; i < end; ++i)
+      fn(chunks[i]);
+  });
+}
+
+// Weld the corners of all chunks into unique vertices (in order of first use) and cut submeshes at groups.
+// Vertices sharing a position are chained, so a corner only compares against the few vertices of its position.
+bool mergeChunks(const std::vector<Chunk> &chunks, const Attributes &attributes, ObjParser::Result &result) {
+  const int32_t positionCount = static_cast<int32_t>(attributes.positions.size());
+  const int32_t texCoordCount = static_cast<int32_t>(attributes.texCoords.size());
+  const int32_t normalCount = static_cast<int32_t>(attributes.normals.size());
+
+  size_t cornerCount = 0;
+  for (const Chunk &chunk : chunks)
+    cornerCount += chunk.corners.size();
+  result.cornerCount = static_cast<uint32_t>(cornerCount);
+  result.indices.reserve(cornerCount);
+  result.vertices.reserve(attributes.positions.size());
+
+  std::vector<uint32_t> firstVertex(attributes.positions.size(), NO_VERTEX);
+  std::vector<uint32_t> nextVertex;
+  std::vector<Corner> vertexCorners;
+  nextVertex.reserve(attributes.positions.size());
+  vertexCorners.reserve(attributes.positions.size());
+
+  uint32_t submeshStart = 0;
+  auto closeSubmesh = [&]() {
+    uint32_t end = static_cast<uint32_t>(result.indices.size());
+    if (end > submeshStart)
+      result.submeshes.push_back({submeshStart, end - submeshStart});
+    submeshStart = end;
+  };
+
+  for (const Chunk &chunk : chunks) {
+    size_t group = 0;
+    for (size_t i = 0; i < chunk.corners.size(); ++i) {
+      while (group < chunk.groupStarts.size() && chunk.groupStarts[group] == i) {
+        closeSubmesh();
+        group++;
+      }
+
+      const Corner &corner = chunk.corners[i];
+      if (corner.position >= positionCount || corner.texCoord >= texCoordCount || corner.normal >= normalCount)
+        return false;
+
+      uint32_t vertex = firstVertex[corner.position];
+      while (vertex != NO_VERTEX && (vertexCorners[vertex].texCoord != corner.texCoord ||
+                                     vertexCorners[vertex].normal != corner.normal))
+        vertex = nextVertex[vertex];
+
+      if (vertex == NO_VERTEX) {
+        vertex = static_cast<uint32_t>(result.vertices.size());
+        Vertex &added = result.vertices.emplace_back();
+        added.position = attributes.positions[corner.position];
+        added.normal = corner.normal >= 0 ? attributes.normals[corner.normal] : glm::vec3(0.0f);
+        added.texCoord = corner.texCoord >= 0 ? attributes.texCoords[corner.texCoord] : glm::vec2(0.0f);
+        vertexCorners.push_back(corner);
+        nextVertex.push_back(firstVertex[corner.position]);
+        firstVertex[corner.position] = vertex;
+      }
+      result.indices.push_back(vertex);
+    }
+    // Groups after the last face of the chunk
+    if (group < chunk.groupStarts.size())
+      closeSubmesh();
+  }
+  closeSubmesh();
+  return true;
+}
+} // namespace
+
+bool ObjParser::parse(const std::string &path, Result &result, JobSystem *jobSystem) {
+  result = Result();
+  MappedFile file;
+  if (!file.open(path)) {
+    std::cerr << "[ObjParser] Cannot open " << path << std::endl;
+    return false;
+  }
+
+  std::vector<Chunk> chunks = splitChunks(reinterpret_cast<const char *>(file.getData()), file.getSize());
+  forEachChunk(chunks, jobSystem, countChunk);
+
+  Attributes attributes;
+  uint32_t positions = 0, texCoords = 0, normals = 0;
+  for (Chunk &chunk : chunks) {
+    chunk.positionStart = positions;
+    chunk.texCoordStart = texCoords;
+    chunk.normalStart = normals;
+    positions += chunk.positionCount;
+    texCoords += chunk.texCoordCount;
+    normals += chunk.normalCount;
+  }
+  attributes.positions.resize(positions);
+  attributes.texCoords.resize(texCoords);
+  attributes.normals.resize(normals);
+
+  forEachChunk(chunks, jobSystem, [&attributes](Chunk &chunk) { parseChunk(chunk, attributes); });
+  for (const Chunk &chunk : chunks) {
+    if (chunk.error) {
+      std::cerr << "[ObjParser] " << path << ": " << chunk.error << std::endl;
+      return false;
+    }
+  }
+
+  if (!mergeChunks(chunks, attributes, result)) {
+    std::cerr << "[ObjParser] " << path << ": face index out of range" << std::endl;
+    result = Result();
+    return false;
+  }
+  return true;
+}
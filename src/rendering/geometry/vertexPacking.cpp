@@ -0,0 +1,41 @@
+#include "rendering/geometry/vertexPacking.h"
+#include <cmath>
+#include <glm/gtc/packing.hpp>
+
+static_assert(sizeof(PackedVertex) == 16, "PackedVertex must stay 16 bytes");
+
+namespace {
+constexpr float POSITION_STEPS = 65535.0f;
+} // namespace
+
+PositionDecode VertexPacking::getPositionDecode(const glm::vec3 &boundsMin, const glm::vec3 &boundsMax) {
+  PositionDecode decode;
+  decode.offset = boundsMin;
+  decode.scale = boundsMax - boundsMin;
+  return decode;
+}
+
+std::vector<PackedVertex> VertexPacking::packVertices(const Vertex *vertices, size_t vertexCount,
+                                                      const glm::vec3 &boundsMin, const glm::vec3 &boundsMax) {
+  // Flat axes (zero extent) quantize to 0 and decode to the offset
+  const glm::vec3 extent = boundsMax - boundsMin;
+  glm::vec3 inverseScale(0.0f);
+  for (int axis = 0; axis < 3; ++axis)
+    inverseScale[axis] = extent[axis] > 0.0f ? POSITION_STEPS / extent[axis] : 0.0f;
+
+  std::vector<PackedVertex> packed(vertexCount);
+  for (size_t i = 0; i < vertexCount; ++i) {
+    const Vertex &vertex = vertices[i];
+    PackedVertex &out = packed[i];
+
+    glm::vec3 quantized = glm::clamp((vertex.position - boundsMin) * inverseScale, 0.0f, POSITION_STEPS);
+    for (int axis = 0; axis < 3; ++axis)
+      out.position[axis] = static_cast<uint16_t>(std::lround(quantized[axis]));
+    out.position[3] = 0;
+
+    out.normal = glm::packSnorm3x10_1x2(glm::vec4(vertex.normal, 0.0f));
+    out.texCoord[0] = glm::packHalf1x16(vertex.texCoord.x);
+    out.texCoord[1] = glm::packHalf1x16(vertex.texCoord.y);
+  }
+  return packed;
+}
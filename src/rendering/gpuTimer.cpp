@@ -0,0 +1,113 @@
+#include "rendering/gpuTimer.h"
+#include "rendering/backend/renderBackend.h"
+#include <algorithm>
+
+void GpuTimer::init() {
+  auto &backend = RenderBackend::get();
+  for (Slot &slot : m_slots) {
+    for (uint32_t pass = 0; pass < PASS_COUNT; ++pass) {
+      slot.begin[pass] = backend.createTimestampQuery();
+      slot.end[pass] = backend.createTimestampQuery();
+    }
+  }
+
+  for (auto &history : m_history)
+    history.assign(EngineConfig::GPU_TIMER_HISTORY, 0.0f);
+
+  m_initialized = true;
+}
+
+GpuTimer::Slot &GpuTimer::currentSlot() { return m_slots[m_frame % SLOT_COUNT]; }
+
+void GpuTimer::beginFrame() {
+  if (!m_initialized)
+    return;
+
+  m_frame++;
+  Slot &slot = currentSlot();
+  collect(slot);
+  slot.issued.fill(false);
+}
+
+// Results of one finished frame; dropped as a whole if any query is still pending
+void GpuTimer::collect(Slot &slot) {
+  if (std::none_of(slot.issued.begin(), slot.issued.end(), [](bool issued) { return issued; }))
+    return;
+
+  auto &backend = RenderBackend::get();
+  std::array<float, PASS_COUNT> sample{};
+
+  for (uint32_t pass = 0; pass < PASS_COUNT; ++pass) {
+    if (!slot.issued[pass])
+      continue;
+
+    uint64_t begin = 0, end = 0;
+    if (!backend.readTimestamp(slot.begin[pass], begin) || !backend.readTimestamp(slot.end[pass], end)) {
+      m_droppedFrames++;
+      return;
+    }
+    sample[pass] = end > begin ? (end - begin) / 1e6f : 0.0f;
+  }
+
+  m_lastMs = sample;
+  for (uint32_t pass = 0; pass < PASS_COUNT; ++pass)
+    m_history[pass][m_historyNext] = sample[pass];
+
+  m_historyNext = (m_historyNext + 1) % EngineConfig::GPU_TIMER_HISTORY;
+  m_historySize = std::min(m_historySize + 1, EngineConfig::GPU_TIMER_HISTORY);
+}
+
+void GpuTimer::begin(GpuPass pass) {
+  if (!m_initialized)
+    return;
+
+  Slot &slot = currentSlot();
+  uint32_t index = static_cast<uint32_t>(pass);
+  RenderBackend::get().writeTimestamp(slot.begin[index]);
+  slot.issued[index] = true;
+}
+
+void GpuTimer::end(GpuPass pass) {
+  if (!m_initialized)
+    return;
+
+  RenderBackend::get().writeTimestamp(currentSlot().end[static_cast<uint32_t>(pass)]);
+}
+
+const char *GpuTimer::getPassName(GpuPass pass) {
+  switch (pass) {
+  case GpuPass::Frame:
+    return "Frame";
+  case GpuPass::Shadow:
+    return "Shadow";
+  case GpuPass::Main:
+    return "Main";
+  case GpuPass::UI:
+    return "UI";
+  default:
+    return "?";
+  }
+}
+
+float GpuTimer::getLastMs(GpuPass pass) const { return m_lastMs[static_cast<uint32_t>(pass)]; }
+
+float GpuTimer::getPercentile(GpuPass pass, float p) const {
+  if (m_historySize == 0)
+    return 0.0f;
+
+  const auto &history = m_history[static_cast<uint32_t>(pass)];
+  std::vector<float> sorted(history.begin(), history.begin() + m_historySize);
+  size_t rank = static_cast<size_t>(std::clamp(p, 0.0f, 1.0f) * (m_historySize - 1) + 0.5f);
+  std::nth_element(sorted.begin(), sorted.begin() + rank, sorted.end());
+  return sorted[rank];
+}
+
+const float *GpuTimer::getHistory(GpuPass pass) const { return m_history[static_cast<uint32_t>(pass)].data(); }
+
+uint32_t GpuTimer::getHistorySize() const { return m_historySize; }
+
+uint32_t GpuTimer::getHistoryOffset() const {
+  return m_historySize < EngineConfig::GPU_TIMER_HISTORY ? 0 : m_historyNext;
+}
+
+uint32_t GpuTimer::getDroppedFrames() const { return m_droppedFrames; }
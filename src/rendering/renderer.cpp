@@ -1,79 +1,67 @@
 #include "rendering/renderer.h"
+#include "rendering/backend/renderBackend.h"
 #include "rendering/resources/mesh.h"
 
-void Renderer::init(SDL_Window *window) {
-  m_window = window;
+void Renderer::init() {
   initShadowMapping();
+  m_gpuTimer.init();
 }
 
-void Renderer::beginFrame() const { glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT); }
+void Renderer::beginFrame() {
+  m_gpuTimer.beginFrame();
+  m_gpuTimer.begin(GpuPass::Frame);
+  RenderBackend::get().clear();
+}
 
-void Renderer::endFrame() const { SDL_GL_SwapWindow(m_window); }
+void Renderer::endFrame() {
+  m_gpuTimer.end(GpuPass::Frame);
+  RenderBackend::get().present();
+}
 
 // Draw all submeshes of a mesh
-void Renderer::drawMesh(const Mesh &mesh) const {
-  glBindVertexArray(mesh.getVAO());
-
-  const auto &submeshes = mesh.getSubmeshes();
-  for (const auto &submesh : submeshes) {
-    glDrawElements(GL_TRIANGLES, static_cast<GLsizei>(submesh.indexCount), GL_UNSIGNED_INT,
-                   (void *)(submesh.indexStart * sizeof(uint32_t)));
+void Renderer::drawMesh(const Mesh &mesh, uint32_t lod) const {
+  for (const auto &submesh : mesh.getSubmeshes()) {
+    drawRange(mesh, submesh.getLod(lod));
   }
-
-  glBindVertexArray(0);
 }
 
 // Draw single submesh
-void Renderer::drawSubmesh(const Mesh &mesh, const Submesh &submesh) const {
-  glBindVertexArray(mesh.getVAO());
-  glDrawElements(GL_TRIANGLES, static_cast<GLsizei>(submesh.indexCount), GL_UNSIGNED_INT,
-                 (void *)(submesh.indexStart * sizeof(uint32_t)));
-  glBindVertexArray(0);
+void Renderer::drawSubmesh(const Mesh &mesh, const Submesh &submesh, uint32_t lod) const {
+  drawRange(mesh, submesh.getLod(lod));
+}
+
+// Draw an explicit index range (recorded draw commands)
+void Renderer::drawRange(const Mesh &mesh, const SubmeshLod &range) const {
+  RenderBackend::get().drawIndexed(mesh.getVAO(), range.indexStart, range.indexCount);
 }
 
 // Start shadow depth pass
 void Renderer::beginShadowPass() {
-  glViewport(0, 0, m_shadowWidth, m_shadowHeight);
-  glBindFramebuffer(GL_FRAMEBUFFER, m_depthMapFBO);
-  glClear(GL_DEPTH_BUFFER_BIT);
+  m_gpuTimer.begin(GpuPass::Shadow);
+  auto &backend = RenderBackend::get();
+  backend.setViewport(0, 0, m_shadowWidth, m_shadowHeight);
+  backend.bindFramebuffer(m_depthMapFBO);
+  backend.clear();
 }
 
 // End shadow pass, restore main framebuffer
 void Renderer::endShadowPass() {
-  glBindFramebuffer(GL_FRAMEBUFFER, 0);
-  glViewport(0, 0, m_screenWidth, m_screenHeight);
+  auto &backend = RenderBackend::get();
+  backend.bindFramebuffer(0);
+  backend.setViewport(0, 0, m_screenWidth, m_screenHeight);
+  m_gpuTimer.end(GpuPass::Shadow);
 }
 
 // Setup shadow mapping FBO and depth texture
 void Renderer::initShadowMapping() {
-  glGenFramebuffers(1, &m_depthMapFBO);
-  glGenTextures(1, &m_depthMap);
-
-  glBindTexture(GL_TEXTURE_2D, m_depthMap);
-  glTexImage2D(GL_TEXTURE_2D, 0, GL_DEPTH_COMPONENT, m_shadowWidth, m_shadowHeight, 0, GL_DEPTH_COMPONENT, GL_FLOAT,
-               nullptr);
-
-  // Linear filtering for PCF
-  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-
-  // Clamp to border (white = no shadow outside frustum)
-  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_BORDER);
-  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_BORDER);
-  float borderColor[] = {1.0f, 1.0f, 1.0f, 1.0f};
-  glTexParameterfv(GL_TEXTURE_2D, GL_TEXTURE_BORDER_COLOR, borderColor);
-
-  // Attach depth texture to FBO
-  glBindFramebuffer(GL_FRAMEBUFFER, m_depthMapFBO);
-  glFramebufferTexture2D(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_TEXTURE_2D, m_depthMap, 0);
-  glDrawBuffer(GL_NONE);
-  glReadBuffer(GL_NONE);
-  glBindFramebuffer(GL_FRAMEBUFFER, 0);
+  RenderBackend::get().createDepthTarget(m_shadowWidth, m_shadowHeight, m_depthMapFBO, m_depthMap);
 }
 
-GLuint Renderer::getDepthMap() const { return m_depthMap; }
+uint32_t Renderer::getDepthMap() const { return m_depthMap; }
+
+uint32_t Renderer::getDepthMapFBO() const { return m_depthMapFBO; }
 
-GLuint Renderer::getDepthMapFBO() const { return m_depthMapFBO; }
+GpuTimer &Renderer::getGpuTimer() { return m_gpuTimer; }
 
 void Renderer::setViewportSize(int width, int height) {
   m_screenWidth = width;
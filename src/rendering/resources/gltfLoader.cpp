@@ -0,0 +1,408 @@
+#include "rendering/resources/gltfLoader.h"
+#include "foundation/core/profiler.h"
+#include <cstring>
+#include <glm/gtc/matrix_transform.hpp>
+#include <glm/gtc/quaternion.hpp>
+#include <iostream>
+#include <json/json.hpp>
+
+using json = nlohmann::json;
+
+namespace {
+constexpr uint32_t GLB_MAGIC = 0x46546C67; // "glTF"
+constexpr uint32_t CHUNK_JSON = 0x4E4F534A;
+constexpr uint32_t CHUNK_BIN = 0x004E4942;
+constexpr uint32_t MAX_NODE_DEPTH = 64;
+
+// glTF component types (GL enum values)
+constexpr uint32_t UNSIGNED_BYTE = 5121;
+constexpr uint32_t UNSIGNED_SHORT = 5123;
+constexpr uint32_t UNSIGNED_INT = 5125;
+constexpr uint32_t FLOAT = 5126;
+constexpr int TRIANGLES = 4;
+
+size_t getComponentSize(uint32_t componentType) {
+  switch (componentType) {
+  case 5120:
+  case UNSIGNED_BYTE:
+    return 1;
+  case 5122:
+  case UNSIGNED_SHORT:
+    return 2;
+  case UNSIGNED_INT:
+  case FLOAT:
+    return 4;
+  default:
+    return 0;
+  }
+}
+
+int getComponentCount(const std::string &type) {
+  static const std::pair<const char *, int> types[] = {{"SCALAR", 1}, {"VEC2", 2}, {"VEC3", 3}, {"VEC4", 4},
+                                                       {"MAT2", 4},   {"MAT3", 9}, {"MAT4", 16}};
+  for (const auto &[name, count] : types)
+    if (type == name)
+      return count;
+  return 0;
+}
+
+// Typed lookups that never throw (missing or mistyped members give the fallback)
+int64_t getInt(const json &object, const char *key, int64_t fallback) {
+  auto it = object.find(key);
+  return it != object.end() && it->is_number_integer() ? it->get<int64_t>() : fallback;
+}
+
+std::string getString(const json &object, const char *key) {
+  auto it = object.find(key);
+  return it != object.end() && it->is_string() ? it->get<std::string>() : std::string();
+}
+
+// Up to count numbers of an array member; false if absent or too short
+bool getFloats(const json &object, const char *key, float *values, size_t count) {
+  auto it = object.find(key);
+  if (it == object.end() || !it->is_array() || it->size() < count)
+    return false;
+  for (size_t i = 0; i < count; ++i) {
+    if (!(*it)[i].is_number())
+      return false;
+    values[i] = (*it)[i].get<float>();
+  }
+  return true;
+}
+
+const json &getArray(const json &object, const char *key) {
+  static const json empty = json::array();
+  auto it = object.find(key);
+  return it != object.end() && it->is_array() ? *it : empty;
+}
+
+glm::mat4 getLocalTransform(const json &node) {
+  float values[16];
+  if (getFloats(node, "matrix", values, 16)) {
+    glm::mat4 matrix;
+    std::memcpy(&matrix[0][0], values, sizeof(values)); // column-major, like glm
+    return matrix;
+  }
+
+  glm::vec3 translation(0.0f), scale(1.0f);
+  glm::quat rotation(1.0f, 0.0f, 0.0f, 0.0f);
+  if (getFloats(node, "translation", values, 3))
+    translation = glm::vec3(values[0], values[1], values[2]);
+  if (getFloats(node, "rotation", values, 4))
+    rotation = glm::quat(values[3], values[0], values[1], values[2]); // glTF stores x, y, z, w
+  if (getFloats(node, "scale", values, 3))
+    scale = glm::vec3(values[0], values[1], values[2]);
+  return glm::translate(glm::mat4(1.0f), translation) * glm::mat4_cast(rotation) * glm::scale(glm::mat4(1.0f), scale);
+}
+
+void addInstances(const json &nodes, int64_t index, const glm::mat4 &parent, uint32_t depth,
+                  GltfLoader::Asset &asset) {
+  if (index < 0 || index >= static_cast<int64_t>(nodes.size()) || depth > MAX_NODE_DEPTH)
+    return;
+  const json &node = nodes[index];
+  glm::mat4 world = parent * getLocalTransform(node);
+
+  int64_t mesh = getInt(node, "mesh", -1);
+  if (mesh >= 0 && mesh < static_cast<int64_t>(asset.meshes.size())) {
+    GltfLoader::Instance instance;
+    instance.name = getString(node, "name");
+    if (instance.name.empty())
+      instance.name = asset.meshes[mesh].name.empty() ? "Node " + std::to_string(index) : asset.meshes[mesh].name;
+    instance.mesh = static_cast<uint32_t>(mesh);
+    instance.world = world;
+    asset.instances.push_back(std::move(instance));
+  }
+
+  for (const json &child : getArray(node, "children"))
+    if (child.is_number_integer())
+      addInstances(nodes, child.get<int64_t>(), world, depth + 1, asset);
+}
+
+// Resolve an accessor to a checked range of the binary chunk (count stays 0 if it is unusable)
+GltfLoader::Accessor readAccessor(const json &accessor, const json &bufferViews, size_t binarySize) {
+  GltfLoader::Accessor result;
+  int64_t viewIndex = getInt(accessor, "bufferView", -1);
+  if (viewIndex < 0 || viewIndex >= static_cast<int64_t>(bufferViews.size()) || accessor.contains("sparse"))
+    return result;
+  const json &view = bufferViews[viewIndex];
+  if (getInt(view, "buffer", 0) != 0)
+    return result;
+
+  result.componentType = static_cast<uint32_t>(getInt(accessor, "componentType", 0));
+  result.components = getComponentCount(getString(accessor, "type"));
+  size_t elementSize = getComponentSize(result.componentType) * result.components;
+  int64_t count = getInt(accessor, "count", 0);
+  int64_t viewOffset = getInt(view, "byteOffset", 0), viewLength = getInt(view, "byteLength", 0);
+  int64_t offset = getInt(accessor, "byteOffset", 0);
+  int64_t stride = getInt(view, "byteStride", 0);
+  if (elementSize == 0 || count <= 0 || viewOffset < 0 || offset < 0 || stride < 0)
+    return result;
+
+  result.offset = static_cast<size_t>(viewOffset + offset);
+  result.stride = stride ? static_cast<size_t>(stride) : elementSize;
+  size_t end = result.offset + result.stride * (count - 1) + elementSize;
+  if (end > static_cast<size_t>(viewOffset + viewLength) || end > binarySize)
+    return result;
+  result.count = static_cast<size_t>(count);
+
+  float values[3];
+  if (getFloats(accessor, "min", values, 3)) {
+    result.min = glm::vec3(values[0], values[1], values[2]);
+    result.hasBounds = getFloats(accessor, "max", values, 3);
+    result.max = glm::vec3(values[0], values[1], values[2]);
+  }
+  return result;
+}
+
+const GltfLoader::Accessor *findAccessor(const GltfLoader::Asset &asset, int index) {
+  if (index < 0 || index >= static_cast<int>(asset.accessors.size()) || asset.accessors[index].count == 0)
+    return nullptr;
+  return &asset.accessors[index];
+}
+
+bool isFloatVector(const GltfLoader::Accessor *accessor, int components) {
+  return accessor && accessor->componentType == FLOAT && accessor->components == components;
+}
+
+// Element i of a float accessor (the binary chunk gives no alignment guarantee for strided data)
+template <typename T> T readFloats(const GltfLoader::Asset &asset, const GltfLoader::Accessor &accessor, size_t i) {
+  T value;
+  std::memcpy(&value, asset.binary + accessor.offset + i * accessor.stride, sizeof(T));
+  return value;
+}
+
+uint32_t readIndex(const GltfLoader::Asset &asset, const GltfLoader::Accessor &accessor, size_t i) {
+  const uint8_t *element = asset.binary + accessor.offset + i * accessor.stride;
+  switch (accessor.componentType) {
+  case UNSIGNED_BYTE:
+    return *element;
+  case UNSIGNED_SHORT: {
+    uint16_t index;
+    std::memcpy(&index, element, sizeof(index));
+    return index;
+  }
+  default: {
+    uint32_t index;
+    std::memcpy(&index, element, sizeof(index));
+    return index;
+  }
+  }
+}
+
+bool isIndexAccessor(const GltfLoader::Accessor *accessor) {
+  return accessor && accessor->components == 1 &&
+         (accessor->componentType == UNSIGNED_BYTE || accessor->componentType == UNSIGNED_SHORT ||
+          accessor->componentType == UNSIGNED_INT);
+}
+
+// Indices of every primitive, one submesh each, offset by the first vertex of the primitive
+void appendIndices(const GltfLoader::Asset &asset, const GltfLoader::Primitive &primitive, uint32_t baseVertex,
+                   uint32_t vertexCount, std::vector<uint32_t> &indices, std::vector<Submesh> &submeshes) {
+  Submesh submesh{};
+  submesh.indexStart = static_cast<uint32_t>(indices.size());
+  if (const GltfLoader::Accessor *accessor = findAccessor(asset, primitive.indices)) {
+    for (size_t i = 0; i + 2 < accessor->count; i += 3)
+      for (size_t k = 0; k < 3; ++k)
+        indices.push_back(baseVertex + std::min(readIndex(asset, *accessor, i + k), vertexCount - 1));
+  } else {
+    for (uint32_t i = 0; i + 2 < vertexCount; i += 3)
+      indices.insert(indices.end(), {baseVertex + i, baseVertex + i + 1, baseVertex + i + 2});
+  }
+  submesh.indexCount = static_cast<uint32_t>(indices.size()) - submesh.indexStart;
+  submeshes.push_back(submesh);
+}
+} // namespace
+
+bool GltfLoader::load(const std::string &path, Asset &asset) {
+  PROFILE_ZONE("LoadGltf");
+  if (!asset.file.open(path)) {
+    std::cerr << "[GltfLoader] Cannot open " << path << std::endl;
+    return false;
+  }
+
+  // Header (magic, version, length), then chunks of (length, type, data padded to 4 bytes)
+  const uint8_t *data = asset.file.getData();
+  const size_t size = asset.file.getSize();
+  uint32_t header[3] = {};
+  if (size >= sizeof(header))
+    std::memcpy(header, data, sizeof(header));
+  if (header[0] != GLB_MAGIC || header[1] != 2 || header[2] > size) {
+    std::cerr << "[GltfLoader] Not a glTF 2.0 binary file: " << path << std::endl;
+    return false;
+  }
+
+  const char *jsonText = nullptr;
+  size_t jsonLength = 0;
+  for (size_t offset = sizeof(header); offset + 8 <= header[2];) {
+    uint32_t chunk[2];
+    std::memcpy(chunk, data + offset, sizeof(chunk));
+    offset += sizeof(chunk);
+    if (chunk[0] > header[2] - offset)
+      break;
+    if (chunk[1] == CHUNK_JSON && !jsonText) {
+      jsonText = reinterpret_cast<const char *>(data + offset);
+      jsonLength = chunk[0];
+    } else if (chunk[1] == CHUNK_BIN && !asset.binary) {
+      asset.binary = data + offset;
+      asset.binarySize = chunk[0];
+    }
+    offset += (chunk[0] + 3) & ~3u;
+  }
+
+  json document = jsonText ? json::parse(jsonText, jsonText + jsonLength, nullptr, false) : json();
+  if (!document.is_object()) {
+    std::cerr << "[GltfLoader] Invalid JSON chunk: " << path << std::endl;
+    return false;
+  }
+  const json &buffers = getArray(document, "buffers");
+  if (!buffers.empty() && buffers[0].contains("uri"))
+    std::cerr << "[GltfLoader] External buffers are not supported: " << path << std::endl;
+
+  const json &bufferViews = getArray(document, "bufferViews");
+  for (const json &accessor : getArray(document, "accessors"))
+    asset.accessors.push_back(readAccessor(accessor, bufferViews, asset.binary ? asset.binarySize : 0));
+
+  for (const json &mesh : getArray(document, "meshes")) {
+    MeshInfo info;
+    info.name = getString(mesh, "name");
+    for (const json &primitive : getArray(mesh, "primitives")) {
+      if (getInt(primitive, "mode", TRIANGLES) != TRIANGLES)
+        continue; // points and lines have no place in a triangle mesh
+      const json &attributes = primitive.contains("attributes") ? primitive["attributes"] : json::object();
+      Primitive result;
+      result.position = static_cast<int>(getInt(attributes, "POSITION", -1));
+      result.normal = static_cast<int>(getInt(attributes, "NORMAL", -1));
+      result.texCoord = static_cast<int>(getInt(attributes, "TEXCOORD_0", -1));
+      result.indices = static_cast<int>(getInt(primitive, "indices", -1));
+      if (isFloatVector(findAccessor(asset, result.position), 3))
+        info.primitives.push_back(result);
+      else
+        std::cerr << "[GltfLoader] Skipping primitive without float positions in " << path << std::endl;
+    }
+    asset.meshes.push_back(std::move(info));
+  }
+
+  // Default scene, or every root node when the file names none
+  const json &nodes = getArray(document, "nodes");
+  const json &scenes = getArray(document, "scenes");
+  int64_t scene = getInt(document, "scene", 0);
+  if (scene >= 0 && scene < static_cast<int64_t>(scenes.size())) {
+    for (const json &root : getArray(scenes[scene], "nodes"))
+      if (root.is_number_integer())
+        addInstances(nodes, root.get<int64_t>(), glm::mat4(1.0f), 0, asset);
+  } else {
+    std::vector<bool> isChild(nodes.size(), false);
+    for (const json &node : nodes)
+      for (const json &child : getArray(node, "children"))
+        if (child.is_number_integer() && child.get<int64_t>() >= 0 && child.get<size_t>() < nodes.size())
+          isChild[child.get<size_t>()] = true;
+    for (size_t i = 0; i < nodes.size(); ++i)
+      if (!isChild[i])
+        addInstances(nodes, static_cast<int64_t>(i), glm::mat4(1.0f), 0, asset);
+  }
+  return true;
+}
+
+std::unique_ptr<Mesh> GltfLoader::createMesh(const Asset &asset, uint32_t meshIndex, bool *zeroCopy) {
+  if (zeroCopy)
+    *zeroCopy = false;
+  if (meshIndex >= asset.meshes.size() || asset.meshes[meshIndex].primitives.empty())
+    return nullptr;
+  PROFILE_ZONE("CreateGltfMesh");
+  const std::vector<Primitive> &primitives = asset.meshes[meshIndex].primitives;
+  const Primitive &first = primitives[0];
+
+  // Zero-copy: every primitive draws from the same float attributes, which become one GL buffer holding the
+  // byte range of the binary chunk that spans them, each attribute with its own offset and stride
+  const Accessor *position = findAccessor(asset, first.position);
+  const Accessor *normal = findAccessor(asset, first.normal);
+  const Accessor *texCoord = findAccessor(asset, first.texCoord);
+  bool sharedAttributes = true;
+  for (const Primitive &primitive : primitives)
+    sharedAttributes &= primitive.position == first.position && primitive.normal == first.normal &&
+                        primitive.texCoord == first.texCoord;
+  bool matchingLayout = (!normal || (isFloatVector(normal, 3) && normal->count == position->count)) &&
+                        (!texCoord || (isFloatVector(texCoord, 2) && texCoord->count == position->count));
+
+  if (sharedAttributes && matchingLayout && position->hasBounds) {
+    const uint32_t vertexCount = static_cast<uint32_t>(position->count);
+    size_t start = position->offset, end = 0;
+    std::vector<std::pair<const Accessor *, uint32_t>> attributes = {{position, 0}};
+    if (normal)
+      attributes.push_back({normal, 1});
+    if (texCoord)
+      attributes.push_back({texCoord, 2});
+    for (const auto &[accessor, location] : attributes) {
+      start = std::min(start, accessor->offset);
+      end = std::max(end, accessor->offset + accessor->stride * (accessor->count - 1) +
+                              accessor->components * sizeof(float));
+    }
+
+    std::vector<VertexAttribute> layout;
+    for (const auto &[accessor, location] : attributes)
+      layout.push_back({location, accessor->components, AttributeType::Float, false, accessor->offset - start,
+                        accessor->stride});
+
+    // Indices go straight from the file too when a single primitive stores them as tight 32-bit values
+    std::vector<uint32_t> indices;
+    std::vector<Submesh> submeshes;
+    const Accessor *indexAccessor = findAccessor(asset, first.indices);
+    const uint32_t *indexData = nullptr;
+    size_t indexCount = 0;
+    if (primitives.size() == 1 && indexAccessor && indexAccessor->componentType == UNSIGNED_INT &&
+        indexAccessor->components == 1 && indexAccessor->stride == sizeof(uint32_t) &&
+        indexAccessor->offset % alignof(uint32_t) == 0) {
+      indexData = reinterpret_cast<const uint32_t *>(asset.binary + indexAccessor->offset);
+      indexCount = indexAccessor->count / 3 * 3;
+      submeshes.push_back({0, static_cast<uint32_t>(indexCount)});
+    } else {
+      for (const Primitive &primitive : primitives) {
+        if (primitive.indices >= 0 && !isIndexAccessor(findAccessor(asset, primitive.indices)))
+          continue;
+        appendIndices(asset, primitive, 0, vertexCount, indices, submeshes);
+      }
+      indexData = indices.data();
+      indexCount = indices.size();
+    }
+
+    if (indexCount > 0) {
+      auto mesh = std::make_unique<Mesh>();
+      mesh->uploadExternal(asset.binary + start, end - start, vertexCount, layout, indexData, indexCount,
+                           std::move(submeshes), position->min, position->max);
+      if (zeroCopy)
+        *zeroCopy = true;
+      return mesh;
+    }
+  }
+
+  // Repack: convert each primitive into engine vertices, appended one after another
+  std::vector<Vertex> vertices;
+  std::vector<uint32_t> indices;
+  std::vector<Submesh> submeshes;
+  for (const Primitive &primitive : primitives) {
+    const Accessor *positions = findAccessor(asset, primitive.position);
+    const Accessor *normals = findAccessor(asset, primitive.normal);
+    const Accessor *texCoords = findAccessor(asset, primitive.texCoord);
+    if ((primitive.indices >= 0 && !isIndexAccessor(findAccessor(asset, primitive.indices))) ||
+        (normals && !isFloatVector(normals, 3)) || (texCoords && !isFloatVector(texCoords, 2))) {
+      std::cerr << "[GltfLoader] Skipping primitive with unsupported attribute types" << std::endl;
+      continue;
+    }
+
+    const uint32_t baseVertex = static_cast<uint32_t>(vertices.size());
+    for (size_t i = 0; i < positions->count; ++i) {
+      Vertex vertex{};
+      vertex.position = readFloats<glm::vec3>(asset, *positions, i);
+      if (normals && i < normals->count)
+        vertex.normal = readFloats<glm::vec3>(asset, *normals, i);
+      if (texCoords && i < texCoords->count)
+        vertex.texCoord = readFloats<glm::vec2>(asset, *texCoords, i);
+      vertices.push_back(vertex);
+    }
+    appendIndices(asset, primitive, baseVertex, static_cast<uint32_t>(positions->count), indices, submeshes);
+  }
+  if (indices.empty())
+    return nullptr;
+  return std::make_unique<Mesh>(std::move(vertices), std::move(indices), std::move(submeshes),
+                                MeshResidency::GpuOnly);
+}
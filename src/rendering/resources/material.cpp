@@ -1,142 +1,123 @@
 #define STB_IMAGE_IMPLEMENTATION
 #include "rendering/resources/material.h"
+#include "foundation/core/fileUtils.h"
+#include "rendering/resources/textureImporter.h"
 #include <iostream>
 #include <stb_image/stb_image.h>
-#include <vector>
 
-static const std::vector<std::string> kSupportedExtensions = {".png", ".jpg", ".jpeg", ".bmp", ".tga"};
-
-// Default constructor: auto-init with PBR fallbacks
+// Default constructor: shared PBR fallbacks
 Material::Material() {
-  std::array<unsigned char, 3> diffuseGray = {128, 128, 128};
-  std::array<unsigned char, 3> specularGray = {64, 64, 64};
-  std::array<unsigned char, 3> black = {0, 0, 0};
-  std::array<unsigned char, 3> normalBlue = {128, 128, 255};
-
-  m_diffuse = createFallbackTexture(diffuseGray);
-  m_specular = createFallbackTexture(specularGray);
-  m_normal = createFallbackTexture(normalBlue);
-  m_emission = createFallbackTexture(black);
-  m_shininess = 16.0f;
-  m_shaderHandle = 0;
+  for (size_t slot = 0; slot < m_textures.size(); ++slot)
+    m_textures[slot] = getFallbackTexture(static_cast<MaterialSlot>(slot));
+}
+
+Material::Material(uint32_t diffuse, uint32_t specular, uint32_t normal, uint32_t emission, float shininess)
+    : m_textures{diffuse, specular, normal, emission}, m_shininess(shininess) {}
+
+bool Material::operator==(const Material &other) const {
+  return m_textures == other.m_textures && m_shininess == other.m_shininess &&
+         m_shaderHandle == other.m_shaderHandle;
 }
 
-Material::Material(GLuint diffuse, GLuint specular, GLuint normal, GLuint emission, float shininess)
-    : m_diffuse(diffuse), m_specular(specular), m_normal(normal), m_emission(emission), m_shininess(shininess) {}
+uint64_t Material::getHash() const {
+  uint64_t hash = FileUtils::hashData(m_textures.data(), sizeof(m_textures));
+  hash = FileUtils::hashData(&m_shininess, sizeof(m_shininess), hash);
+  return FileUtils::hashData(&m_shaderHandle, sizeof(m_shaderHandle), hash);
+}
 
 // Getters
-GLuint Material::getDiffuse() const { return m_diffuse; }
-GLuint Material::getSpecular() const { return m_specular; }
-GLuint Material::getNormal() const { return m_normal; }
-GLuint Material::getEmission() const { return m_emission; }
+uint32_t Material::getDiffuse() const { return getTexture(MaterialSlot::Diffuse); }
+uint32_t Material::getSpecular() const { return getTexture(MaterialSlot::Specular); }
+uint32_t Material::getNormal() const { return getTexture(MaterialSlot::Normal); }
+uint32_t Material::getEmission() const { return getTexture(MaterialSlot::Emission); }
 float Material::getShininess() const { return m_shininess; }
 uint32_t Material::getShaderHandle() const { return m_shaderHandle; }
+uint32_t Material::getTexture(MaterialSlot slot) const { return m_textures[static_cast<size_t>(slot)]; }
+bool Material::hasNormalMap() const {
+  uint32_t normal = getNormal();
+  return normal != 0 && normal != getFallbackTexture(MaterialSlot::Normal);
+}
 
 // Setters (direct texture ID)
-void Material::setDiffuseTexture(GLuint texture) { m_diffuse = texture; }
-void Material::setSpecularTexture(GLuint texture) { m_specular = texture; }
-void Material::setNormalTexture(GLuint texture) { m_normal = texture; }
-void Material::setEmissionTexture(GLuint texture) { m_emission = texture; }
+void Material::setDiffuseTexture(uint32_t texture) { setTexture(MaterialSlot::Diffuse, texture); }
+void Material::setSpecularTexture(uint32_t texture) { setTexture(MaterialSlot::Specular, texture); }
+void Material::setNormalTexture(uint32_t texture) { setTexture(MaterialSlot::Normal, texture); }
+void Material::setEmissionTexture(uint32_t texture) { setTexture(MaterialSlot::Emission, texture); }
+void Material::setTexture(MaterialSlot slot, uint32_t texture) { m_textures[static_cast<size_t>(slot)] = texture; }
 
 // Setters (load from path)
 void Material::setDiffuse(const std::string &path) {
-  GLuint tex = loadTexture(path);
+  uint32_t tex = loadTexture(path);
   if (tex != 0)
-    m_diffuse = tex;
+    setDiffuseTexture(tex);
 }
 
 void Material::setSpecular(const std::string &path) {
-  GLuint tex = loadTexture(path);
+  uint32_t tex = loadTexture(path);
   if (tex != 0)
-    m_specular = tex;
+    setSpecularTexture(tex);
 }
 
 void Material::setNormal(const std::string &path) {
-  GLuint tex = loadTexture(path);
+  uint32_t tex = loadTexture(path, TextureUsage::Normal);
   if (tex != 0)
-    m_normal = tex;
+    setNormalTexture(tex);
 }
 
 void Material::setEmission(const std::string &path) {
-  GLuint tex = loadTexture(path);
+  uint32_t tex = loadTexture(path);
   if (tex != 0)
-    m_emission = tex;
+    setEmissionTexture(tex);
 }
 
 void Material::setShininess(float shine) { m_shininess = shine; }
 void Material::setShaderHandle(uint32_t handle) { m_shaderHandle = handle; }
 
 // Create 1x1 fallback texture
-GLuint Material::createFallbackTexture(const std::array<unsigned char, 3> &color) {
-  GLuint textureID;
-  glGenTextures(1, &textureID);
-  glBindTexture(GL_TEXTURE_2D, textureID);
-  glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB, 1, 1, 0, GL_RGB, GL_UNSIGNED_BYTE, color.data());
-  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
-  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
-  return textureID;
+uint32_t Material::createFallbackTexture(const std::array<unsigned char, 3> &color) {
+  return RenderBackend::get().createTexture2D(1, 1, TextureFormat::RGB8, color.data(), false);
 }
 
-// Load texture from file (with extension fallback)
-GLuint Material::loadTexture(const std::filesystem::path &path) {
-  std::string foundPath;
-
-  // Try supported extensions
-  if (!path.empty()) {
-    for (const auto &ext : kSupportedExtensions) {
-      auto candidate = path;
-      candidate += ext;
-      if (std::filesystem::exists(candidate)) {
-        foundPath = candidate.string();
-        break;
-      }
-    }
-  }
+uint32_t Material::getFallbackTexture(MaterialSlot slot) {
+  static const std::array<uint32_t, static_cast<size_t>(MaterialSlot::Count)> textures = {
+      createFallbackTexture({128, 128, 128}), createFallbackTexture({64, 64, 64}),
+      createFallbackTexture({128, 128, 255}), createFallbackTexture({0, 0, 0})};
+  return textures[static_cast<size_t>(slot)];
+}
 
-  GLuint textureID = 0;
-  bool hasMipmap = false;
-  stbi_set_flip_vertically_on_load(true);
-
-  // Load image if found
-  if (!foundPath.empty()) {
-    int width, height, channels;
-    unsigned char *data = stbi_load(foundPath.c_str(), &width, &height, &channels, 0);
-    if (data) {
-      glGenTextures(1, &textureID);
-      glBindTexture(GL_TEXTURE_2D, textureID);
-      GLenum format = (channels == 4 ? GL_RGBA : GL_RGB);
-      glTexImage2D(GL_TEXTURE_2D, 0, format, width, height, 0, format, GL_UNSIGNED_BYTE, data);
-      glGenerateMipmap(GL_TEXTURE_2D);
-      hasMipmap = true;
-      stbi_image_free(data);
-    } else {
-      std::cerr << "[Material] Failed to load " << foundPath << ": " << stbi_failure_reason() << std::endl;
-    }
-  } else if (!path.empty()) {
-    std::cerr << "[Material] File not found: " << path << std::endl;
+// Decode image file (with extension fallback) through the importer; safe to call from worker threads
+bool Material::decodeTexture(const std::filesystem::path &path, TextureImage &image, TextureUsage usage,
+                             JobSystem *jobSystem) {
+  std::string foundPath = TextureImporter::findFile(path, usage);
+  if (foundPath.empty()) {
+    if (!path.empty())
+      std::cerr << "[Material] File not found: " << path << std::endl;
+    return false;
   }
+  return TextureImporter::import(foundPath, usage, image, jobSystem);
+}
 
-  // Fallback to magenta if loading failed
-  if (textureID == 0) {
-    unsigned char magenta[3] = {255, 0, 255};
-    glGenTextures(1, &textureID);
-    glBindTexture(GL_TEXTURE_2D, textureID);
-    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB, 1, 1, 0, GL_RGB, GL_UNSIGNED_BYTE, magenta);
-    hasMipmap = false;
-  }
+uint32_t Material::uploadTexture(const TextureImage &image) {
+  RenderBackend &backend = RenderBackend::get();
+  if (image.getLevelCount() == 1 && !isCompressedFormat(image.format))
+    return backend.createTexture2D(image.width, image.height, image.format, image.getLevel(0), true);
+
+  // Full mip chain (CPU-built or block-compressed): allocate the levels and upload each one
+  uint32_t texture = backend.createTexture2D(1, 1, TextureFormat::RGBA8, nullptr, false);
+  backend.allocateTexture2D(texture, image.width, image.height, image.format, image.getLevelCount());
+  for (int level = 0; level < image.getLevelCount(); ++level)
+    backend.uploadTextureLevel(texture, level, image.getLevelWidth(level), image.getLevelHeight(level), image.format,
+                               image.getLevel(level));
+  backend.setTextureBaseLevel(texture, 0);
+  return texture;
+}
 
-  // Set texture parameters
-  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
-  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
-  if (hasMipmap) {
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-  } else {
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-  }
+// Load texture from file, magenta if it cannot be decoded
+uint32_t Material::loadTexture(const std::filesystem::path &path, TextureUsage usage, JobSystem *jobSystem) {
+  TextureImage image;
+  if (decodeTexture(path, image, usage, jobSystem))
+    return uploadTexture(image);
 
-  return textureID;
+  unsigned char magenta[3] = {255, 0, 255};
+  return RenderBackend::get().createTexture2D(1, 1, TextureFormat::RGB8, magenta, false);
 }
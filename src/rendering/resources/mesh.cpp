@@ -1,121 +1,390 @@
-#define TINYOBJLOADER_IMPLEMENTATION
 #include "rendering/resources/mesh.h"
+#include "foundation/core/profiler.h"
+#include "rendering/geometry/meshOptimizer.h"
+#include "rendering/geometry/meshSimplifier.h"
+#include "rendering/geometry/objParser.h"
+#include "rendering/geometry/vertexPacking.h"
+#include "rendering/resources/meshCache.h"
+#include <algorithm>
 #include <iostream>
-#include <tiny_obj_loader/tiny_obj_loader.h>
+#include <limits>
 
-// Constructor: load from OBJ file
-Mesh::Mesh(const std::string &filename) {
-  if (!loadOBJ(filename)) {
+// Constructor: load and upload in one go
+Mesh::Mesh(const std::string &filename, JobSystem *jobSystem) {
+  if (load(filename, jobSystem))
+    upload();
+}
+
+// Load from the mesh cache, or import the OBJ file and cache the result. No GPU access.
+// The cache holds the packed vertices, so only an import packs; background loads leave just the buffer upload
+// to the render thread.
+bool Mesh::load(const std::string &filename, JobSystem *jobSystem) {
+  m_sourcePath = filename;
+  if (loadCached(filename))
+    return true;
+
+  if (!loadOBJ(filename, jobSystem)) {
     std::cerr << "[Mesh] Failed to load: " << filename << std::endl;
+    return false;
+  }
+
+  packVertices();
+  if (!MeshCache::write(filename, m_vertexData, m_packedData, m_vertexCount, m_indexData, m_indexCount, m_submeshes,
+                        m_boundsMin, m_boundsMax))
+    std::cerr << "[Mesh] Could not cache: " << filename << std::endl;
+  if (!EngineConfig::MESH_PACK_VERTICES) {
+    std::vector<PackedVertex>().swap(m_packedVertices);
+    m_packedData = nullptr;
   }
+  return true;
+}
+
+void Mesh::upload() { setupBuffers(); }
+
+bool Mesh::isUploaded() const { return m_buffers.vertexArray != 0; }
+
+size_t Mesh::getUploadBytes() const {
+  size_t vertexStride = EngineConfig::MESH_PACK_VERTICES ? sizeof(PackedVertex) : sizeof(Vertex);
+  size_t vertexBytes = m_externalVertexBytes ? m_externalVertexBytes : m_vertexCount * vertexStride;
+  return vertexBytes + m_indexCount * sizeof(uint32_t);
+}
+
+void Mesh::uploadExternal(const void *vertices, size_t vertexBytes, size_t vertexCount,
+                          const std::vector<VertexAttribute> &layout, const uint32_t *indices, size_t indexCount,
+                          std::vector<Submesh> submeshes, const glm::vec3 &boundsMin, const glm::vec3 &boundsMax) {
+  auto &backend = RenderBackend::get();
+  if (m_buffers.vertexArray != 0)
+    backend.destroyMeshBuffers(m_buffers);
+  releaseCpuData();
+  m_sourcePath.clear();
+  m_residency = MeshResidency::GpuOnly;
+
+  m_vertexCount = vertexCount;
+  m_indexCount = indexCount;
+  m_externalVertexBytes = vertexBytes;
+  m_submeshes = std::move(submeshes);
+  m_boundsMin = boundsMin;
+  m_boundsMax = boundsMax;
+  m_positionScale = glm::vec3(1.0f);
+  m_positionOffset = glm::vec3(0.0f);
+  m_buffers = backend.createMeshBuffers(vertices, vertexBytes, 0, layout, indices, indexCount);
+}
+
+size_t Mesh::getCpuBytes() const {
+  return m_vertices.capacity() * sizeof(Vertex) + m_indices.capacity() * sizeof(uint32_t) + m_mapping.getSize() +
+         m_packedVertices.capacity() * sizeof(PackedVertex) + m_positions.capacity() * sizeof(glm::vec3) +
+         m_submeshes.capacity() * sizeof(Submesh);
 }
 
+size_t Mesh::getGpuBytes() const { return isUploaded() ? getUploadBytes() : 0; }
+
+bool Mesh::setResidency(MeshResidency residency) {
+  m_residency = residency;
+  return applyResidency();
+}
+
+MeshResidency Mesh::getResidency() const { return m_residency; }
+
 // Constructor: direct vertex/index data
-Mesh::Mesh(const std::vector<Vertex> &vertices, const std::vector<uint32_t> &indices,
-           const std::vector<Submesh> &submeshes)
-    : m_vertices(vertices), m_indices(indices), m_submeshes(submeshes) {
+Mesh::Mesh(std::vector<Vertex> vertices, std::vector<uint32_t> indices, std::vector<Submesh> submeshes,
+           MeshResidency residency)
+    : m_residency(residency), m_vertices(std::move(vertices)), m_indices(std::move(indices)),
+      m_submeshes(std::move(submeshes)) {
+  useOwnedGeometry();
+  computeBounds();
   setupBuffers();
 }
 
 Mesh::~Mesh() {
-  glDeleteVertexArrays(1, &m_VAO);
-  glDeleteBuffers(1, &m_VBO);
-  glDeleteBuffers(1, &m_EBO);
+  if (m_buffers.vertexArray != 0)
+    RenderBackend::get().destroyMeshBuffers(m_buffers);
 }
 
-// Setup OpenGL buffers (VAO/VBO/EBO)
+// Point the geometry view at the owned vectors
+void Mesh::useOwnedGeometry() {
+  m_mapping.close();
+  std::vector<PackedVertex>().swap(m_packedVertices);
+  m_packedData = nullptr;
+  m_vertexData = m_vertices.data();
+  m_vertexCount = m_vertices.size();
+  m_indexData = m_indices.data();
+  m_indexCount = m_indices.size();
+}
+
+// Drop every CPU copy of the geometry; counts, bounds and submeshes stay
+void Mesh::releaseCpuData() {
+  std::vector<Vertex>().swap(m_vertices);
+  std::vector<uint32_t>().swap(m_indices);
+  std::vector<glm::vec3>().swap(m_positions);
+  std::vector<PackedVertex>().swap(m_packedVertices);
+  m_mapping.close();
+  m_packedData = nullptr;
+  m_vertexData = nullptr;
+  m_indexData = nullptr;
+}
+
+// Map the full geometry back from the mesh cache after it was released
+bool Mesh::restoreCpuData() {
+  if (m_vertexData && m_indexData)
+    return true;
+
+  if (m_sourcePath.empty())
+    return false; // built in memory or uploaded from external data: nothing to restore from
+
+  MeshCache::View view;
+  if (!MeshCache::open(m_sourcePath, view) || view.header->vertexCount != m_vertexCount ||
+      view.header->indexCount != m_indexCount) {
+    std::cerr << "[Mesh] Cannot restore released geometry " << m_sourcePath << std::endl;
+    return false;
+  }
+  releaseCpuData();
+  m_vertexData = view.vertices;
+  m_indexData = view.indices;
+  m_mapping = std::move(view.file);
+  return true;
+}
+
+// Trim the CPU copy of an uploaded mesh to its residency
+bool Mesh::applyResidency() {
+  if (!isUploaded())
+    return true;
+
+  switch (m_residency) {
+  case MeshResidency::GpuOnly:
+    releaseCpuData();
+    return true;
+  case MeshResidency::CpuAndGpu:
+    return restoreCpuData();
+  case MeshResidency::CpuPositions: {
+    if (!m_positions.empty())
+      return true;
+    if (!restoreCpuData())
+      return false;
+
+    std::vector<glm::vec3> positions(m_vertexCount);
+    for (size_t i = 0; i < m_vertexCount; ++i)
+      positions[i] = m_vertexData[i].position;
+    // Owned indices move over; mapped ones are copied before the mapping closes
+    std::vector<uint32_t> indices = m_indexData == m_indices.data() ? std::move(m_indices)
+                                                                    : std::vector<uint32_t>(m_indexData,
+                                                                                            m_indexData + m_indexCount);
+    releaseCpuData();
+    m_positions = std::move(positions);
+    m_indices = std::move(indices);
+    m_indexData = m_indices.data();
+    return true;
+  }
+  }
+  return false;
+}
+
+// Packed copy of the vertices for the next upload and the mesh cache (any thread)
+void Mesh::packVertices() {
+  m_packedVertices = VertexPacking::packVertices(m_vertexData, m_vertexCount, m_boundsMin, m_boundsMax);
+  m_packedData = m_packedVertices.data();
+}
+
+// Upload vertex/index data to GPU buffers
 void Mesh::setupBuffers() {
-  if (m_vertices.empty() || m_indices.empty()) {
+  if (m_vertexCount == 0 || m_indexCount == 0) {
     std::cerr << "[Mesh] No vertices or indices to setup\n";
     return;
   }
 
-  // VAO
-  glGenVertexArrays(1, &m_VAO);
-  glBindVertexArray(m_VAO);
-
-  // VBO
-  glGenBuffers(1, &m_VBO);
-  glBindBuffer(GL_ARRAY_BUFFER, m_VBO);
-  glBufferData(GL_ARRAY_BUFFER, m_vertices.size() * sizeof(Vertex), m_vertices.data(), GL_STATIC_DRAW);
+  auto &backend = RenderBackend::get();
+  if (EngineConfig::MESH_PACK_VERTICES) {
+    // Packed attributes: normalized unorm16 position (decoded with the bounds), snorm normal, half UV
+    static const std::vector<VertexAttribute> packedLayout = {
+        {0, 3, AttributeType::UnsignedShort, true, offsetof(PackedVertex, position)},
+        {1, 4, AttributeType::Int2101010, true, offsetof(PackedVertex, normal)},
+        {2, 2, AttributeType::HalfFloat, false, offsetof(PackedVertex, texCoord)},
+    };
 
-  // EBO
-  glGenBuffers(1, &m_EBO);
-  glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_EBO);
-  glBufferData(GL_ELEMENT_ARRAY_BUFFER, m_indices.size() * sizeof(uint32_t), m_indices.data(), GL_STATIC_DRAW);
+    PositionDecode decode = VertexPacking::getPositionDecode(m_boundsMin, m_boundsMax);
+    m_positionScale = decode.scale;
+    m_positionOffset = decode.offset;
+    if (!m_packedData)
+      packVertices(); // built in memory
+    m_buffers = backend.createMeshBuffers(m_packedData, m_vertexCount * sizeof(PackedVertex), sizeof(PackedVertex),
+                                          packedLayout, m_indexData, m_indexCount);
+    std::vector<PackedVertex>().swap(m_packedVertices);
+    m_packedData = nullptr;
+    applyResidency();
+    return;
+  }
 
   // Vertex attributes: position, normal, texCoord
-  glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void *)offsetof(Vertex, position));
-  glEnableVertexAttribArray(0);
+  static const std::vector<VertexAttribute> layout = {
+      {0, 3, AttributeType::Float, false, offsetof(Vertex, position)},
+      {1, 3, AttributeType::Float, false, offsetof(Vertex, normal)},
+      {2, 2, AttributeType::Float, false, offsetof(Vertex, texCoord)},
+  };
+
+  m_positionScale = glm::vec3(1.0f);
+  m_positionOffset = glm::vec3(0.0f);
+  m_buffers = backend.createMeshBuffers(m_vertexData, m_vertexCount * sizeof(Vertex), sizeof(Vertex), layout,
+                                        m_indexData, m_indexCount);
+  applyResidency();
+}
+
+void Mesh::computeBounds() {
+  if (m_vertexCount == 0) {
+    m_boundsMin = m_boundsMax = glm::vec3(0.0f);
+    return;
+  }
+
+  m_boundsMin = glm::vec3(std::numeric_limits<float>::max());
+  m_boundsMax = glm::vec3(std::numeric_limits<float>::lowest());
+  for (size_t i = 0; i < m_vertexCount; ++i) {
+    m_boundsMin = glm::min(m_boundsMin, m_vertexData[i].position);
+    m_boundsMax = glm::max(m_boundsMax, m_vertexData[i].position);
+  }
+}
 
-  glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void *)offsetof(Vertex, normal));
-  glEnableVertexAttribArray(1);
+// Weld duplicate vertices, order triangles per submesh for the post-transform cache
+// and vertices by first use for fetch locality
+void Mesh::optimizeGeometry() {
+  m_vertices = MeshOptimizer::deduplicateVertices(m_vertices, m_indices);
+  m_importStats.vertices = static_cast<uint32_t>(m_vertices.size());
+  m_importStats.acmrBefore = MeshOptimizer::computeAcmr(m_indices.data(), m_indices.size(), m_vertices.size());
 
-  glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void *)offsetof(Vertex, texCoord));
-  glEnableVertexAttribArray(2);
+  for (const auto &submesh : m_submeshes)
+    MeshOptimizer::optimizeVertexCache(m_indices.data() + submesh.indexStart, submesh.indexCount, m_vertices.size());
+  MeshOptimizer::optimizeVertexFetch(m_vertices, m_indices);
 
-  glBindVertexArray(0);
+  m_importStats.acmrAfter = MeshOptimizer::computeAcmr(m_indices.data(), m_indices.size(), m_vertices.size());
 }
 
-GLuint Mesh::getVAO() const { return m_VAO; }
+// Build the LOD chain per submesh; simplified indices are appended after the source indices
+void Mesh::generateLods() {
+  std::vector<uint32_t> lodIndices;
+  const uint32_t baseCount = static_cast<uint32_t>(m_indices.size());
+
+  for (auto &submesh : m_submeshes) {
+    submesh.lodCount = 1;
+    std::vector<uint32_t> previous(m_indices.begin() + submesh.indexStart,
+                                   m_indices.begin() + submesh.indexStart + submesh.indexCount);
+
+    for (uint32_t level = 1; level < EngineConfig::MESH_LOD_COUNT; ++level) {
+      size_t target = static_cast<size_t>(previous.size() * EngineConfig::MESH_LOD_REDUCTION) / 3 * 3;
+      std::vector<uint32_t> simplified = MeshSimplifier::simplify(m_vertices, previous.data(), previous.size(), target,
+                                                                  EngineConfig::MESH_LOD_MAX_ERROR);
+
+      // Not worth another level
+      if (simplified.empty() ||
+          simplified.size() > previous.size() * (1.0f - EngineConfig::MESH_LOD_MIN_SAVING))
+        break;
+
+      MeshOptimizer::optimizeVertexCache(simplified.data(), simplified.size(), m_vertices.size());
+      submesh.lods[level - 1] = {baseCount + static_cast<uint32_t>(lodIndices.size()),
+                                 static_cast<uint32_t>(simplified.size())};
+      submesh.lodCount = level + 1;
+      lodIndices.insert(lodIndices.end(), simplified.begin(), simplified.end());
+      previous = std::move(simplified);
+    }
+  }
+
+  m_indices.insert(m_indices.end(), lodIndices.begin(), lodIndices.end());
+}
+
+const MeshImportStats &Mesh::getImportStats() const { return m_importStats; }
+
+uint32_t Mesh::getVAO() const { return m_buffers.vertexArray; }
 
 const std::vector<Submesh> &Mesh::getSubmeshes() const { return m_submeshes; }
 
-void Mesh::setVerticesIndices(const std::vector<Vertex> &vertices, const std::vector<uint32_t> &indices,
-                              const std::vector<Submesh> &submeshes) {
-  m_vertices = vertices;
-  m_indices = indices;
-  m_submeshes = submeshes;
-  setupBuffers();
+const Vertex *Mesh::getVertexData() const { return m_vertexData; }
+
+size_t Mesh::getVertexCount() const { return m_vertexCount; }
+
+const uint32_t *Mesh::getIndexData() const { return m_indexData; }
+
+const glm::vec3 *Mesh::getPositionData() const {
+  if (!m_positions.empty())
+    return m_positions.data();
+  return m_vertexData ? &m_vertexData->position : nullptr;
 }
 
-// Load OBJ using tinyobjloader
-bool Mesh::loadOBJ(const std::string &filename) {
-  tinyobj::attrib_t attrib;
-  std::vector<tinyobj::shape_t> shapes;
-  std::vector<tinyobj::material_t> materials;
-  std::string err;
-  std::string baseDir = filename.substr(0, filename.find_last_of("/\\") + 1);
+size_t Mesh::getPositionStride() const { return m_positions.empty() ? sizeof(Vertex) : sizeof(glm::vec3); }
 
-  bool success = tinyobj::LoadObj(&attrib, &shapes, &materials, &err, filename.c_str(), baseDir.c_str());
+size_t Mesh::getIndexCount() const { return m_indexCount; }
 
-  if (!err.empty())
-    std::cerr << "[Mesh] " << err << std::endl;
+uint32_t Mesh::getLodCount() const {
+  uint32_t count = 1;
+  for (const auto &submesh : m_submeshes)
+    count = std::max(count, submesh.lodCount);
+  return count;
+}
 
-  if (!success)
-    return false;
+glm::vec3 Mesh::getBoundsMin() const { return m_boundsMin; }
 
-  // Build vertices/indices per shape (submesh)
-  for (const auto &shape : shapes) {
-    uint32_t submeshStart = static_cast<uint32_t>(m_indices.size());
+glm::vec3 Mesh::getBoundsMax() const { return m_boundsMax; }
 
-    for (const auto &idx : shape.mesh.indices) {
-      Vertex vertex{};
+glm::vec3 Mesh::getPositionScale() const { return m_positionScale; }
 
-      // Position
-      vertex.position = {attrib.vertices[3 * idx.vertex_index + 0], attrib.vertices[3 * idx.vertex_index + 1],
-                         attrib.vertices[3 * idx.vertex_index + 2]};
+glm::vec3 Mesh::getPositionOffset() const { return m_positionOffset; }
 
-      // Normal
-      if (idx.normal_index >= 0) {
-        vertex.normal = {attrib.normals[3 * idx.normal_index + 0], attrib.normals[3 * idx.normal_index + 1],
-                         attrib.normals[3 * idx.normal_index + 2]};
-      }
+void Mesh::setVerticesIndices(std::vector<Vertex> vertices, std::vector<uint32_t> indices,
+                              std::vector<Submesh> submeshes) {
+  m_sourcePath.clear();
+  m_positions.clear();
+  m_externalVertexBytes = 0;
+  m_vertices = std::move(vertices);
+  m_indices = std::move(indices);
+  m_submeshes = std::move(submeshes);
+  useOwnedGeometry();
+  computeBounds();
+  setupBuffers();
+}
 
-      // TexCoord (flip Y for OpenGL)
-      if (idx.texcoord_index >= 0) {
-        vertex.texCoord = {attrib.texcoords[2 * idx.texcoord_index + 0],
-                           1.0f - attrib.texcoords[2 * idx.texcoord_index + 1]};
-      }
+// Map the cached import; upload() later reads straight from the mapped pages
+bool Mesh::loadCached(const std::string &filename) {
+  PROFILE_ZONE("LoadMeshCache");
+  MeshCache::View view;
+  if (!MeshCache::open(filename, view))
+    return false;
 
-      m_vertices.push_back(vertex);
-      m_indices.push_back(static_cast<uint32_t>(m_vertices.size() - 1));
-    }
+  const MeshCache::Header &header = *view.header;
+  m_submeshes.assign(view.submeshes, view.submeshes + header.submeshCount);
+  m_boundsMin = glm::vec3(header.boundsMin[0], header.boundsMin[1], header.boundsMin[2]);
+  m_boundsMax = glm::vec3(header.boundsMax[0], header.boundsMax[1], header.boundsMax[2]);
 
-    uint32_t submeshCount = static_cast<uint32_t>(m_indices.size()) - submeshStart;
-    m_submeshes.push_back({submeshStart, submeshCount});
+  m_vertexData = view.vertices;
+  m_packedData = view.packedVertices;
+  m_vertexCount = header.vertexCount;
+  m_indexData = view.indices;
+  m_indexCount = header.indexCount;
+  m_mapping = std::move(view.file);
+  return true;
+}
+
+// Import an OBJ file: parallel parse, corners welded by attribute indices
+bool Mesh::loadOBJ(const std::string &filename, JobSystem *jobSystem) {
+  ObjParser::Result obj;
+  {
+    PROFILE_ZONE("ParseOBJ");
+    if (!ObjParser::parse(filename, obj, jobSystem))
+      return false;
   }
 
-  setupBuffers();
+  m_vertices = std::move(obj.vertices);
+  m_indices = std::move(obj.indices);
+  m_submeshes = std::move(obj.submeshes);
+  m_importStats.sourceVertices = obj.cornerCount;
+
+  {
+    PROFILE_ZONE("OptimizeMesh");
+    optimizeGeometry();
+  }
+  std::cout << "[Mesh] " << filename << ": " << m_importStats.sourceVertices << " -> " << m_importStats.vertices
+            << " vertices, ACMR " << m_importStats.acmrBefore << " -> " << m_importStats.acmrAfter << std::endl;
+
+  {
+    PROFILE_ZONE("GenerateLods");
+    generateLods();
+  }
+
+  useOwnedGeometry();
+  computeBounds();
   return true;
 }
@@ -0,0 +1,128 @@
+#include "rendering/resources/meshCache.h"
+#include "foundation/core/assetPack.h"
+#include "foundation/core/config.h"
+#include "foundation/core/fileUtils.h"
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <type_traits>
+
+namespace fs = std::filesystem;
+
+static_assert(std::is_trivially_copyable_v<Submesh>, "Submesh is stored raw in the mesh cache");
+static_assert(std::is_trivially_copyable_v<Vertex>, "Vertex is stored raw in the mesh cache");
+static_assert(std::is_trivially_copyable_v<PackedVertex>, "PackedVertex is stored raw in the mesh cache");
+
+namespace {
+constexpr char MAGIC[4] = {'M', 'S', 'H', 'C'};
+constexpr uint64_t ALIGNMENT = 16;
+
+uint64_t alignUp(uint64_t offset) { return (offset + ALIGNMENT - 1) & ~(ALIGNMENT - 1); }
+} // namespace
+
+std::string MeshCache::getCachePath(const std::string &sourcePath) {
+  char hash[17];
+  std::snprintf(hash, sizeof(hash), "%016llx", static_cast<unsigned long long>(FileUtils::hashPath(sourcePath)));
+  return std::string(EngineConfig::MESH_CACHE_PATH) + fs::path(sourcePath).stem().string() + "_" + hash + ".meshbin";
+}
+
+// Point view at a cache file image; false if it is not a complete cache of this format and importer
+static bool parse(const uint8_t *data, size_t size, MeshCache::View &view) {
+  using MeshCache::Header;
+  if (size < sizeof(Header))
+    return false;
+
+  const Header *header = reinterpret_cast<const Header *>(data);
+  if (std::memcmp(header->magic, MAGIC, sizeof(MAGIC)) != 0 || header->formatVersion != MeshCache::FORMAT_VERSION ||
+      header->importerVersion != MeshCache::IMPORTER_VERSION || header->vertexStride != sizeof(Vertex) ||
+      header->packedVertexStride != sizeof(PackedVertex) || header->submeshStride != sizeof(Submesh))
+    return false;
+
+  // Reject truncated files
+  uint64_t end = header->indexOffset + uint64_t(header->indexCount) * sizeof(uint32_t);
+  if (end > size || header->submeshOffset + uint64_t(header->submeshCount) * sizeof(Submesh) > size ||
+      header->vertexOffset + uint64_t(header->vertexCount) * sizeof(Vertex) > size ||
+      header->packedVertexOffset + uint64_t(header->vertexCount) * sizeof(PackedVertex) > size)
+    return false;
+
+  view.header = header;
+  view.submeshes = reinterpret_cast<const Submesh *>(data + header->submeshOffset);
+  view.vertices = reinterpret_cast<const Vertex *>(data + header->vertexOffset);
+  view.packedVertices = reinterpret_cast<const PackedVertex *>(data + header->packedVertexOffset);
+  view.indices = reinterpret_cast<const uint32_t *>(data + header->indexOffset);
+  return true;
+}
+
+bool MeshCache::open(const std::string &sourcePath, View &view) {
+  // Packed meshes are cooked ahead of time and trusted without a source file
+  AssetBlob blob;
+  if (AssetPack::get().find(sourcePath, AssetType::Mesh, blob))
+    return parse(blob.data, blob.size, view);
+
+  int64_t modified;
+  uint64_t size;
+  if (!FileUtils::getFileStamp(sourcePath, modified, size))
+    return false;
+
+  MappedFile file;
+  if (!file.open(getCachePath(sourcePath)) || !parse(file.getData(), file.getSize(), view))
+    return false;
+
+  const Header *header = view.header;
+  if (header->sourcePathHash != FileUtils::hashPath(sourcePath) || header->sourceModified != modified ||
+      header->sourceSize != size)
+    return false;
+
+  view.file = std::move(file);
+  return true;
+}
+
+bool MeshCache::write(const std::string &sourcePath, const Vertex *vertices, const PackedVertex *packedVertices,
+                      size_t vertexCount, const uint32_t *indices, size_t indexCount,
+                      const std::vector<Submesh> &submeshes, const glm::vec3 &boundsMin, const glm::vec3 &boundsMax) {
+  Header header{};
+  std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+  header.formatVersion = FORMAT_VERSION;
+  header.importerVersion = IMPORTER_VERSION;
+  header.vertexStride = sizeof(Vertex);
+  header.packedVertexStride = sizeof(PackedVertex);
+  header.submeshStride = sizeof(Submesh);
+  header.sourcePathHash = FileUtils::hashPath(sourcePath);
+  if (!FileUtils::getFileStamp(sourcePath, header.sourceModified, header.sourceSize))
+    return false;
+
+  header.submeshCount = static_cast<uint32_t>(submeshes.size());
+  header.vertexCount = static_cast<uint32_t>(vertexCount);
+  header.indexCount = static_cast<uint32_t>(indexCount);
+  for (int i = 0; i < 3; ++i) {
+    header.boundsMin[i] = boundsMin[i];
+    header.boundsMax[i] = boundsMax[i];
+  }
+  header.submeshOffset = alignUp(sizeof(Header));
+  header.vertexOffset = alignUp(header.submeshOffset + submeshes.size() * sizeof(Submesh));
+  header.packedVertexOffset = alignUp(header.vertexOffset + vertexCount * sizeof(Vertex));
+  header.indexOffset = alignUp(header.packedVertexOffset + vertexCount * sizeof(PackedVertex));
+
+  std::vector<uint8_t> file(header.indexOffset + indexCount * sizeof(uint32_t));
+  std::memcpy(file.data(), &header, sizeof(Header));
+  std::memcpy(file.data() + header.submeshOffset, submeshes.data(), submeshes.size() * sizeof(Submesh));
+  std::memcpy(file.data() + header.vertexOffset, vertices, vertexCount * sizeof(Vertex));
+  std::memcpy(file.data() + header.packedVertexOffset, packedVertices, vertexCount * sizeof(PackedVertex));
+  std::memcpy(file.data() + header.indexOffset, indices, indexCount * sizeof(uint32_t));
+  return FileUtils::writeFileAtomic(getCachePath(sourcePath), file.data(), file.size());
+}
+
+bool MeshCache::updateSourceStamp(const std::string &sourcePath) {
+  MappedFile file;
+  if (!file.open(getCachePath(sourcePath)) || file.getSize() < sizeof(Header) ||
+      std::memcmp(file.getData(), MAGIC, sizeof(MAGIC)) != 0)
+    return false;
+
+  std::vector<uint8_t> data(file.getData(), file.getData() + file.getSize());
+  file.close();
+  Header *header = reinterpret_cast<Header *>(data.data());
+  header->sourcePathHash = FileUtils::hashPath(sourcePath);
+  if (!FileUtils::getFileStamp(sourcePath, header->sourceModified, header->sourceSize))
+    return false;
+  return FileUtils::writeFileAtomic(getCachePath(sourcePath), data.data(), data.size());
+}
@@ -0,0 +1,95 @@
+#include "rendering/resources/mipGenerator.h"
+#include "foundation/core/profiler.h"
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define MIP_GENERATOR_SSE2
+#endif
+
+namespace {
+
+// Rounded mean of four bytes
+inline unsigned char average(unsigned a, unsigned b, unsigned c, unsigned d) {
+  return static_cast<unsigned char>((a + b + c + d + 2) >> 2);
+}
+
+#ifdef MIP_GENERATOR_SSE2
+// Four RGBA output texels from two rows of eight source texels; exact rounding in 16-bit lanes
+inline void downsampleRgba4(const unsigned char *row0, const unsigned char *row1, unsigned char *output) {
+  const __m128i zero = _mm_setzero_si128();
+  const __m128i two = _mm_set1_epi16(2);
+
+  __m128i a0 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(row0));
+  __m128i a1 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(row0 + 16));
+  __m128i b0 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(row1));
+  __m128i b1 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(row1 + 16));
+
+  // Vertical sums, two texels per register
+  __m128i s01 = _mm_add_epi16(_mm_unpacklo_epi8(a0, zero), _mm_unpacklo_epi8(b0, zero));
+  __m128i s23 = _mm_add_epi16(_mm_unpackhi_epi8(a0, zero), _mm_unpackhi_epi8(b0, zero));
+  __m128i s45 = _mm_add_epi16(_mm_unpacklo_epi8(a1, zero), _mm_unpacklo_epi8(b1, zero));
+  __m128i s67 = _mm_add_epi16(_mm_unpackhi_epi8(a1, zero), _mm_unpackhi_epi8(b1, zero));
+
+  // Horizontal pairs
+  __m128i h0 = _mm_add_epi16(_mm_unpacklo_epi64(s01, s23), _mm_unpackhi_epi64(s01, s23));
+  __m128i h1 = _mm_add_epi16(_mm_unpacklo_epi64(s45, s67), _mm_unpackhi_epi64(s45, s67));
+
+  h0 = _mm_srli_epi16(_mm_add_epi16(h0, two), 2);
+  h1 = _mm_srli_epi16(_mm_add_epi16(h1, two), 2);
+  _mm_storeu_si128(reinterpret_cast<__m128i *>(output), _mm_packus_epi16(h0, h1));
+}
+#endif
+
+} // namespace
+
+void MipGenerator::downsample(const unsigned char *source, int width, int height, int channels,
+                              unsigned char *destination) {
+  const int outWidth = std::max(1, width / 2);
+  const int outHeight = std::max(1, height / 2);
+  const size_t stride = static_cast<size_t>(width) * channels;
+
+  for (int y = 0; y < outHeight; ++y) {
+    const unsigned char *row0 = source + static_cast<size_t>(std::min(2 * y, height - 1)) * stride;
+    const unsigned char *row1 = source + static_cast<size_t>(std::min(2 * y + 1, height - 1)) * stride;
+    unsigned char *output = destination + static_cast<size_t>(y) * outWidth * channels;
+
+    int x = 0;
+#ifdef MIP_GENERATOR_SSE2
+    if (channels == 4 && width >= 2) {
+      for (; x + 4 <= outWidth; x += 4)
+        downsampleRgba4(row0 + x * 8, row1 + x * 8, output + x * 4);
+    }
+#endif
+    for (; x < outWidth; ++x) {
+      const int x0 = std::min(2 * x, width - 1) * channels;
+      const int x1 = std::min(2 * x + 1, width - 1) * channels;
+      for (int c = 0; c < channels; ++c)
+        output[x * channels + c] = average(row0[x0 + c], row0[x1 + c], row1[x0 + c], row1[x1 + c]);
+    }
+  }
+}
+
+void MipGenerator::generateMips(TextureImage &image) {
+  PROFILE_ZONE("GenerateMips");
+  const int channels = getTextureChannels(image.format);
+
+  // Offsets first so levelData is allocated once
+  std::vector<size_t> offsets;
+  size_t total = 0;
+  for (int width = image.width, height = image.height; width > 1 || height > 1;) {
+    width = std::max(1, width / 2);
+    height = std::max(1, height / 2);
+    offsets.push_back(total);
+    total += static_cast<size_t>(width) * height * channels;
+  }
+  image.levelData.resize(total);
+  image.levels.resize(1);
+
+  for (size_t offset : offsets) {
+    int level = image.getLevelCount();
+    unsigned char *destination = image.levelData.data() + offset;
+    downsample(image.getLevel(level - 1), image.getLevelWidth(level - 1), image.getLevelHeight(level - 1), channels,
+               destination);
+    image.levels.push_back(destination);
+  }
+}
@@ -0,0 +1,108 @@
+#include "rendering/resources/programCache.h"
+#include "foundation/core/config.h"
+#include "foundation/core/fileUtils.h"
+#include "foundation/core/mappedFile.h"
+#include "rendering/backend/renderBackend.h"
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <vector>
+
+namespace {
+constexpr char MAGIC[4] = {'P', 'R', 'G', 'B'};
+
+ProgramCache::Stats stats;
+
+uint64_t hashSources(const std::string &vertexSource, const std::string &fragmentSource) {
+  const char separator = '\0';
+  uint64_t hash = FileUtils::hashData(vertexSource.data(), vertexSource.size());
+  hash = FileUtils::hashData(&separator, 1, hash);
+  return FileUtils::hashData(fragmentSource.data(), fragmentSource.size(), hash);
+}
+
+std::string getCachePath(uint64_t sourceHash, uint64_t driverHash) {
+  char name[64];
+  std::snprintf(name, sizeof(name), "%016llx_%016llx.progbin", static_cast<unsigned long long>(sourceHash),
+                static_cast<unsigned long long>(driverHash));
+  return std::string(EngineConfig::PROGRAM_CACHE_PATH) + name;
+}
+
+double elapsedMs(std::chrono::steady_clock::time_point start) {
+  return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+} // namespace
+
+uint32_t ProgramCache::load(const std::string &vertexSource, const std::string &fragmentSource) {
+  if (!EngineConfig::PROGRAM_CACHE_ENABLED)
+    return 0;
+  RenderBackend &backend = RenderBackend::get();
+  std::string driver = backend.getProgramBinaryDriver();
+  if (driver.empty())
+    return 0;
+
+  auto start = std::chrono::steady_clock::now();
+  const uint64_t sourceHash = hashSources(vertexSource, fragmentSource);
+  const uint64_t driverHash = FileUtils::hashData(driver.data(), driver.size());
+
+  MappedFile file;
+  const Header *header = nullptr;
+  if (file.open(getCachePath(sourceHash, driverHash)) && file.getSize() >= sizeof(Header))
+    header = reinterpret_cast<const Header *>(file.getData());
+  if (!header || std::memcmp(header->magic, MAGIC, sizeof(MAGIC)) != 0 || header->formatVersion != FORMAT_VERSION ||
+      header->sourceHash != sourceHash || header->driverHash != driverHash ||
+      sizeof(Header) + header->binarySize > file.getSize()) {
+    stats.misses++;
+    return 0;
+  }
+
+  uint32_t program =
+      backend.createProgramFromBinary(header->binaryFormat, file.getData() + sizeof(Header), header->binarySize);
+  if (program == 0) {
+    stats.misses++;
+    stats.rejected++;
+    return 0;
+  }
+
+  double loadMs = elapsedMs(start);
+  stats.hits++;
+  stats.loadMs += loadMs;
+  stats.savedMs += header->compileMs - loadMs;
+  return program;
+}
+
+bool ProgramCache::store(uint32_t program, const std::string &vertexSource, const std::string &fragmentSource,
+                         double compileMs) {
+  stats.compileMs += compileMs;
+  if (!EngineConfig::PROGRAM_CACHE_ENABLED)
+    return false;
+  RenderBackend &backend = RenderBackend::get();
+  std::string driver = backend.getProgramBinaryDriver();
+  if (driver.empty())
+    return false;
+
+  uint32_t binaryFormat = 0;
+  std::vector<uint8_t> binary;
+  if (!backend.getProgramBinary(program, binaryFormat, binary))
+    return false;
+
+  Header header{};
+  std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+  header.formatVersion = FORMAT_VERSION;
+  header.binaryFormat = binaryFormat;
+  header.compileMs = static_cast<float>(compileMs);
+  header.sourceHash = hashSources(vertexSource, fragmentSource);
+  header.driverHash = FileUtils::hashData(driver.data(), driver.size());
+  header.binarySize = binary.size();
+
+  std::vector<uint8_t> data(sizeof(Header) + binary.size());
+  std::memcpy(data.data(), &header, sizeof(Header));
+  std::memcpy(data.data() + sizeof(Header), binary.data(), binary.size());
+  if (!FileUtils::writeFileAtomic(getCachePath(header.sourceHash, header.driverHash), data.data(), data.size())) {
+    std::cerr << "[ProgramCache] Cannot write program binary" << std::endl;
+    return false;
+  }
+  return true;
+}
+
+const ProgramCache::Stats &ProgramCache::getStats() { return stats; }
@@ -1,27 +1,128 @@
 #include "rendering/resources/shader.h"
+#include "foundation/core/assetPack.h"
+#include "rendering/resources/programCache.h"
+#include <chrono>
 #include <fstream>
-#include <glm/gtc/type_ptr.hpp>
 #include <iostream>
 #include <sstream>
-#include <vector>
 
+uint32_t ShaderFeatures::getLightTier(size_t lightCount) {
+  uint32_t tier = 0;
+  while (tier + 1 < EngineConfig::SHADER_LIGHT_TIER_COUNT &&
+         lightCount > static_cast<size_t>(EngineConfig::SHADER_LIGHT_TIERS[tier]))
+    tier++;
+  return tier << LightTierShift;
+}
+
+int ShaderFeatures::getMaxLights(uint32_t features) {
+  return EngineConfig::SHADER_LIGHT_TIERS[(features & LightTierMask) >> LightTierShift];
+}
+
+std::string ShaderFeatures::getDefines(uint32_t features) {
+  std::string defines = "#define SHADER_VARIANT\n";
+  if (features & Shadows)
+    defines += "#define SHADOWS\n";
+  if (features & NormalMap)
+    defines += "#define NORMAL_MAP\n";
+  defines += "#define MAX_LIGHTS " + std::to_string(getMaxLights(features)) + "\n";
+  return defines;
+}
 
-Shader::Shader(const char *vertexFile, const char *fragmentFile) {
-  m_shaderID = createShaderProgram(vertexFile, fragmentFile);
+Shader::Shader(const char *vertexFile, const char *fragmentFile)
+    : m_vertexFile(vertexFile), m_fragmentFile(fragmentFile) {
+  m_shaderID = createShaderProgram();
+}
+
+Shader::Shader(const char *vertexFile, const char *fragmentFile, uint32_t features, bool async)
+    : m_vertexFile(vertexFile), m_fragmentFile(fragmentFile), m_features(features),
+      m_defines(ShaderFeatures::getDefines(features)) {
+  if (!async) {
+    m_shaderID = createShaderProgram();
+    return;
+  }
+
+  std::string vertexSource, fragmentSource;
+  if (!readSources(vertexSource, fragmentSource))
+    return;
+
+  // A cached binary is ready at once, otherwise the driver builds the sources while frames go on
+  m_shaderID = ProgramCache::load(vertexSource, fragmentSource);
+  if (m_shaderID != 0)
+    return;
+  m_pendingStart = std::chrono::steady_clock::now();
+  m_pendingID = RenderBackend::get().compileProgram(vertexSource, fragmentSource);
+  m_pendingVertexSource = std::move(vertexSource);
+  m_pendingFragmentSource = std::move(fragmentSource);
 }
 
 bool Shader::load(const char *vertexFile, const char *fragmentFile) {
+  cancelBuild();
   if (m_shaderID != 0) {
-    glDeleteProgram(m_shaderID);
+    RenderBackend::get().deleteProgram(m_shaderID);
     m_shaderID = 0;
   }
 
-  m_shaderID = createShaderProgram(vertexFile, fragmentFile);
+  m_vertexFile = vertexFile;
+  m_fragmentFile = fragmentFile;
+  m_shaderID = createShaderProgram();
   return (m_shaderID != 0);
 }
 
-// Read shader source from file
+bool Shader::reload() {
+  cancelBuild();
+  uint32_t programID = createShaderProgram();
+  if (programID == 0)
+    return false;
+
+  if (m_shaderID != 0)
+    RenderBackend::get().deleteProgram(m_shaderID);
+  m_shaderID = programID;
+  return true;
+}
+
+bool Shader::update() {
+  if (m_pendingID == 0)
+    return true;
+
+  RenderBackend &backend = RenderBackend::get();
+  if (!backend.isProgramReady(m_pendingID))
+    return false;
+
+  std::string errorLog;
+  uint32_t programID = m_pendingID;
+  m_pendingID = 0;
+  if (backend.finishProgram(programID, errorLog)) {
+    double buildMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - m_pendingStart).count();
+    ProgramCache::store(programID, m_pendingVertexSource, m_pendingFragmentSource, buildMs);
+    if (m_shaderID != 0)
+      backend.deleteProgram(m_shaderID);
+    m_shaderID = programID;
+  } else {
+    std::cerr << "[Shader] Build error in " << m_vertexFile << " + " << m_fragmentFile << ":\n" << errorLog << std::endl;
+  }
+
+  m_pendingVertexSource.clear();
+  m_pendingFragmentSource.clear();
+  return true;
+}
+
+bool Shader::isPending() const { return m_pendingID != 0; }
+
+void Shader::cancelBuild() {
+  if (m_pendingID == 0)
+    return;
+  RenderBackend::get().deleteProgram(m_pendingID);
+  m_pendingID = 0;
+  m_pendingVertexSource.clear();
+  m_pendingFragmentSource.clear();
+}
+
+// Read shader source from the asset pack or the file
 std::string Shader::readShaderFile(const char *filename) const {
+  AssetBlob blob;
+  if (AssetPack::get().find(filename, AssetType::Shader, blob))
+    return std::string(reinterpret_cast<const char *>(blob.data), blob.size);
+
   std::ifstream file(filename);
   if (!file.is_open()) {
     std::cerr << "[Shader] Cannot open: " << filename << std::endl;
@@ -33,115 +134,98 @@ std::string Shader::readShaderFile(const char *filename) const {
   return buffer.str();
 }
 
-// Compile single shader (vertex/fragment)
-GLuint Shader::compileShader(GLenum type, const char *filename) {
-  std::string shaderSource = readShaderFile(filename);
-  if (shaderSource.empty())
-    return 0;
-
-  const char *sourceCStr = shaderSource.c_str();
-  GLuint shader = glCreateShader(type);
-  glShaderSource(shader, 1, &sourceCStr, nullptr);
-  glCompileShader(shader);
-
-  // Check compilation
-  GLint success;
-  glGetShaderiv(shader, GL_COMPILE_STATUS, &success);
-  if (!success) {
-    GLint logLength;
-    glGetShaderiv(shader, GL_INFO_LOG_LENGTH, &logLength);
-    std::vector<char> log(logLength);
-    glGetShaderInfoLog(shader, logLength, nullptr, log.data());
-    std::cerr << "[Shader] Compilation error in " << filename << ":\n" << log.data() << std::endl;
-    glDeleteShader(shader);
-    return 0;
+// Both stages, with the variant defines after the #version line (which must stay first)
+bool Shader::readSources(std::string &vertexSource, std::string &fragmentSource) const {
+  vertexSource = readShaderFile(m_vertexFile.c_str());
+  fragmentSource = readShaderFile(m_fragmentFile.c_str());
+  if (vertexSource.empty() || fragmentSource.empty())
+    return false;
+
+  if (!m_defines.empty()) {
+    for (std::string *source : {&vertexSource, &fragmentSource}) {
+      size_t line = source->compare(0, 8, "#version") == 0 ? source->find('\n') : std::string::npos;
+      source->insert(line == std::string::npos ? 0 : line + 1, m_defines);
+    }
   }
-
-  return shader;
+  return true;
 }
 
-// Link vertex + fragment into program
-GLuint Shader::createShaderProgram(const char *vertexFile, const char *fragmentFile) {
-  GLuint vertexShader = compileShader(GL_VERTEX_SHADER, vertexFile);
-  GLuint fragmentShader = compileShader(GL_FRAGMENT_SHADER, fragmentFile);
-
-  if (vertexShader == 0 || fragmentShader == 0) {
-    if (vertexShader)
-      glDeleteShader(vertexShader);
-    if (fragmentShader)
-      glDeleteShader(fragmentShader);
+// Read vertex + fragment, then load the cached program binary or compile and link (and cache) the sources
+uint32_t Shader::createShaderProgram() {
+  std::string vertexSource, fragmentSource;
+  if (!readSources(vertexSource, fragmentSource))
     return 0;
-  }
 
-  GLuint programID = glCreateProgram();
-  glAttachShader(programID, vertexShader);
-  glAttachShader(programID, fragmentShader);
-  glLinkProgram(programID);
-
-  // Check linking
-  GLint success;
-  glGetProgramiv(programID, GL_LINK_STATUS, &success);
-  if (!success) {
-    GLint logLength;
-    glGetProgramiv(programID, GL_INFO_LOG_LENGTH, &logLength);
-    std::vector<char> log(logLength);
-    glGetProgramInfoLog(programID, logLength, nullptr, log.data());
-    std::cerr << "[Shader] Linking error:\n" << log.data() << std::endl;
-    glDeleteShader(vertexShader);
-    glDeleteShader(fragmentShader);
-    glDeleteProgram(programID);
+  uint32_t programID = ProgramCache::load(vertexSource, fragmentSource);
+  if (programID != 0)
+    return programID;
+
+  auto start = std::chrono::steady_clock::now();
+  std::string errorLog;
+  programID = RenderBackend::get().createProgram(vertexSource, fragmentSource, errorLog);
+  if (programID == 0) {
+    std::cerr << "[Shader] Build error in " << m_vertexFile << " + " << m_fragmentFile << ":\n"
+              << errorLog << std::endl;
     return 0;
   }
 
-  glDeleteShader(vertexShader);
-  glDeleteShader(fragmentShader);
-
+  double compileMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+  ProgramCache::store(programID, vertexSource, fragmentSource, compileMs);
   return programID;
 }
 
-void Shader::use() const { glUseProgram(m_shaderID); }
+void Shader::use() const { RenderBackend::get().useProgram(m_shaderID); }
 
 // Bind texture to uniform
-void Shader::setTex(const char *name, GLuint textureID, int textureUnit) const {
-  glActiveTexture(GL_TEXTURE0 + textureUnit);
-  glBindTexture(GL_TEXTURE_2D, textureID);
+void Shader::setTex(const char *name, uint32_t textureID, int textureUnit) const {
+  auto &backend = RenderBackend::get();
+  backend.bindTexture(textureUnit, textureID);
 
-  GLint location = glGetUniformLocation(m_shaderID, name);
+  int location = backend.getUniformLocation(m_shaderID, name);
   if (location != -1) {
-    glUniform1i(location, textureUnit);
+    backend.setUniform(location, textureUnit);
   } else {
     std::cerr << "[Shader] Uniform not found: " << name << std::endl;
   }
 }
 
 void Shader::setInt(const char *name, int value) const {
-  GLint location = glGetUniformLocation(m_shaderID, name);
+  auto &backend = RenderBackend::get();
+  int location = backend.getUniformLocation(m_shaderID, name);
   if (location != -1)
-    glUniform1i(location, value);
+    backend.setUniform(location, value);
 }
 
 void Shader::setFloat(const char *name, float value) const {
-  GLint location = glGetUniformLocation(m_shaderID, name);
+  auto &backend = RenderBackend::get();
+  int location = backend.getUniformLocation(m_shaderID, name);
   if (location != -1)
-    glUniform1f(location, value);
+    backend.setUniform(location, value);
 }
 
 void Shader::setVec3(const char *name, glm::vec3 value) const {
-  GLint location = glGetUniformLocation(m_shaderID, name);
+  auto &backend = RenderBackend::get();
+  int location = backend.getUniformLocation(m_shaderID, name);
   if (location != -1)
-    glUniform3fv(location, 1, glm::value_ptr(value));
+    backend.setUniform(location, value);
 }
 
 void Shader::setMat3(const char *name, glm::mat3 value) const {
-  GLint location = glGetUniformLocation(m_shaderID, name);
+  auto &backend = RenderBackend::get();
+  int location = backend.getUniformLocation(m_shaderID, name);
   if (location != -1)
-    glUniformMatrix3fv(location, 1, GL_FALSE, glm::value_ptr(value));
+    backend.setUniform(location, value);
 }
 
 void Shader::setMat4(const char *name, glm::mat4 value) const {
-  GLint location = glGetUniformLocation(m_shaderID, name);
+  auto &backend = RenderBackend::get();
+  int location = backend.getUniformLocation(m_shaderID, name);
   if (location != -1)
-    glUniformMatrix4fv(location, 1, GL_FALSE, glm::value_ptr(value));
+    backend.setUniform(location, value);
 }
 
-GLuint Shader::getShaderID() const { return m_shaderID; }
+uint32_t Shader::getShaderID() const { return m_shaderID; }
+uint32_t Shader::getFeatures() const { return m_features; }
+int Shader::getMaxLights() const { return ShaderFeatures::getMaxLights(m_features); }
+const std::string &Shader::getVertexFile() const { return m_vertexFile; }
+const std::string &Shader::getFragmentFile() const { return m_fragmentFile; }
@@ -0,0 +1,138 @@
+#include "rendering/resources/textureCache.h"
+#include "foundation/core/assetPack.h"
+#include "foundation/core/config.h"
+#include "foundation/core/fileUtils.h"
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+
+namespace fs = std::filesystem;
+
+namespace {
+constexpr char MAGIC[4] = {'T', 'E', 'X', 'C'};
+constexpr uint64_t ALIGNMENT = 16;
+
+uint64_t alignUp(uint64_t offset) { return (offset + ALIGNMENT - 1) & ~(ALIGNMENT - 1); }
+} // namespace
+
+std::string TextureCache::getCachePath(const std::string &sourcePath, TextureUsage usage) {
+  char hash[17];
+  std::snprintf(hash, sizeof(hash), "%016llx", static_cast<unsigned long long>(FileUtils::hashPath(sourcePath)));
+  const char *suffix = usage == TextureUsage::Normal ? "_normal" : "";
+  return std::string(EngineConfig::TEXTURE_CACHE_PATH) + fs::path(sourcePath).stem().string() + "_" + hash + suffix +
+         ".texbin";
+}
+
+// Point image levels at a cache file image; false if it is not a complete cache of this format and encoder
+static bool parse(const uint8_t *data, size_t size, TextureUsage usage, TextureImage &image,
+                  const TextureCache::Header *&header) {
+  using TextureCache::Level;
+  header = reinterpret_cast<const TextureCache::Header *>(data);
+  if (size < sizeof(TextureCache::Header) || std::memcmp(header->magic, MAGIC, sizeof(MAGIC)) != 0 ||
+      header->formatVersion != TextureCache::FORMAT_VERSION ||
+      header->encoderVersion != TextureCache::ENCODER_VERSION || header->usage != static_cast<uint32_t>(usage) ||
+      header->levelCount == 0 || sizeof(TextureCache::Header) + uint64_t(header->levelCount) * sizeof(Level) > size)
+    return false;
+
+  image.width = static_cast<int>(header->width);
+  image.height = static_cast<int>(header->height);
+  image.format = static_cast<TextureFormat>(header->format);
+  image.levels.clear();
+
+  // Reject truncated files and level tables that disagree with the format
+  const Level *levels = reinterpret_cast<const Level *>(data + sizeof(TextureCache::Header));
+  for (uint32_t level = 0; level < header->levelCount; ++level) {
+    if (levels[level].offset + levels[level].size > size ||
+        levels[level].size != image.getLevelBytes(static_cast<int>(level))) {
+      image.levels.clear();
+      return false;
+    }
+    image.levels.push_back(data + levels[level].offset);
+  }
+
+  image.pixels.reset();
+  image.levelData.clear();
+  return true;
+}
+
+bool TextureCache::open(const std::string &sourcePath, TextureUsage usage, TextureImage &image,
+                        uint64_t *sourceBytes) {
+  const Header *header = nullptr;
+
+  // Packed textures are cooked ahead of time and trusted without a source file
+  AssetBlob blob;
+  AssetType type = usage == TextureUsage::Normal ? AssetType::NormalMap : AssetType::Texture;
+  if (AssetPack::get().find(sourcePath, type, blob)) {
+    if (!parse(blob.data, blob.size, usage, image, header))
+      return false;
+    if (sourceBytes)
+      *sourceBytes = header->sourceBytes;
+    return true;
+  }
+
+  int64_t modified;
+  uint64_t size;
+  if (!FileUtils::getFileStamp(sourcePath, modified, size))
+    return false;
+
+  MappedFile file;
+  if (!file.open(getCachePath(sourcePath, usage)) || !parse(file.getData(), file.getSize(), usage, image, header))
+    return false;
+
+  if (header->sourcePathHash != FileUtils::hashPath(sourcePath) || header->sourceModified != modified ||
+      header->sourceSize != size) {
+    image.levels.clear();
+    return false;
+  }
+
+  if (sourceBytes)
+    *sourceBytes = header->sourceBytes;
+  image.mapping = std::move(file);
+  return true;
+}
+
+bool TextureCache::write(const std::string &sourcePath, TextureUsage usage, const TextureImage &image,
+                         uint64_t sourceBytes) {
+  Header header{};
+  std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+  header.formatVersion = FORMAT_VERSION;
+  header.encoderVersion = ENCODER_VERSION;
+  header.format = static_cast<uint32_t>(image.format);
+  header.usage = static_cast<uint32_t>(usage);
+  header.width = static_cast<uint32_t>(image.width);
+  header.height = static_cast<uint32_t>(image.height);
+  header.levelCount = static_cast<uint32_t>(image.getLevelCount());
+  header.sourcePathHash = FileUtils::hashPath(sourcePath);
+  header.sourceBytes = sourceBytes;
+  if (!FileUtils::getFileStamp(sourcePath, header.sourceModified, header.sourceSize))
+    return false;
+
+  std::vector<Level> levels(header.levelCount);
+  uint64_t offset = alignUp(sizeof(Header) + levels.size() * sizeof(Level));
+  for (int level = 0; level < image.getLevelCount(); ++level) {
+    levels[level] = {offset, image.getLevelBytes(level)};
+    offset = alignUp(offset + levels[level].size);
+  }
+
+  std::vector<uint8_t> file(offset);
+  std::memcpy(file.data(), &header, sizeof(Header));
+  std::memcpy(file.data() + sizeof(Header), levels.data(), levels.size() * sizeof(Level));
+  for (int level = 0; level < image.getLevelCount(); ++level)
+    std::memcpy(file.data() + levels[level].offset, image.getLevel(level), levels[level].size);
+  return FileUtils::writeFileAtomic(getCachePath(sourcePath, usage), file.data(), file.size());
+}
+
+bool TextureCache::updateSourceStamp(const std::string &sourcePath, TextureUsage usage) {
+  MappedFile file;
+  if (!file.open(getCachePath(sourcePath, usage)) || file.getSize() < sizeof(Header) ||
+      std::memcmp(file.getData(), MAGIC, sizeof(MAGIC)) != 0)
+    return false;
+
+  std::vector<uint8_t> data(file.getData(), file.getData() + file.getSize());
+  file.close();
+  Header *header = reinterpret_cast<Header *>(data.data());
+  header->sourcePathHash = FileUtils::hashPath(sourcePath);
+  if (!FileUtils::getFileStamp(sourcePath, header->sourceModified, header->sourceSize))
+    return false;
+  return FileUtils::writeFileAtomic(getCachePath(sourcePath, usage), data.data(), data.size());
+}
@@ -0,0 +1,415 @@
+#include "rendering/resources/textureCompressor.h"
+#include "foundation/core/config.h"
+#include "foundation/core/profiler.h"
+#include "systems/jobSystem.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace {
+
+// 4x4 texels as RGBA bytes (alpha 255 for 3-channel sources)
+using Block = unsigned char[16][4];
+
+// Block rows per job when encoding in parallel
+constexpr uint32_t BLOCK_ROWS_PER_JOB = 8;
+
+// Copy a block, clamping to the edge for levels smaller than 4 texels or not a multiple of 4
+void fetchBlock(const unsigned char *pixels, int width, int height, int channels, int blockX, int blockY,
+                Block &block) {
+  for (int y = 0; y < 4; ++y) {
+    int sourceY = std::min(blockY * 4 + y, height - 1);
+    for (int x = 0; x < 4; ++x) {
+      int sourceX = std::min(blockX * 4 + x, width - 1);
+      const unsigned char *texel = pixels + (static_cast<size_t>(sourceY) * width + sourceX) * channels;
+      unsigned char *out = block[y * 4 + x];
+      out[0] = texel[0];
+      out[1] = texel[1];
+      out[2] = texel[2];
+      out[3] = channels == 4 ? texel[3] : 255;
+    }
+  }
+}
+
+// Principal axis of the block colors over the first `components` channels (power iteration on the covariance)
+void principalAxis(const Block &block, int components, float mean[4], float axis[4]) {
+  for (int c = 0; c < 4; ++c) {
+    mean[c] = 0.0f;
+    axis[c] = 0.0f;
+  }
+  for (const auto &texel : block)
+    for (int c = 0; c < components; ++c)
+      mean[c] += texel[c] / 16.0f;
+
+  float covariance[4][4] = {};
+  for (const auto &texel : block) {
+    float d[4];
+    for (int c = 0; c < components; ++c)
+      d[c] = texel[c] - mean[c];
+    for (int i = 0; i < components; ++i)
+      for (int j = 0; j < components; ++j)
+        covariance[i][j] += d[i] * d[j];
+  }
+
+  // Start from the diagonal so the iteration has a sensible direction
+  for (int c = 0; c < components; ++c)
+    axis[c] = 1.0f;
+  for (int iteration = 0; iteration < 8; ++iteration) {
+    float next[4] = {};
+    for (int i = 0; i < components; ++i)
+      for (int j = 0; j < components; ++j)
+        next[i] += covariance[i][j] * axis[j];
+
+    float length = 0.0f;
+    for (int c = 0; c < components; ++c)
+      length += next[c] * next[c];
+    if (length < 1e-12f)
+      return;
+    length = std::sqrt(length);
+    for (int c = 0; c < components; ++c)
+      axis[c] = next[c] / length;
+  }
+}
+
+// Endpoints where the block's projection onto the principal axis ends
+void axisEndpoints(const Block &block, int components, float low[4], float high[4]) {
+  float mean[4], axis[4];
+  principalAxis(block, components, mean, axis);
+
+  float minT = 0.0f, maxT = 0.0f;
+  for (const auto &texel : block) {
+    float t = 0.0f;
+    for (int c = 0; c < components; ++c)
+      t += (texel[c] - mean[c]) * axis[c];
+    minT = std::min(minT, t);
+    maxT = std::max(maxT, t);
+  }
+  for (int c = 0; c < 4; ++c) {
+    low[c] = std::clamp(mean[c] + axis[c] * minT, 0.0f, 255.0f);
+    high[c] = std::clamp(mean[c] + axis[c] * maxT, 0.0f, 255.0f);
+  }
+}
+
+// ---------- BC1 color block ----------
+
+uint16_t packRgb565(const float color[3]) {
+  int r = static_cast<int>(std::lround(color[0] * 31.0f / 255.0f));
+  int g = static_cast<int>(std::lround(color[1] * 63.0f / 255.0f));
+  int b = static_cast<int>(std::lround(color[2] * 31.0f / 255.0f));
+  return static_cast<uint16_t>((std::clamp(r, 0, 31) << 11) | (std::clamp(g, 0, 63) << 5) | std::clamp(b, 0, 31));
+}
+
+void unpackRgb565(uint16_t packed, int color[3]) {
+  int r = (packed >> 11) & 31, g = (packed >> 5) & 63, b = packed & 31;
+  color[0] = (r << 3) | (r >> 2);
+  color[1] = (g << 2) | (g >> 4);
+  color[2] = (b << 3) | (b >> 2);
+}
+
+// Indices of the 4-color palette for two endpoints; returns the squared error
+int colorIndices(const Block &block, uint16_t color0, uint16_t color1, uint32_t &indices) {
+  int palette[4][3];
+  unpackRgb565(color0, palette[0]);
+  unpackRgb565(color1, palette[1]);
+  for (int c = 0; c < 3; ++c) {
+    palette[2][c] = (2 * palette[0][c] + palette[1][c]) / 3;
+    palette[3][c] = (palette[0][c] + 2 * palette[1][c]) / 3;
+  }
+
+  int error = 0;
+  indices = 0;
+  for (int i = 0; i < 16; ++i) {
+    int best = 0, bestDistance = INT32_MAX;
+    for (int p = 0; p < 4; ++p) {
+      int distance = 0;
+      for (int c = 0; c < 3; ++c) {
+        int d = block[i][c] - palette[p][c];
+        distance += d * d;
+      }
+      if (distance < bestDistance) {
+        bestDistance = distance;
+        best = p;
+      }
+    }
+    indices |= static_cast<uint32_t>(best) << (2 * i);
+    error += bestDistance;
+  }
+  return error;
+}
+
+// Least-squares endpoints for fixed indices (weight of color0 per index: 1, 0, 2/3, 1/3)
+bool refineEndpoints(const Block &block, uint32_t indices, float color0[3], float color1[3]) {
+  static const float weights[4] = {1.0f, 0.0f, 2.0f / 3.0f, 1.0f / 3.0f};
+  float aa = 0, ab = 0, bb = 0, ax[3] = {}, bx[3] = {};
+  for (int i = 0; i < 16; ++i) {
+    float a = weights[(indices >> (2 * i)) & 3], b = 1.0f - a;
+    aa += a * a;
+    ab += a * b;
+    bb += b * b;
+    for (int c = 0; c < 3; ++c) {
+      ax[c] += a * block[i][c];
+      bx[c] += b * block[i][c];
+    }
+  }
+
+  float determinant = aa * bb - ab * ab;
+  if (std::abs(determinant) < 1e-6f)
+    return false;
+  for (int c = 0; c < 3; ++c) {
+    color0[c] = std::clamp((ax[c] * bb - bx[c] * ab) / determinant, 0.0f, 255.0f);
+    color1[c] = std::clamp((bx[c] * aa - ax[c] * ab) / determinant, 0.0f, 255.0f);
+  }
+  return true;
+}
+
+// Endpoints ordered for 4-color mode (color0 > color1); equal endpoints fall back to a solid block
+void orderEndpoints(uint16_t &color0, uint16_t &color1) {
+  if (color0 < color1)
+    std::swap(color0, color1);
+}
+
+void encodeColorBlock(const Block &block, unsigned char *output) {
+  float low[4], high[4];
+  axisEndpoints(block, 3, low, high);
+
+  uint16_t color0 = packRgb565(high), color1 = packRgb565(low);
+  orderEndpoints(color0, color1);
+  uint32_t indices;
+  int error = colorIndices(block, color0, color1, indices);
+
+  // One refinement pass, kept only if it lowers the error
+  float refined0[3], refined1[3];
+  if (color0 != color1 && refineEndpoints(block, indices, refined0, refined1)) {
+    uint16_t candidate0 = packRgb565(refined0), candidate1 = packRgb565(refined1);
+    orderEndpoints(candidate0, candidate1);
+    uint32_t candidateIndices;
+    if (candidate0 != candidate1 && colorIndices(block, candidate0, candidate1, candidateIndices) < error) {
+      color0 = candidate0;
+      color1 = candidate1;
+      indices = candidateIndices;
+    }
+  }
+  if (color0 == color1)
+    indices = 0;
+
+  output[0] = static_cast<unsigned char>(color0 & 0xff);
+  output[1] = static_cast<unsigned char>(color0 >> 8);
+  output[2] = static_cast<unsigned char>(color1 & 0xff);
+  output[3] = static_cast<unsigned char>(color1 >> 8);
+  std::memcpy(output + 4, &indices, 4); // little endian
+}
+
+// ---------- BC4 single channel block (BC3 alpha, BC5 X and Y) ----------
+
+void encodeChannelBlock(const Block &block, int channel, unsigned char *output) {
+  int low = 255, high = 0;
+  for (const auto &texel : block) {
+    low = std::min<int>(low, texel[channel]);
+    high = std::max<int>(high, texel[channel]);
+  }
+
+  // 8-value mode (endpoint0 > endpoint1): codes 0, 1 are the endpoints, 2..7 interpolate
+  int palette[8] = {high, low};
+  for (int k = 2; k < 8; ++k)
+    palette[k] = ((8 - k) * high + (k - 1) * low) / 7;
+
+  uint64_t bits = 0;
+  if (high != low) {
+    for (int i = 0; i < 16; ++i) {
+      int best = 0, bestDistance = INT32_MAX;
+      for (int k = 0; k < 8; ++k) {
+        int distance = std::abs(block[i][channel] - palette[k]);
+        if (distance < bestDistance) {
+          bestDistance = distance;
+          best = k;
+        }
+      }
+      bits |= static_cast<uint64_t>(best) << (3 * i);
+    }
+  }
+
+  output[0] = static_cast<unsigned char>(high);
+  output[1] = static_cast<unsigned char>(low);
+  for (int i = 0; i < 6; ++i)
+    output[2 + i] = static_cast<unsigned char>(bits >> (8 * i));
+}
+
+// ---------- BC7 mode 6 (one subset, RGBA 7.7.7.7 endpoints + p-bit, 4-bit indices) ----------
+
+class BitWriter {
+private:
+  unsigned char *m_output;
+  int m_position = 0;
+
+public:
+  explicit BitWriter(unsigned char *output) : m_output(output) { std::memset(output, 0, 16); }
+
+  void write(uint32_t value, int count) {
+    for (int bit = 0; bit < count; ++bit, ++m_position) {
+      if ((value >> bit) & 1)
+        m_output[m_position >> 3] |= static_cast<unsigned char>(1 << (m_position & 7));
+    }
+  }
+};
+
+// 7-bit endpoint plus shared p-bit closest to the float endpoint
+void quantizeEndpoint(const float endpoint[4], int quantized[4], int &pbit) {
+  int bestError = INT32_MAX;
+  for (int p = 0; p < 2; ++p) {
+    int candidate[4], error = 0;
+    for (int c = 0; c < 4; ++c) {
+      candidate[c] = std::clamp(static_cast<int>(std::lround((endpoint[c] - p) / 2.0f)), 0, 127);
+      int d = ((candidate[c] << 1) | p) - static_cast<int>(std::lround(endpoint[c]));
+      error += d * d;
+    }
+    if (error < bestError) {
+      bestError = error;
+      pbit = p;
+      std::memcpy(quantized, candidate, sizeof(candidate));
+    }
+  }
+}
+
+void encodeBc7Block(const Block &block, unsigned char *output) {
+  static const int weights[16] = {0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64};
+
+  float low[4], high[4];
+  axisEndpoints(block, 4, low, high);
+
+  int endpoints[2][4], pbits[2];
+  quantizeEndpoint(low, endpoints[0], pbits[0]);
+  quantizeEndpoint(high, endpoints[1], pbits[1]);
+
+  int palette[16][4];
+  for (int k = 0; k < 16; ++k) {
+    for (int c = 0; c < 4; ++c) {
+      int e0 = (endpoints[0][c] << 1) | pbits[0];
+      int e1 = (endpoints[1][c] << 1) | pbits[1];
+      palette[k][c] = ((64 - weights[k]) * e0 + weights[k] * e1 + 32) >> 6;
+    }
+  }
+
+  int indices[16];
+  for (int i = 0; i < 16; ++i) {
+    int bestDistance = INT32_MAX;
+    for (int k = 0; k < 16; ++k) {
+      int distance = 0;
+      for (int c = 0; c < 4; ++c) {
+        int d = block[i][c] - palette[k][c];
+        distance += d * d;
+      }
+      if (distance < bestDistance) {
+        bestDistance = distance;
+        indices[i] = k;
+      }
+    }
+  }
+
+  // The first index is stored with an implicit 0 MSB: swap the endpoints if it is set
+  if (indices[0] & 8) {
+    std::swap(endpoints[0], endpoints[1]);
+    std::swap(pbits[0], pbits[1]);
+    for (int &index : indices)
+      index = 15 - index;
+  }
+
+  BitWriter writer(output);
+  writer.write(1 << 6, 7); // mode 6
+  for (int c = 0; c < 4; ++c) {
+    writer.write(endpoints[0][c], 7);
+    writer.write(endpoints[1][c], 7);
+  }
+  writer.write(pbits[0], 1);
+  writer.write(pbits[1], 1);
+  writer.write(indices[0], 3);
+  for (int i = 1; i < 16; ++i)
+    writer.write(indices[i], 4);
+}
+
+void encodeBlock(const Block &block, TextureFormat format, unsigned char *output) {
+  switch (format) {
+  case TextureFormat::BC1:
+    encodeColorBlock(block, output);
+    break;
+  case TextureFormat::BC3:
+    encodeChannelBlock(block, 3, output);
+    encodeColorBlock(block, output + 8);
+    break;
+  case TextureFormat::BC5:
+    encodeChannelBlock(block, 0, output);
+    encodeChannelBlock(block, 1, output + 8);
+    break;
+  case TextureFormat::BC7:
+    encodeBc7Block(block, output);
+    break;
+  default:
+    break;
+  }
+}
+
+} // namespace
+
+TextureFormat TextureCompressor::chooseFormat(const TextureImage &image, TextureUsage usage) {
+  if (usage == TextureUsage::Normal)
+    return TextureFormat::BC5;
+  if (EngineConfig::TEXTURE_COMPRESSION_USE_BC7)
+    return TextureFormat::BC7;
+
+  // BC1 unless some texel is not fully opaque
+  if (image.format == TextureFormat::RGBA8) {
+    const unsigned char *pixels = image.getLevel(0);
+    size_t texels = static_cast<size_t>(image.width) * image.height;
+    for (size_t i = 0; i < texels; ++i) {
+      if (pixels[i * 4 + 3] != 255)
+        return TextureFormat::BC3;
+    }
+  }
+  return TextureFormat::BC1;
+}
+
+void TextureCompressor::encodeLevel(const unsigned char *pixels, int width, int height, int channels,
+                                    TextureFormat format, unsigned char *output, JobSystem *jobSystem) {
+  const int blocksX = (width + 3) / 4;
+  const int blocksY = (height + 3) / 4;
+  const size_t blockBytes = format == TextureFormat::BC1 ? 8 : 16;
+
+  auto encodeRows = [&](uint32_t begin, uint32_t end) {
+    Block block;
+    for (uint32_t y = begin; y < end; ++y) {
+      for (int x = 0; x < blocksX; ++x) {
+        fetchBlock(pixels, width, height, channels, x, static_cast<int>(y), block);
+        encodeBlock(block, format, output + (static_cast<size_t>(y) * blocksX + x) * blockBytes);
+      }
+    }
+  };
+
+  if (jobSystem && static_cast<uint32_t>(blocksY) > BLOCK_ROWS_PER_JOB)
+    jobSystem->parallelFor(static_cast<uint32_t>(blocksY), BLOCK_ROWS_PER_JOB, encodeRows);
+  else
+    encodeRows(0, static_cast<uint32_t>(blocksY));
+}
+
+void TextureCompressor::compress(const TextureImage &source, TextureFormat format, TextureImage &compressed,
+                                 JobSystem *jobSystem) {
+  PROFILE_ZONE("CompressTexture");
+  compressed.width = source.width;
+  compressed.height = source.height;
+  compressed.format = format;
+
+  std::vector<size_t> offsets;
+  size_t total = 0;
+  for (int level = 0; level < source.getLevelCount(); ++level) {
+    offsets.push_back(total);
+    total += getTextureLevelBytes(format, source.getLevelWidth(level), source.getLevelHeight(level));
+  }
+  compressed.levelData.resize(total);
+  compressed.levels.clear();
+
+  const int channels = getTextureChannels(source.format);
+  for (int level = 0; level < source.getLevelCount(); ++level) {
+    unsigned char *output = compressed.levelData.data() + offsets[level];
+    encodeLevel(source.getLevel(level), source.getLevelWidth(level), source.getLevelHeight(level), channels, format,
+                output, jobSystem);
+    compressed.levels.push_back(output);
+  }
+}
@@ -0,0 +1,123 @@
+#include "rendering/resources/textureImporter.h"
+#include "foundation/core/assetPack.h"
+#include "foundation/core/config.h"
+#include "foundation/core/profiler.h"
+#include "rendering/resources/mipGenerator.h"
+#include "rendering/resources/textureCache.h"
+#include "rendering/resources/textureCompressor.h"
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <iostream>
+#include <stb_image/stb_image.h>
+#include <vector>
+
+static const std::vector<std::string> kSupportedExtensions = {".png", ".jpg", ".jpeg", ".bmp", ".tga"};
+
+std::string TextureImporter::findFile(const std::filesystem::path &path, TextureUsage usage) {
+  if (path.empty())
+    return "";
+
+  // Packed textures first: hash probes in mapped memory instead of a stat per extension
+  const AssetPack &pack = AssetPack::get();
+  if (pack.isOpen()) {
+    AssetType type = usage == TextureUsage::Normal ? AssetType::NormalMap : AssetType::Texture;
+    AssetBlob blob;
+    for (const auto &ext : kSupportedExtensions) {
+      auto candidate = path;
+      candidate += ext;
+      if (pack.find(candidate.string(), type, blob))
+        return candidate.string();
+    }
+  }
+
+  for (const auto &ext : kSupportedExtensions) {
+    auto candidate = path;
+    candidate += ext;
+    if (std::filesystem::exists(candidate))
+      return candidate.string();
+  }
+  return "";
+}
+
+bool TextureImporter::isSupportedFile(const std::filesystem::path &file) {
+  std::string ext = file.extension().string();
+  std::transform(ext.begin(), ext.end(), ext.begin(), [](unsigned char c) { return std::tolower(c); });
+  return std::find(kSupportedExtensions.begin(), kSupportedExtensions.end(), ext) != kSupportedExtensions.end();
+}
+
+TextureUsage TextureImporter::guessUsage(const std::filesystem::path &file) {
+  std::string name = file.filename().string();
+  std::transform(name.begin(), name.end(), name.begin(), [](unsigned char c) { return std::tolower(c); });
+  return name.find("normal") != std::string::npos ? TextureUsage::Normal : TextureUsage::Color;
+}
+
+bool TextureImporter::import(const std::string &file, TextureUsage usage, TextureImage &image, JobSystem *jobSystem,
+                             TextureImportStats *stats) {
+  PROFILE_ZONE("ImportTexture");
+  TextureImportStats result;
+
+  uint64_t cachedSourceBytes = 0;
+  if (EngineConfig::TEXTURE_COMPRESSION_ENABLED && TextureCache::open(file, usage, image, &cachedSourceBytes) &&
+      RenderBackend::get().supportsTextureFormat(image.format)) {
+    result.cached = true;
+    result.sourceBytes = cachedSourceBytes;
+    result.bytes = image.getTotalBytes();
+    if (stats)
+      *stats = result;
+    return true;
+  }
+
+  auto start = std::chrono::steady_clock::now();
+  stbi_set_flip_vertically_on_load_thread(true);
+
+  int width, height, channels;
+  unsigned char *data = stbi_load(file.c_str(), &width, &height, &channels, 0);
+  if (!data) {
+    std::cerr << "[Material] Failed to load " << file << ": " << stbi_failure_reason() << std::endl;
+    return false;
+  }
+
+  // Only RGB and RGBA uploads are supported
+  if (channels != 3 && channels != 4) {
+    stbi_image_free(data);
+    data = stbi_load(file.c_str(), &width, &height, &channels, 4);
+    channels = 4;
+    if (!data)
+      return false;
+  }
+
+  TextureImage decoded;
+  decoded.width = width;
+  decoded.height = height;
+  decoded.format = (channels == 4 ? TextureFormat::RGBA8 : TextureFormat::RGB8);
+  decoded.pixels = {data, stbi_image_free};
+  decoded.levels = {data};
+  MipGenerator::generateMips(decoded);
+  result.sourceBytes = decoded.getTotalBytes();
+
+  TextureFormat format = TextureCompressor::chooseFormat(decoded, usage);
+  if (!EngineConfig::TEXTURE_COMPRESSION_ENABLED || !RenderBackend::get().supportsTextureFormat(format)) {
+    image = std::move(decoded);
+    result.bytes = result.sourceBytes;
+    if (stats)
+      *stats = result;
+    return true;
+  }
+
+  image = TextureImage();
+  TextureCompressor::compress(decoded, format, image, jobSystem);
+  result.bytes = image.getTotalBytes();
+  result.encodeMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+  if (!TextureCache::write(file, usage, image, result.sourceBytes))
+    std::cerr << "[Texture] Failed to write cache for " << file << std::endl;
+
+  std::cout << "[Texture] " << file << ": " << width << "x" << height << " "
+            << getTextureFormatName(decoded.format) << " -> " << getTextureFormatName(format) << ", "
+            << result.sourceBytes / (1024.0 * 1024.0) << " MiB -> " << result.bytes / (1024.0 * 1024.0) << " MiB ("
+            << static_cast<double>(result.sourceBytes) / result.bytes << "x) in " << result.encodeMs << " ms"
+            << std::endl;
+  if (stats)
+    *stats = result;
+  return true;
+}
@@ -0,0 +1,121 @@
+#include "systems/jobSystem.h"
+#include "foundation/core/profiler.h"
+#include <algorithm>
+#include <string>
+
+JobSystem::JobSystem(unsigned int threadCount) {
+  if (threadCount == 0) {
+    unsigned int hardware = std::thread::hardware_concurrency();
+    threadCount = hardware > 1 ? hardware - 1 : 1;
+  }
+
+  m_workers.reserve(threadCount);
+  for (unsigned int i = 0; i < threadCount; ++i)
+    m_workers.emplace_back(&JobSystem::workerLoop, this, i);
+}
+
+JobSystem::~JobSystem() {
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_stopping = true;
+  }
+  m_condition.notify_all();
+
+  for (auto &worker : m_workers)
+    worker.join();
+}
+
+void JobSystem::workerLoop(unsigned int index) {
+  Profiler::setThreadName("Worker " + std::to_string(index));
+
+  for (;;) {
+    std::function<void()> job;
+    {
+      std::unique_lock<std::mutex> lock(m_mutex);
+      m_condition.wait(lock,
+                       [this] { return m_stopping || !m_queue.empty() || !m_backgroundQueue.empty(); });
+      if (!m_queue.empty()) {
+        job = std::move(m_queue.front().run);
+        m_queue.pop_front();
+      } else if (!m_backgroundQueue.empty()) {
+        job = std::move(m_backgroundQueue.front());
+        m_backgroundQueue.pop_front();
+      } else {
+        return; // stopping
+      }
+    }
+    PROFILE_ZONE("Job");
+    job();
+  }
+}
+
+// Execute one queued job of the group on the calling thread (returns false if none is queued)
+bool JobSystem::runOne(Group &group) {
+  std::function<void()> job;
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto it = std::find_if(m_queue.begin(), m_queue.end(), [&group](const Job &queued) {
+      return queued.group == &group;
+    });
+    if (it == m_queue.end())
+      return false;
+    job = std::move(it->run);
+    m_queue.erase(it);
+  }
+  PROFILE_ZONE("Job");
+  job();
+  return true;
+}
+
+void JobSystem::submit(std::function<void()> job, Group *group) {
+  if (group) {
+    group->pending.fetch_add(1, std::memory_order_relaxed);
+    job = [inner = std::move(job), group] {
+      inner();
+      group->pending.fetch_sub(1, std::memory_order_acq_rel);
+    };
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_queue.push_back({std::move(job), group});
+  }
+  m_condition.notify_one();
+}
+
+void JobSystem::submitBackground(std::function<void()> job) {
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_backgroundQueue.push_back(std::move(job));
+  }
+  m_condition.notify_one();
+}
+
+void JobSystem::wait(Group &group) {
+  while (group.pending.load(std::memory_order_acquire) > 0) {
+    if (!runOne(group))
+      std::this_thread::yield();
+  }
+}
+
+void JobSystem::parallelFor(uint32_t count, uint32_t grain, const std::function<void(uint32_t, uint32_t)> &fn) {
+  if (count == 0)
+    return;
+  if (grain == 0)
+    grain = 1;
+
+  // Small ranges are not worth the queue round trip
+  if (count <= grain) {
+    fn(0, count);
+    return;
+  }
+
+  Group group;
+  for (uint32_t begin = 0; begin < count; begin += grain) {
+    uint32_t end = begin + grain < count ? begin + grain : count;
+    submit([&fn, begin, end] { fn(begin, end); }, &group);
+  }
+  wait(group);
+}
+
+unsigned int JobSystem::getThreadCount() const { return static_cast<unsigned int>(m_workers.size()) + 1; }
@@ -12,6 +12,8 @@ void LightSystem::destroyLight(Entity entity) {
   m_lights.erase(it, m_lights.end());
 }
 
+void LightSystem::clearLights() { m_lights.clear(); }
+
 const std::vector<Entity> &LightSystem::getLights() const { return m_lights; }
 
 // Upload all light properties to shader uniform array
@@ -19,6 +21,9 @@ void LightSystem::uploadLightsToShader(Shader &shader, ComponentManager &compone
   int index = 0;
 
   for (const Entity &lightEntity : m_lights) {
+    if (index == shader.getMaxLights())
+      break; // light array size of this shader variant
+
     const auto &light = componentManager.get<LightComponent>(lightEntity);
 
     std::string prefix = "lights[" + std::to_string(index) + "]";
@@ -1,16 +1,20 @@
 #include "systems/renderSystem.h"
 #include "components/lightComponent.h"
 #include "components/modelComponent.h"
+#include "components/occluderComponent.h"
+#include "foundation/core/profiler.h"
 #include "foundation/ecs/systemManager.h"
 #include "rendering/resources/material.h"
 #include "rendering/resources/mesh.h"
 #include "rendering/resources/shader.h"
 #include "systems/cameraSystem.h"
+#include "systems/jobSystem.h"
 #include "systems/lightSystem.h"
 #include "systems/resourceSystem.h"
 #include "systems/transformSystem.h"
 #include <algorithm>
-#include <unordered_map>
+#include <cmath>
+#include <functional>
 
 void RenderSystem::insertRenderable(Entity entity) { m_entries.emplace_back(entity); }
 
@@ -18,135 +22,387 @@ void RenderSystem::removeRenderable(Entity entity) {
   m_entries.erase(std::remove(m_entries.begin(), m_entries.end(), entity), m_entries.end());
 }
 
-// renderSystem.cpp - atualizado para usar normal map e ajustar texture units
+void RenderSystem::removeRenderables(const std::unordered_set<Entity> &entities) {
+  m_entries.erase(std::remove_if(m_entries.begin(), m_entries.end(),
+                                 [&entities](Entity entity) { return entities.count(entity) > 0; }),
+                  m_entries.end());
+}
+
+void RenderSystem::clearRenderables() { m_entries.clear(); }
+
+// Frame = extract (parallel) -> occlusion -> record command lists (parallel) -> submit (GL thread)
 void RenderSystem::renderCall(SystemManager &systemManager, EntityManager &entityManager,
                               ComponentManager &componentManager) {
-  auto &renderer = getRenderer();
+  PROFILE_ZONE("RenderCall");
   auto &transformSystem = systemManager.getSystem<TransformSystem>();
   auto &lightSystem = systemManager.getSystem<LightSystem>();
   auto &cameraSystem = systemManager.getSystem<CameraSystem>();
   auto &resourceSystem = systemManager.getSystem<ResourceSystem>();
+  auto &jobSystem = systemManager.getSystem<JobSystem>();
 
   Entity cameraEntity = cameraSystem.getActiveCamera();
   if (cameraEntity == -1)
     return;
 
   const auto &cameraComponent = componentManager.get<CameraComponent>(cameraEntity);
-  glm::mat4 view = cameraSystem.getViewMatrix(cameraComponent);
-  glm::mat4 projection = cameraSystem.getProjMatrix(cameraComponent);
-  glm::vec3 viewPos = cameraComponent.position;
+  FrameConstants frame;
+  frame.view = cameraSystem.getViewMatrix(cameraComponent);
+  frame.projection = cameraSystem.getProjMatrix(cameraComponent);
+  frame.viewPos = cameraComponent.position;
 
-  glm::mat4 lightSpaceMatrix = glm::mat4(1.0f);
-  bool useShadows = false;
-  const auto &lights = lightSystem.getLights();
+  // First directional light casts the shadow map
+  for (const Entity &lightEntity : lightSystem.getLights()) {
+    const auto &light = componentManager.get<LightComponent>(lightEntity);
+    if (light.type == LightType::Directional) {
+      frame.useShadows = true;
+      frame.lightSpaceMatrix = computeLightSpaceMatrix(light.direction);
+      break;
+    }
+  }
 
-  // Shadow Pass
-  if (!lights.empty()) {
-    for (const Entity &lightEntity : lights) {
-      const auto &light = componentManager.get<LightComponent>(lightEntity);
+  // Tightest main shader variant for this frame; materials add their own features when recorded
+  frame.shaderFeatures = ShaderFeatures::getLightTier(lightSystem.getLights().size());
+  if (frame.useShadows)
+    frame.shaderFeatures |= ShaderFeatures::Shadows;
+
+  m_stats = RenderStats{};
+  extract(componentManager, resourceSystem, transformSystem, jobSystem, cameraComponent);
+  cullOccluded(componentManager, resourceSystem, jobSystem, frame.projection * frame.view);
+  recordCommands(componentManager, resourceSystem, jobSystem, frame);
+  submitCommands(resourceSystem, lightSystem, componentManager, frame);
+}
+
+// Fixed orthographic light frustum around the scene origin
+glm::mat4 RenderSystem::computeLightSpaceMatrix(const glm::vec3 &direction) const {
+  glm::vec3 sceneCenter = glm::vec3(0.0f);
+  float sceneRadius = 30.0f;
+
+  // Normalize direction and position light far from scene
+  glm::vec3 lightDir = glm::normalize(direction);
+  glm::vec3 lightPos = sceneCenter - lightDir * sceneRadius * 2.0f;
+
+  glm::vec3 up = glm::vec3(0.0f, 1.0f, 0.0f);
+  if (abs(glm::dot(lightDir, up)) > 0.99f) {
+    up = glm::vec3(1.0f, 0.0f, 0.0f);
+  }
+
+  float orthoSize = sceneRadius * 1.5f;
+  glm::mat4 lightProjection = glm::ortho(-orthoSize, orthoSize, -orthoSize, orthoSize, 0.1f, sceneRadius * 4.0f);
+  glm::mat4 lightView = glm::lookAt(lightPos, sceneCenter, up);
+  return lightProjection * lightView;
+}
+
+// Extraction stage: model matrices and LOD selection for every renderable
+void RenderSystem::extract(ComponentManager &componentManager, ResourceSystem &resourceSystem,
+                           TransformSystem &transformSystem, JobSystem &jobSystem, const CameraComponent &camera) {
+  PROFILE_ZONE("Extract");
+  float tanHalfFov = std::tan(glm::radians(camera.fov) * 0.5f);
+  m_modelMatrices.resize(m_entries.size());
+
+  auto extractRange = [&](uint32_t begin, uint32_t end) {
+    PROFILE_ZONE("ExtractChunk");
+    for (uint32_t i = begin; i < end; ++i) {
+      const auto &transform = componentManager.get<TransformComponent>(m_entries[i]);
+      auto &model = componentManager.get<ModelComponent>(m_entries[i]);
+      const Mesh &mesh = resourceSystem.getMesh(model.meshHandle);
+
+      // A streamed-in mesh can have more submeshes than its placeholder had
+      if (model.materialHandles.size() < mesh.getSubmeshes().size())
+        model.materialHandles.resize(mesh.getSubmeshes().size(), 0);
+
+      m_modelMatrices[i] = transformSystem.calculateModelMatrix(transform);
+      float screenSize = projectedSize(mesh, transform, m_modelMatrices[i], camera.position, tanHalfFov);
+      model.lod = selectLod(screenSize, model.lod, mesh.getLodCount());
+    }
+  };
+  jobSystem.parallelFor(static_cast<uint32_t>(m_entries.size()), EngineConfig::RENDER_RECORD_CHUNK_SIZE, extractRange);
+
+  for (const Entity entity : m_entries)
+    m_stats.entitiesPerLod[componentManager.get<ModelComponent>(entity).lod]++;
+}
+
+// Bounding sphere radius over half view height at the sphere's distance
+float RenderSystem::projectedSize(const Mesh &mesh, const TransformComponent &transform, const glm::mat4 &modelMatrix,
+                                  const glm::vec3 &viewPos, float tanHalfFov) {
+  glm::vec3 localCenter = (mesh.getBoundsMin() + mesh.getBoundsMax()) * 0.5f;
+  glm::vec3 center = glm::vec3(modelMatrix * glm::vec4(localCenter, 1.0f));
+  float maxScale =
+      std::max(std::abs(transform.scale.x), std::max(std::abs(transform.scale.y), std::abs(transform.scale.z)));
+  float radius = glm::length(mesh.getBoundsMax() - localCenter) * maxScale;
+
+  float distance = glm::length(center - viewPos);
+  return distance > radius ? radius / (distance * tanHalfFov) : 1.0f;
+}
+
+// Rasterize designated occluders on the CPU, then test each renderable against the depth pyramid.
+// Only the main pass is culled: hidden objects may still cast visible shadows.
+void RenderSystem::cullOccluded(ComponentManager &componentManager, ResourceSystem &resourceSystem,
+                                JobSystem &jobSystem, const glm::mat4 &viewProjection) {
+  m_visible.assign(m_entries.size(), 1);
+  if (!m_occlusionCulling)
+    return;
+
+  PROFILE_ZONE("OcclusionCull");
+
+  m_occlusionCuller.beginFrame(viewProjection);
+  for (size_t i = 0; i < m_entries.size(); ++i) {
+    if (!componentManager.has<OccluderComponent>(m_entries[i]))
+      continue;
+
+    // Occluders need positions on the CPU: a GPU-only mesh maps them back from its mesh cache
+    Mesh &mesh = resourceSystem.getMesh(componentManager.get<ModelComponent>(m_entries[i]).meshHandle);
+    if (!mesh.getPositionData() && !mesh.setResidency(MeshResidency::CpuPositions))
+      continue;
+    for (const auto &submesh : mesh.getSubmeshes())
+      m_occlusionCuller.addOccluder(mesh.getPositionData(), mesh.getPositionStride(),
+                                    mesh.getIndexData() + submesh.indexStart, submesh.indexCount, m_modelMatrices[i]);
+  }
+  m_occlusionCuller.rasterize(&jobSystem);
 
-      if (light.type == LightType::Directional) {
-        useShadows = true;
-        Shader &depthShader = resourceSystem.getShader(1);
+  jobSystem.parallelFor(static_cast<uint32_t>(m_entries.size()), 64, [&](uint32_t begin, uint32_t end) {
+    for (uint32_t i = begin; i < end; ++i) {
+      const Mesh &mesh = resourceSystem.getMesh(componentManager.get<ModelComponent>(m_entries[i]).meshHandle);
+      m_visible[i] = m_occlusionCuller.isVisible(mesh.getBoundsMin(), mesh.getBoundsMax(), m_modelMatrices[i]) ? 1 : 0;
+    }
+  });
+
+  m_stats.occluderTriangles = static_cast<uint32_t>(m_occlusionCuller.getOccluderTriangleCount());
+  m_stats.culledEntities = static_cast<uint32_t>(std::count(m_visible.begin(), m_visible.end(), 0));
+}
+
+// Record stage: every chunk of renderables fills its own shadow and main lists on a worker,
+// lists are then concatenated in chunk order and the main pass is grouped by shader.
+void RenderSystem::recordCommands(ComponentManager &componentManager, ResourceSystem &resourceSystem,
+                                  JobSystem &jobSystem, const FrameConstants &frame) {
+  PROFILE_ZONE("RecordCommands");
+  const uint32_t chunkSize = EngineConfig::RENDER_RECORD_CHUNK_SIZE;
+  const uint32_t chunkCount = static_cast<uint32_t>((m_entries.size() + chunkSize - 1) / chunkSize);
+  const glm::mat4 viewProjection = frame.projection * frame.view;
 
-        glm::vec3 sceneCenter = glm::vec3(0.0f);
-        float sceneRadius = 30.0f;
+  if (m_shadowChunks.size() < chunkCount) {
+    m_shadowChunks.resize(chunkCount);
+    m_mainChunks.resize(chunkCount);
+  }
+
+  jobSystem.parallelFor(chunkCount, 1, [&](uint32_t chunkBegin, uint32_t chunkEnd) {
+    PROFILE_ZONE("RecordChunk");
+    for (uint32_t chunk = chunkBegin; chunk < chunkEnd; ++chunk) {
+      RenderCommandList &shadowList = m_shadowChunks[chunk];
+      RenderCommandList &mainList = m_mainChunks[chunk];
+      shadowList.clear();
+      mainList.clear();
 
-        // Normalize direction and position light far from scene
-        glm::vec3 lightDir = glm::normalize(light.direction);
-        glm::vec3 lightPos = sceneCenter - lightDir * sceneRadius * 2.0f;
+      uint32_t end = std::min<uint32_t>((chunk + 1) * chunkSize, static_cast<uint32_t>(m_entries.size()));
+      for (uint32_t i = chunk * chunkSize; i < end; ++i) {
+        const auto &model = componentManager.get<ModelComponent>(m_entries[i]);
+        const Mesh &mesh = resourceSystem.getMesh(model.meshHandle);
+        const auto &submeshes = mesh.getSubmeshes();
+        const glm::mat4 &modelMatrix = m_modelMatrices[i];
 
-        glm::vec3 up = glm::vec3(0.0f, 1.0f, 0.0f);
-        if (abs(glm::dot(lightDir, up)) > 0.99f) {
-          up = glm::vec3(1.0f, 0.0f, 0.0f);
+        if (frame.useShadows) {
+          for (const auto &submesh : submeshes) {
+            DrawCommand command;
+            command.shaderHandle = 1;
+            command.mesh = &mesh;
+            command.range = submesh.getLod(model.lod);
+            command.model = modelMatrix;
+            shadowList.draws.push_back(command);
+          }
         }
 
-        float orthoSize = sceneRadius * 1.5f;
-        glm::mat4 lightProjection = glm::ortho(-orthoSize, orthoSize, -orthoSize, orthoSize, 0.1f, sceneRadius * 4.0f);
-        glm::mat4 lightView = glm::lookAt(lightPos, sceneCenter, up);
-        lightSpaceMatrix = lightProjection * lightView;
+        if (!m_visible[i])
+          continue;
 
-        depthShader.use();
-        depthShader.setMat4("lightSpaceMatrix", lightSpaceMatrix);
+        glm::mat4 mvp = viewProjection * modelMatrix;
+        glm::mat3 normalMatrix = glm::mat3(glm::transpose(glm::inverse(modelMatrix)));
 
-        renderer.beginShadowPass();
-        for (const Entity &entity : m_entries) {
-          const auto &transform = componentManager.get<TransformComponent>(entity);
-          const auto &model = componentManager.get<ModelComponent>(entity);
-          const Mesh &mesh = resourceSystem.getMesh(model.meshHandle);
+        for (size_t s = 0; s < submeshes.size(); ++s) {
+          const Material &material = resourceSystem.getMaterial(model.materialHandles[s]);
 
-          glm::mat4 modelMatrix = transformSystem.calculateModelMatrix(transform);
-          depthShader.setMat4("model", modelMatrix);
-          renderer.drawMesh(mesh);
+          DrawCommand command;
+          command.shaderHandle = material.getShaderHandle();
+          command.shaderFeatures =
+              frame.shaderFeatures | (material.hasNormalMap() ? ShaderFeatures::NormalMap : 0u);
+          command.mesh = &mesh;
+          command.range = submeshes[s].getLod(model.lod);
+          command.material = &material;
+          command.model = modelMatrix;
+          command.mvp = mvp;
+          command.normalMatrix = normalMatrix;
+          mainList.draws.push_back(command);
         }
-        renderer.endShadowPass();
+      }
+    }
+  });
 
-        break;
+  m_shadowCommands.clear();
+  m_mainCommands.clear();
+  for (uint32_t chunk = 0; chunk < chunkCount; ++chunk) {
+    m_shadowCommands.append(m_shadowChunks[chunk]);
+    m_mainCommands.append(m_mainChunks[chunk]);
+  }
+
+  // Variants are resolved here, on the render thread: requesting a new one starts its build.
+  // Runs of draws share a material, so consecutive lookups mostly repeat.
+  {
+    PROFILE_ZONE("ResolveShaderVariants");
+    uint64_t resolvedKey = ~0ull;
+    uint32_t resolvedShader = 0;
+    for (DrawCommand &command : m_mainCommands.draws) {
+      uint64_t key = (static_cast<uint64_t>(command.shaderHandle) << 32) | command.shaderFeatures;
+      if (key != resolvedKey) {
+        resolvedKey = key;
+        resolvedShader = resourceSystem.getShaderVariant(command.shaderHandle, command.shaderFeatures);
       }
+      command.shaderHandle = resolvedShader;
     }
   }
 
-  // Main Render Pass - Group by shader for efficiency
-  // Build map: shaderHandle -> vector of (entity, submeshIndex)
-  std::unordered_map<uint32_t, std::vector<std::pair<Entity, size_t>>> renderBatches;
+  // Group by shader, then by material (equal materials share one block, so their textures are bound once),
+  // then by shared mesh so repeated draws of one mesh end up adjacent (instancing candidates).
+  // Stable keeps submission order within a group.
+  PROFILE_ZONE("SortCommands");
+  std::stable_sort(m_mainCommands.draws.begin(), m_mainCommands.draws.end(),
+                   [](const DrawCommand &a, const DrawCommand &b) {
+                     if (a.shaderHandle != b.shaderHandle)
+                       return a.shaderHandle < b.shaderHandle;
+                     if (a.material != b.material)
+                       return std::less<const Material *>()(a.material, b.material);
+                     return std::less<const Mesh *>()(a.mesh, b.mesh);
+                   });
+}
+
+// Submit stage: replay recorded lists into OpenGL, nothing but state changes and draws
+void RenderSystem::submitCommands(ResourceSystem &resourceSystem, LightSystem &lightSystem,
+                                  ComponentManager &componentManager, const FrameConstants &frame) {
+  auto &renderer = getRenderer();
+
+  // Shadow Pass
+  if (frame.useShadows) {
+    PROFILE_ZONE("ShadowPass");
+    Shader &depthShader = resourceSystem.getShader(1);
+    depthShader.use();
+    depthShader.setMat4("lightSpaceMatrix", frame.lightSpaceMatrix);
 
-  for (const Entity entity : m_entries) {
-    const auto &model = componentManager.get<ModelComponent>(entity);
-    const Mesh &mesh = resourceSystem.getMesh(model.meshHandle);
-    const auto &submeshes = mesh.getSubmeshes();
+    renderer.beginShadowPass();
+    const Mesh *decodeMesh = nullptr;
+    for (const DrawCommand &command : m_shadowCommands.draws) {
+      depthShader.setMat4("model", command.model);
+      if (command.mesh != decodeMesh) {
+        decodeMesh = command.mesh;
+        setPositionDecode(depthShader, *decodeMesh);
+      }
+      renderer.drawRange(*command.mesh, command.range);
 
-    for (size_t i = 0; i < submeshes.size(); ++i) {
-      const Material &material = resourceSystem.getMaterial(model.materialHandles[i]);
-      uint32_t shaderHandle = material.getShaderHandle();
-      renderBatches[shaderHandle].emplace_back(entity, i);
+      m_stats.shadowTriangles += command.range.indexCount / 3;
+      m_stats.drawCalls++;
     }
+    renderer.endShadowPass();
   }
 
-  // Render grouped by shader
-  for (auto &[shaderHandle, batch] : renderBatches) {
-    Shader &shader = resourceSystem.getShader(shaderHandle);
-    shader.use();
+  // Main Render Pass
+  PROFILE_ZONE("MainPass");
+  renderer.getGpuTimer().begin(GpuPass::Main);
+  Shader *shader = nullptr;
+  uint32_t currentShader = 0;
+  bool useNormalMap = false;
+  const Material *boundMaterial = nullptr;
+  const Mesh *batchMesh = nullptr;
+  const Mesh *decodeMesh = nullptr;
+  uint32_t batchStart = 0;
 
-    // Set per-frame uniforms once per shader
-    shader.setMat4("view", view);
-    shader.setMat4("projection", projection);
-    shader.setVec3("viewPos", viewPos);
-    shader.setMat4("lightSpaceMatrix", lightSpaceMatrix);
-    shader.setInt("useShadows", useShadows ? 1 : 0);
+  for (const DrawCommand &command : m_mainCommands.draws) {
+    if (!shader || command.shaderHandle != currentShader) {
+      currentShader = command.shaderHandle;
+      shader = &resourceSystem.getShader(currentShader);
+      shader->use();
 
-    // shadowMap agora em outra texture unit (ex: 4)
-    shader.setTex("shadowMap", renderer.getDepthMap(), 4);
+      // Set per-frame uniforms once per shader
+      shader->setMat4("view", frame.view);
+      shader->setMat4("projection", frame.projection);
+      shader->setVec3("viewPos", frame.viewPos);
+      // Variants without a feature have no uniforms for it (the full shader has them all)
+      const uint32_t features = shader->getFeatures();
+      useNormalMap = (features & ShaderFeatures::NormalMap) != 0;
+      if (features & ShaderFeatures::Shadows) {
+        shader->setMat4("lightSpaceMatrix", frame.lightSpaceMatrix);
+        shader->setInt("useShadows", frame.useShadows ? 1 : 0);
 
-    lightSystem.uploadLightsToShader(shader, componentManager);
+        // Shadow map lives on texture unit 4, after the material maps
+        shader->setTex("shadowMap", renderer.getDepthMap(), 4);
+      }
 
-    // Render all submeshes using this shader
-    for (const auto &[entity, submeshIndex] : batch) {
-      const auto &transform = componentManager.get<TransformComponent>(entity);
-      const auto &model = componentManager.get<ModelComponent>(entity);
-      const Mesh &mesh = resourceSystem.getMesh(model.meshHandle);
-      const Material &material = resourceSystem.getMaterial(model.materialHandles[submeshIndex]);
+      lightSystem.uploadLightsToShader(*shader, componentManager);
+      decodeMesh = nullptr;
+      boundMaterial = nullptr;
+    }
 
-      glm::mat4 modelMatrix = transformSystem.calculateModelMatrix(transform);
-      glm::mat4 MVP = projection * view * modelMatrix;
-      glm::mat3 normalMatrix = glm::mat3(glm::transpose(glm::inverse(modelMatrix)));
+    // Set per-object uniforms
+    shader->setMat4("MVP", command.mvp);
+    shader->setMat4("model", command.model);
+    shader->setMat3("normalMatrix", command.normalMatrix);
+    if (command.mesh != decodeMesh) {
+      decodeMesh = command.mesh;
+      setPositionDecode(*shader, *decodeMesh);
+    }
 
-      // Set per-object uniforms
-      shader.setMat4("MVP", MVP);
-      shader.setMat4("model", modelMatrix);
-      shader.setMat3("normalMatrix", normalMatrix);
+    // Set material properties once per run of draws sharing the material
+    const Material &material = *command.material;
+    if (&material != boundMaterial) {
+      boundMaterial = &material;
+      resourceSystem.markMaterialUsed(material);
+      shader->setTex("material.diffuse", material.getDiffuse(), 0);
+      shader->setTex("material.specular", material.getSpecular(), 1);
+      if (useNormalMap) {
+        shader->setTex("material.normal", material.getNormal(), 2);
+        // Only the full shader has the switch; variants with the feature are only picked for normal mapped materials
+        shader->setInt("hasNormalMap", material.hasNormalMap() ? 1 : 0);
+      }
+      shader->setTex("material.emission", material.getEmission(), 3);
+      shader->setFloat("material.shininess", material.getShininess());
+    }
 
-      // Set material properties
-      shader.setTex("material.diffuse", material.getDiffuse(), 0);
-      shader.setTex("material.specular", material.getSpecular(), 1);
-      shader.setTex("material.normal", material.getNormal(), 2);
-      shader.setTex("material.emission", material.getEmission(), 3);
-      shader.setFloat("material.shininess", material.getShininess());
+    renderer.drawRange(*command.mesh, command.range);
 
-      renderer.drawSubmesh(mesh, mesh.getSubmeshes()[submeshIndex]);
+    if (command.mesh != batchMesh || command.range.indexStart != batchStart) {
+      batchMesh = command.mesh;
+      batchStart = command.range.indexStart;
+      m_stats.meshBatches++;
     }
+    m_stats.triangles += command.range.indexCount / 3;
+    m_stats.drawCalls++;
   }
+  renderer.getGpuTimer().end(GpuPass::Main);
+}
+
+// Dequantization of the mesh's packed positions (identity for float vertices)
+void RenderSystem::setPositionDecode(const Shader &shader, const Mesh &mesh) {
+  shader.setVec3("positionScale", mesh.getPositionScale());
+  shader.setVec3("positionOffset", mesh.getPositionOffset());
+}
+
+uint32_t RenderSystem::selectLod(float screenSize, uint32_t currentLod, uint32_t lodCount) {
+  if (lodCount <= 1)
+    return 0;
+
+  uint32_t lod = std::min(currentLod, lodCount - 1);
+
+  // Coarser only once clearly below the threshold, finer only once clearly above
+  while (lod + 1 < lodCount &&
+         screenSize < EngineConfig::LOD_SCREEN_THRESHOLDS[lod] * (1.0f - EngineConfig::LOD_HYSTERESIS))
+    lod++;
+  while (lod > 0 && screenSize > EngineConfig::LOD_SCREEN_THRESHOLDS[lod - 1] * (1.0f + EngineConfig::LOD_HYSTERESIS))
+    lod--;
+
+  return lod;
 }
 
 Renderer &RenderSystem::getRenderer() { return m_renderer; }
 
+const RenderStats &RenderSystem::getStats() const { return m_stats; }
+
+void RenderSystem::setOcclusionCulling(bool enabled) { m_occlusionCulling = enabled; }
+
+bool RenderSystem::isOcclusionCullingEnabled() const { return m_occlusionCulling; }
+
 const std::vector<Entity> &RenderSystem::getRenderQueue() const { return m_entries; }
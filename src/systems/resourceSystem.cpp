@@ -1,19 +1,204 @@
 #include "systems/resourceSystem.h"
+#include "foundation/core/assetPack.h"
+#include "foundation/core/config.h"
+#include "foundation/core/fileWatcher.h"
+#include "foundation/core/profiler.h"
+#include "rendering/resources/gltfLoader.h"
 #include "rendering/resources/material.h"
 #include "rendering/resources/mesh.h"
 #include "rendering/resources/shader.h"
+#include "rendering/resources/textureImporter.h"
+#include "systems/jobSystem.h"
+#include <algorithm>
+#include <deque>
+#include <filesystem>
 #include <iostream>
+#include <mutex>
+
+// A finished background load: either a mesh for a mesh handle or a decoded image for a texture name
+struct ResourceSystem::UploadQueue {
+  struct Load {
+    uint32_t meshHandle = 0;
+    std::unique_ptr<Mesh> mesh;
+    GLuint texture = 0;
+    TextureImage image;
+  };
+
+  std::mutex mutex;
+  std::deque<Load> ready;
+
+  void push(Load load) {
+    std::lock_guard<std::mutex> lock(mutex);
+    ready.push_back(std::move(load));
+  }
+};
+
+struct ResourceSystem::TextureStream {
+  GLuint texture = 0;
+  TextureImage image;
+  int level = 0; // level being uploaded, counts down to 0
+  int row = 0;   // next row of that level
+};
+
+namespace {
+// Unit cube shown in place of meshes that are still loading
+std::unique_ptr<Mesh> createPlaceholderMesh() {
+  std::vector<Vertex> vertices;
+  std::vector<uint32_t> indices;
+  for (int axis = 0; axis < 3; ++axis) {
+    for (float sign : {-1.0f, 1.0f}) {
+      glm::vec3 normal(0.0f);
+      normal[axis] = sign;
+      glm::vec3 u(0.0f), v(0.0f);
+      u[(axis + 1) % 3] = 0.5f;
+      v[(axis + 2) % 3] = 0.5f * sign;
+
+      uint32_t base = static_cast<uint32_t>(vertices.size());
+      glm::vec3 center = normal * 0.5f;
+      vertices.push_back({center - u - v, normal, {0.0f, 0.0f}});
+      vertices.push_back({center + u - v, normal, {1.0f, 0.0f}});
+      vertices.push_back({center + u + v, normal, {1.0f, 1.0f}});
+      vertices.push_back({center - u + v, normal, {0.0f, 1.0f}});
+      indices.insert(indices.end(), {base, base + 1, base + 2, base, base + 2, base + 3});
+    }
+  }
+
+  std::vector<Submesh> submeshes(1);
+  submeshes[0].indexStart = 0;
+  submeshes[0].indexCount = static_cast<uint32_t>(indices.size());
+  return std::make_unique<Mesh>(std::move(vertices), std::move(indices), std::move(submeshes));
+}
+} // namespace
 
 // Create default material (handle 0) with PBR fallbacks
-ResourceSystem::ResourceSystem() { m_materials[m_nextMaterial++] = std::make_unique<Material>(); }
+ResourceSystem::ResourceSystem(JobSystem &jobSystem)
+    : m_jobSystem(jobSystem), m_uploads(std::make_shared<UploadQueue>()) {
+  createMaterial();
+  if (EngineConfig::HOT_RELOAD_ENABLED)
+    m_fileWatcher = std::make_unique<FileWatcher>();
+}
 
 // Destructor definition
 ResourceSystem::~ResourceSystem() = default;
 
+// "models/box.obj" and "../bin/models/box.obj" must share one mesh
+std::string ResourceSystem::meshKey(const std::string &path) const {
+  std::error_code error;
+  std::string key = std::filesystem::weakly_canonical(path, error).generic_string();
+  return error ? path : key;
+}
+
 // Mesh management
+
+// "<file>.glb#<mesh index>", as cached by loadGltf
+static bool isGltfMeshPath(const std::string &path) {
+  size_t hash = path.rfind('#');
+  return hash != std::string::npos && hash > 4 && path.compare(hash - 4, 4, ".glb") == 0;
+}
+
 uint32_t ResourceSystem::loadMesh(const std::string &path) {
+  std::string key = meshKey(path);
+  auto cached = m_meshPaths.find(key);
+  if (cached != m_meshPaths.end()) {
+    m_meshes[cached->second].refCount++;
+    return cached->second;
+  }
+
+  // Mesh of a glTF file: load the file, then hand out its cached mesh
+  if (isGltfMeshPath(path)) {
+    std::vector<GltfInstance> instances;
+    if (loadGltf(path.substr(0, path.rfind('#')), instances))
+      for (const GltfInstance &instance : instances)
+        unloadMesh(instance.meshHandle);
+    cached = m_meshPaths.find(key);
+    if (cached != m_meshPaths.end()) {
+      m_meshes[cached->second].refCount++;
+      return cached->second;
+    }
+  }
+
+  PROFILE_ZONE("LoadMesh");
   uint32_t handle = m_nextMesh++;
-  m_meshes[handle] = std::make_unique<Mesh>(path);
+  MeshEntry &entry = m_meshes[handle];
+  entry.mesh = std::make_unique<Mesh>(path, &m_jobSystem);
+  entry.path = key;
+  entry.refCount = 1;
+  m_meshPaths[key] = handle;
+  return handle;
+}
+
+bool ResourceSystem::loadGltf(const std::string &path, std::vector<GltfInstance> &instances) {
+  PROFILE_ZONE("LoadGltf");
+  GltfLoader::Asset asset;
+  if (!GltfLoader::load(path, asset))
+    return false;
+
+  // Meshes of the file by index; each is cached on its own key so instances share it
+  const std::string key = meshKey(path);
+  std::vector<uint32_t> handles(asset.meshes.size(), 0);
+  std::vector<bool> loaded(asset.meshes.size(), false);
+  for (uint32_t i = 0; i < asset.meshes.size(); ++i) {
+    std::string meshPath = key + "#" + std::to_string(i);
+    auto cached = m_meshPaths.find(meshPath);
+    if (cached != m_meshPaths.end() && m_meshes[cached->second].mesh) {
+      handles[i] = cached->second;
+      loaded[i] = true;
+      continue;
+    }
+    std::unique_ptr<Mesh> mesh = GltfLoader::createMesh(asset, i);
+    if (!mesh) {
+      std::cerr << "[ResourceSystem] glTF mesh " << i << " of " << path << " has no triangles\n";
+      continue;
+    }
+    uint32_t handle = m_nextMesh++;
+    MeshEntry &entry = m_meshes[handle];
+    entry.mesh = std::move(mesh);
+    entry.path = meshPath;
+    entry.releasedFrame = m_frame; // unreferenced until an instance uses it
+    m_meshPaths[meshPath] = handle;
+    handles[i] = handle;
+    loaded[i] = true;
+  }
+
+  for (const GltfLoader::Instance &instance : asset.instances) {
+    if (!loaded[instance.mesh])
+      continue;
+    m_meshes[handles[instance.mesh]].refCount++;
+    instances.push_back({instance.name, handles[instance.mesh], instance.world});
+  }
+  return true;
+}
+
+uint32_t ResourceSystem::loadMeshAsync(const std::string &path) {
+  std::string key = meshKey(path);
+  auto cached = m_meshPaths.find(key);
+  if (cached != m_meshPaths.end()) {
+    m_meshes[cached->second].refCount++;
+    return cached->second;
+  }
+  if (isGltfMeshPath(path))
+    return loadMesh(path); // glTF files load synchronously
+
+  uint32_t handle = m_nextMesh++;
+  MeshEntry &entry = m_meshes[handle];
+  entry.path = key;
+  entry.refCount = 1;
+  m_meshPaths[key] = handle;
+
+  if (!m_placeholderMesh)
+    m_placeholderMesh = createPlaceholderMesh();
+
+  // Parse/import (or map the mesh cache) on a worker; the GPU upload waits for processUploads
+  m_pendingLoads++;
+  JobSystem *jobSystem = &m_jobSystem;
+  m_jobSystem.submitBackground([uploads = m_uploads, handle, path, jobSystem] {
+    PROFILE_ZONE("LoadMeshAsync");
+    UploadQueue::Load load;
+    load.meshHandle = handle;
+    load.mesh = std::make_unique<Mesh>();
+    load.mesh->load(path, jobSystem);
+    uploads->push(std::move(load));
+  });
   return handle;
 }
 
@@ -24,58 +209,454 @@ Mesh &ResourceSystem::getMesh(uint32_t handle) {
     static Mesh fallback;
     return fallback;
   }
-  return *it->second;
+  if (!it->second.mesh)
+    return *m_placeholderMesh;
+  return *it->second.mesh;
 }
 
+bool ResourceSystem::isMeshReady(uint32_t handle) const {
+  auto it = m_meshes.find(handle);
+  return it != m_meshes.end() && it->second.mesh != nullptr;
+}
+
+// Drop one reference
 void ResourceSystem::unloadMesh(uint32_t handle) {
-  if (m_meshes.erase(handle) == 0) {
+  auto it = m_meshes.find(handle);
+  if (it == m_meshes.end()) {
     std::cerr << "[ResourceSystem] Failed to unload mesh " << handle << "\n";
+    return;
+  }
+  if (--it->second.refCount > 0)
+    return;
+
+  // Kept (or, if still loading, finished) for a later loadMesh until enforceBudgets evicts it
+  it->second.releasedFrame = m_frame;
+}
+
+uint32_t ResourceSystem::getMeshRefCount(uint32_t handle) const {
+  auto it = m_meshes.find(handle);
+  return it != m_meshes.end() ? it->second.refCount : 0;
+}
+
+size_t ResourceSystem::getMeshCount() const { return m_meshes.size(); }
+
+void ResourceSystem::retainMesh(uint32_t handle, uint32_t count) {
+  auto it = m_meshes.find(handle);
+  if (it == m_meshes.end()) {
+    std::cerr << "[ResourceSystem] Failed to retain mesh " << handle << "\n";
+    return;
   }
+  it->second.refCount += count;
+}
+
+const std::string &ResourceSystem::getMeshPath(uint32_t handle) const {
+  static const std::string none;
+  auto it = m_meshes.find(handle);
+  return it != m_meshes.end() ? it->second.path : none;
+}
+
+// Texture cache key: the same image used as color and as normal map is imported twice
+static std::string textureKey(const std::string &path, TextureUsage usage) {
+  return usage == TextureUsage::Normal ? path + "#normal" : path;
 }
 
 // Texture management (cached)
-GLuint ResourceSystem::loadTexture(const std::string &path) {
-  auto it = m_textures.find(path);
-  if (it != m_textures.end())
+std::string ResourceSystem::getTexturePath(GLuint texture) const {
+  auto it = m_textureEntries.find(texture);
+  return it != m_textureEntries.end() ? it->second.path : std::string();
+}
+
+GLuint ResourceSystem::loadTexture(const std::string &path, TextureUsage usage) {
+  std::string key = textureKey(path, usage);
+  auto it = m_textures.find(key);
+  if (it != m_textures.end()) {
+    touchTexture(it->second);
     return it->second;
+  }
+
+  PROFILE_ZONE("LoadTexture");
+  TextureImage image;
+  if (!Material::decodeTexture(path, image, usage, &m_jobSystem)) {
+    unsigned char magenta[3] = {255, 0, 255};
+    return addTexture(key, RenderBackend::get().createTexture2D(1, 1, TextureFormat::RGB8, magenta, false), path,
+                      usage, sizeof(magenta));
+  }
+
+  // A single uncompressed level gets its mip chain generated on the GPU (a third more)
+  size_t bytes = image.getTotalBytes();
+  if (image.getLevelCount() == 1 && !isCompressedFormat(image.format))
+    bytes += bytes / 3;
+  return addTexture(key, Material::uploadTexture(image), path, usage, bytes);
+}
+
+GLuint ResourceSystem::addTexture(const std::string &key, GLuint texture, const std::string &path,
+                                  TextureUsage usage, size_t gpuBytes) {
+  m_textures[key] = texture;
+  TextureEntry &entry = m_textureEntries[texture];
+  entry.path = path;
+  entry.usage = usage;
+  entry.gpuBytes = gpuBytes;
+  entry.lastUsedFrame = m_frame;
+  watchFile(TextureImporter::findFile(path, usage), {0, texture, path, usage});
+  return texture;
+}
+
+GLuint ResourceSystem::loadTextureAsync(const std::string &path, TextureUsage usage) {
+  std::string key = textureKey(path, usage);
+  auto it = m_textures.find(key);
+  if (it != m_textures.end()) {
+    touchTexture(it->second);
+    return it->second;
+  }
 
-  GLuint texture = Material::loadTexture(path);
-  if (texture != 0)
-    m_textures[path] = texture;
+  // Neutral gray for color, flat tangent-space normal for normal maps
+  GLuint texture = Material::createFallbackTexture(usage == TextureUsage::Normal
+                                                       ? std::array<unsigned char, 3>{128, 128, 255}
+                                                       : std::array<unsigned char, 3>{128, 128, 128});
+  addTexture(key, texture, path, usage, 3);
 
+  submitTextureDecode(texture, path, usage);
   return texture;
 }
 
+// File IO, decode, mip chain and block compression (or the texture cache) on a worker;
+// the texture name is respecified on upload
+void ResourceSystem::submitTextureDecode(GLuint texture, const std::string &path, TextureUsage usage) {
+  m_pendingLoads++;
+  JobSystem *jobSystem = &m_jobSystem;
+  m_jobSystem.submitBackground([uploads = m_uploads, texture, path, usage, jobSystem] {
+    PROFILE_ZONE("DecodeTexture");
+    UploadQueue::Load load;
+    load.texture = texture;
+    Material::decodeTexture(path, load.image, usage, jobSystem);
+    uploads->push(std::move(load));
+  });
+}
+
+// Drain finished loads in completion order, then stream texture levels, until the byte or time budget
+// of this frame is spent
+void ResourceSystem::processUploads() {
+  finishShaderBuilds();
+  if (m_pendingLoads == 0 && m_textureStreams.empty())
+    return;
+
+  PROFILE_ZONE("AssetUploads");
+  const uint64_t start = Profiler::now();
+  size_t bytes = 0;
+
+  for (uint32_t uploaded = 0;; ++uploaded) {
+    if (uploaded > 0 && (bytes >= EngineConfig::ASSET_UPLOAD_BUDGET_BYTES ||
+                         (Profiler::now() - start) * 1e-6 >= EngineConfig::ASSET_UPLOAD_BUDGET_MS))
+      break;
+
+    UploadQueue::Load load;
+    {
+      std::lock_guard<std::mutex> lock(m_uploads->mutex);
+      if (m_uploads->ready.empty())
+        break;
+      load = std::move(m_uploads->ready.front());
+      m_uploads->ready.pop_front();
+    }
+    m_pendingLoads--;
+
+    if (load.mesh) {
+      auto it = m_meshes.find(load.meshHandle);
+      if (it == m_meshes.end())
+        continue; // unloaded while loading
+
+      load.mesh->upload();
+      bytes += load.mesh->getUploadBytes();
+      it->second.mesh = std::move(load.mesh);
+      continue;
+    }
+
+    // Evicted again before its image arrived: stays a placeholder until used
+    auto entry = m_textureEntries.find(load.texture);
+    if (entry != m_textureEntries.end() && entry->second.evicted)
+      continue;
+
+    if (load.image.isLoaded()) {
+      // A reload supersedes the levels still streaming into the same name
+      m_textureStreams.erase(std::remove_if(m_textureStreams.begin(), m_textureStreams.end(),
+                                            [&](const auto &stream) { return stream->texture == load.texture; }),
+                             m_textureStreams.end());
+
+      // Storage now, texels over the next frames; the placeholder is replaced by the coarsest level
+      auto stream = std::make_unique<TextureStream>();
+      stream->texture = load.texture;
+      stream->image = std::move(load.image);
+      stream->level = stream->image.getLevelCount() - 1;
+      RenderBackend::get().allocateTexture2D(stream->texture, stream->image.width, stream->image.height,
+                                             stream->image.format, stream->image.getLevelCount());
+      if (entry != m_textureEntries.end())
+        entry->second.gpuBytes = stream->image.getTotalBytes();
+      m_textureStreams.push_back(std::move(stream));
+    } else {
+      // Decode failed: same magenta as the synchronous path
+      unsigned char magenta[3] = {255, 0, 255};
+      RenderBackend::get().updateTexture2D(load.texture, 1, 1, TextureFormat::RGB8, magenta, false);
+      if (entry != m_textureEntries.end())
+        entry->second.gpuBytes = sizeof(magenta);
+    }
+  }
+
+  streamTextures(start, bytes);
+}
+
+// Upload row bands of the pending texture levels through the backend staging ring
+void ResourceSystem::streamTextures(uint64_t start, size_t &bytes) {
+  RenderBackend &backend = RenderBackend::get();
+
+  while (!m_textureStreams.empty()) {
+    if ((Profiler::now() - start) * 1e-6 >= EngineConfig::ASSET_UPLOAD_BUDGET_MS)
+      break;
+
+    TextureStream &stream = *m_textureStreams.front();
+    const TextureImage &image = stream.image;
+    const int width = image.getLevelWidth(stream.level);
+    const int height = image.getLevelHeight(stream.level);
+    // Bands are whole rows, or whole 4-row block rows for compressed formats
+    const int unit = getTextureRowGranularity(image.format);
+    const size_t unitBytes = getTextureLevelBytes(image.format, width, unit);
+
+    const size_t budgetBytes = EngineConfig::ASSET_UPLOAD_BUDGET_BYTES;
+    const size_t budget = std::min(bytes < budgetBytes ? budgetBytes - bytes : 0, backend.getTextureStagingSpace());
+    const int units = static_cast<int>(budget / unitBytes);
+    const int rows = std::min(units * unit, height - stream.row);
+    if (rows <= 0)
+      break;
+
+    const unsigned char *pixels = image.getLevel(stream.level) + (stream.row / unit) * unitBytes;
+    if (!backend.uploadTextureRows(stream.texture, stream.level, stream.row, width, rows, image.format, pixels))
+      break;
+    bytes += getTextureLevelBytes(image.format, width, rows);
+    stream.row += rows;
+
+    if (stream.row < height)
+      continue;
+
+    // Level complete: sample it from now on
+    backend.setTextureBaseLevel(stream.texture, stream.level);
+    if (stream.level == 0) {
+      m_textureStreams.pop_front();
+    } else {
+      stream.level--;
+      stream.row = 0;
+    }
+  }
+}
+
+uint32_t ResourceSystem::getPendingLoadCount() const {
+  return m_pendingLoads + static_cast<uint32_t>(m_textureStreams.size() + m_pendingShaders.size());
+}
+
+void ResourceSystem::enforceBudgets() {
+  ResourceMemoryStats memory = getMemoryStats();
+  if (memory.meshCpuBytes + memory.meshGpuBytes > EngineConfig::MESH_MEMORY_BUDGET_BYTES)
+    evictMeshes(memory.meshCpuBytes + memory.meshGpuBytes, EngineConfig::MESH_MEMORY_BUDGET_BYTES);
+  if (memory.textureGpuBytes > EngineConfig::TEXTURE_MEMORY_BUDGET_BYTES)
+    evictTextures(memory.textureGpuBytes, EngineConfig::TEXTURE_MEMORY_BUDGET_BYTES);
+  m_frame++;
+}
+
+// Unreferenced meshes, released longest ago first
+void ResourceSystem::evictMeshes(size_t bytes, size_t budget) {
+  PROFILE_ZONE("EvictMeshes");
+  std::vector<std::pair<uint64_t, uint32_t>> candidates; // (released frame, handle)
+  for (const auto &[handle, entry] : m_meshes)
+    if (entry.refCount == 0 && entry.mesh)
+      candidates.emplace_back(entry.releasedFrame, handle);
+  std::sort(candidates.begin(), candidates.end());
+
+  for (const auto &candidate : candidates) {
+    if (bytes <= budget)
+      break;
+    auto it = m_meshes.find(candidate.second);
+    const Mesh &mesh = *it->second.mesh;
+    bytes -= std::min(bytes, mesh.getCpuBytes() + mesh.getGpuBytes());
+    m_meshPaths.erase(it->second.path);
+    m_meshes.erase(it);
+    m_meshEvictions++;
+  }
+}
+
+// Textures no drawn material used recently, least recently used first; the name stays valid as a placeholder
+void ResourceSystem::evictTextures(size_t bytes, size_t budget) {
+  PROFILE_ZONE("EvictTextures");
+  std::vector<std::pair<uint64_t, GLuint>> candidates; // (last used frame, texture)
+  for (const auto &[texture, entry] : m_textureEntries)
+    if (!entry.evicted && entry.lastUsedFrame + EngineConfig::RESOURCE_EVICTION_MIN_AGE_FRAMES <= m_frame)
+      candidates.emplace_back(entry.lastUsedFrame, texture);
+  std::sort(candidates.begin(), candidates.end());
+
+  RenderBackend &backend = RenderBackend::get();
+  for (const auto &candidate : candidates) {
+    if (bytes <= budget)
+      break;
+    TextureEntry &entry = m_textureEntries[candidate.second];
+    m_textureStreams.erase(std::remove_if(m_textureStreams.begin(), m_textureStreams.end(),
+                                          [&](const auto &stream) { return stream->texture == candidate.second; }),
+                           m_textureStreams.end());
+
+    const std::array<unsigned char, 3> placeholder = entry.usage == TextureUsage::Normal
+                                                         ? std::array<unsigned char, 3>{128, 128, 255}
+                                                         : std::array<unsigned char, 3>{128, 128, 128};
+    backend.updateTexture2D(candidate.second, 1, 1, TextureFormat::RGB8, placeholder.data(), false);
+    bytes -= std::min(bytes, entry.gpuBytes);
+    entry.gpuBytes = placeholder.size();
+    entry.evicted = true;
+    m_textureEvictions++;
+  }
+}
+
+ResourceMemoryStats ResourceSystem::getMemoryStats() const {
+  ResourceMemoryStats memory;
+  for (const auto &[handle, entry] : m_meshes) {
+    if (!entry.mesh)
+      continue;
+    memory.meshCpuBytes += entry.mesh->getCpuBytes();
+    memory.meshGpuBytes += entry.mesh->getGpuBytes();
+    memory.cachedMeshes += entry.refCount == 0 ? 1 : 0;
+  }
+  for (const auto &[texture, entry] : m_textureEntries) {
+    memory.textureGpuBytes += entry.gpuBytes;
+    memory.evictedTextures += entry.evicted ? 1 : 0;
+  }
+  for (const auto &stream : m_textureStreams)
+    memory.textureCpuBytes += stream->image.getTotalBytes();
+  memory.meshEvictions = m_meshEvictions;
+  memory.textureEvictions = m_textureEvictions;
+  return memory;
+}
+
+void ResourceSystem::markMaterialUsed(const Material &material) {
+  for (GLuint texture : {material.getDiffuse(), material.getSpecular(), material.getNormal(), material.getEmission()})
+    touchTexture(texture);
+}
+
+// Any access refreshes the LRU position and brings an evicted texture back
+void ResourceSystem::touchTexture(GLuint texture) {
+  auto it = m_textureEntries.find(texture);
+  if (it == m_textureEntries.end())
+    return;
+  TextureEntry &entry = it->second;
+  entry.lastUsedFrame = m_frame;
+  if (entry.evicted) {
+    entry.evicted = false;
+    submitTextureDecode(texture, entry.path, entry.usage);
+  }
+}
+
+// Packed assets are immutable, only loose files are watched
+void ResourceSystem::watchFile(const std::string &file, const WatchedResource &resource) {
+  if (!m_fileWatcher || file.empty() || AssetPack::get().isOpen())
+    return;
+  m_watchedFiles.emplace(m_fileWatcher->watch(file), resource);
+}
+
+void ResourceSystem::processFileChanges() {
+  if (!m_fileWatcher || m_watchedFiles.empty())
+    return;
+
+  std::vector<std::string> changed;
+  m_fileWatcher->poll(changed);
+  if (changed.empty())
+    return;
+
+  PROFILE_ZONE("HotReload");
+  for (const std::string &file : changed) {
+    auto range = m_watchedFiles.equal_range(file);
+    for (auto it = range.first; it != range.second; ++it) {
+      const WatchedResource &resource = it->second;
+      if (resource.texture != 0) {
+        std::cout << "[ResourceSystem] Reloading texture " << resource.path << std::endl;
+        m_textureEntries[resource.texture].evicted = false;
+        submitTextureDecode(resource.texture, resource.path, resource.usage);
+        continue;
+      }
+
+      auto shader = m_shaders.find(resource.shader);
+      if (shader == m_shaders.end())
+        continue;
+      if (shader->second->reload())
+        std::cout << "[ResourceSystem] Reloaded shader " << file << std::endl;
+      else
+        std::cerr << "[ResourceSystem] Keeping previous program of shader " << resource.shader << std::endl;
+    }
+  }
+}
+
 // Material management
-uint32_t ResourceSystem::createMaterial() {
+uint32_t ResourceSystem::createMaterial(const Material &material) {
+  uint64_t hash = material.getHash();
+  auto [first, last] = m_materialHashes.equal_range(hash);
+  for (auto it = first; it != last; ++it) {
+    MaterialEntry &entry = m_materials[it->second];
+    if (*entry.material == material) {
+      entry.refCount++;
+      return it->second;
+    }
+  }
+
   uint32_t handle = m_nextMaterial++;
-  m_materials[handle] = std::make_unique<Material>();
+  MaterialEntry &entry = m_materials[handle];
+  entry.material = std::make_unique<Material>(material);
+  entry.hash = hash;
+  entry.refCount = 1;
+  m_materialHashes.emplace(hash, handle);
   return handle;
 }
 
-Material &ResourceSystem::getMaterial(uint32_t handle) {
+const Material &ResourceSystem::getMaterial(uint32_t handle) const {
   auto it = m_materials.find(handle);
   if (it == m_materials.end()) {
     std::cerr << "[ResourceSystem] Material handle " << handle << " not found, returning default\n";
-    return *m_materials[0];
+    return *m_materials.at(0).material;
   }
-  return *it->second;
+  return *it->second.material;
 }
 
 void ResourceSystem::unloadMaterial(uint32_t handle) {
-  if (handle == 0) {
-    std::cerr << "[ResourceSystem] Cannot unload default material (handle 0)\n";
+  if (handle == 0)
+    return; // the default material outlives its users
+  auto it = m_materials.find(handle);
+  if (it == m_materials.end()) {
+    std::cerr << "[ResourceSystem] Failed to unload material " << handle << "\n";
     return;
   }
-  if (m_materials.erase(handle) == 0) {
-    std::cerr << "[ResourceSystem] Failed to unload material " << handle << "\n";
+  if (--it->second.refCount > 0)
+    return;
+
+  auto [first, last] = m_materialHashes.equal_range(it->second.hash);
+  for (auto hashed = first; hashed != last; ++hashed) {
+    if (hashed->second == handle) {
+      m_materialHashes.erase(hashed);
+      break;
+    }
+  }
+  m_materials.erase(it);
+}
+
+void ResourceSystem::retainMaterial(uint32_t handle, uint32_t count) {
+  if (handle == 0)
+    return;
+  auto it = m_materials.find(handle);
+  if (it == m_materials.end()) {
+    std::cerr << "[ResourceSystem] Failed to retain material " << handle << "\n";
+    return;
   }
+  it->second.refCount += count;
 }
 
+size_t ResourceSystem::getMaterialCount() const { return m_materials.size(); }
+
 // Shader management
 uint32_t ResourceSystem::loadShader(const std::string &vertexPath, const std::string &fragmentPath) {
+  PROFILE_ZONE("LoadShader");
   uint32_t handle = m_nextShader++;
   m_shaders[handle] = std::make_unique<Shader>(vertexPath.c_str(), fragmentPath.c_str());
+  watchFile(vertexPath, {handle, 0, std::string(), TextureUsage::Color});
+  watchFile(fragmentPath, {handle, 0, std::string(), TextureUsage::Color});
   return handle;
 }
 
@@ -89,8 +670,68 @@ Shader &ResourceSystem::getShader(uint32_t handle) {
   return *it->second;
 }
 
+uint32_t ResourceSystem::getShaderVariant(uint32_t shader, uint32_t features) {
+  auto base = m_shaders.find(shader);
+  if (base == m_shaders.end() || features == base->second->getFeatures())
+    return shader;
+
+  uint64_t key = (static_cast<uint64_t>(shader) << 32) | features;
+  auto cached = m_shaderVariants.find(key);
+  if (cached != m_shaderVariants.end()) {
+    auto variant = m_shaders.find(cached->second);
+    return variant != m_shaders.end() && variant->second->getShaderID() != 0 ? cached->second : shader;
+  }
+
+  PROFILE_ZONE("StartShaderVariant");
+  uint32_t handle = m_nextShader++;
+  const Shader &source = *base->second;
+  m_shaders[handle] = std::make_unique<Shader>(source.getVertexFile().c_str(), source.getFragmentFile().c_str(),
+                                               features, true);
+  m_shaderVariants[key] = handle;
+  watchFile(source.getVertexFile(), {handle, 0, std::string(), TextureUsage::Color});
+  watchFile(source.getFragmentFile(), {handle, 0, std::string(), TextureUsage::Color});
+
+  if (m_shaders[handle]->isPending()) {
+    m_pendingShaders.push_back(handle);
+    return shader;
+  }
+  return m_shaders[handle]->getShaderID() != 0 ? handle : shader;
+}
+
+// Finish background variant builds the driver is done with (a few per frame: without parallel shader compile
+// finishing one waits for its compilation)
+void ResourceSystem::finishShaderBuilds() {
+  uint32_t finished = 0;
+  for (size_t i = 0; i < m_pendingShaders.size() && finished < EngineConfig::SHADER_BUILDS_PER_FRAME;) {
+    auto it = m_shaders.find(m_pendingShaders[i]);
+    if (it != m_shaders.end() && !it->second->update()) {
+      ++i;
+      continue;
+    }
+    finished++;
+    m_pendingShaders.erase(m_pendingShaders.begin() + i);
+  }
+}
+
 void ResourceSystem::unloadShader(uint32_t handle) {
   if (m_shaders.erase(handle) == 0) {
     std::cerr << "[ResourceSystem] Failed to unload shader " << handle << "\n";
+    return;
+  }
+  for (auto it = m_watchedFiles.begin(); it != m_watchedFiles.end();)
+    it = it->second.texture == 0 && it->second.shader == handle ? m_watchedFiles.erase(it) : std::next(it);
+
+  // Variants go with their shader
+  std::vector<uint32_t> variants;
+  for (auto it = m_shaderVariants.begin(); it != m_shaderVariants.end();) {
+    if (it->first >> 32 == handle || it->second == handle) {
+      if (it->second != handle)
+        variants.push_back(it->second);
+      it = m_shaderVariants.erase(it);
+    } else {
+      ++it;
+    }
   }
+  for (uint32_t variant : variants)
+    unloadShader(variant);
 }
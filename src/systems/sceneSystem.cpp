@@ -3,19 +3,55 @@
 #include "components/lightComponent.h"
 #include "components/modelComponent.h"
 #include "components/nameComponent.h"
+#include "components/occluderComponent.h"
 #include "components/transformComponent.h"
+#include "foundation/core/profiler.h"
 #include "rendering/resources/mesh.h"
 #include "systems/cameraSystem.h"
 #include "systems/lightSystem.h"
 #include "systems/renderSystem.h"
 #include "systems/resourceSystem.h"
+#include "systems/transformSystem.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <filesystem>
+#include <map>
 #include <memory>
+#include <unordered_map>
+#include <unordered_set>
 #include <utility>
 
+namespace fs = std::filesystem;
+
+// Asset path as stored in a scene file: relative to the scene's directory
+static std::string toScenePath(const std::string &path, const std::string &directory) {
+  return fs::absolute(path).lexically_normal().lexically_proximate(directory).generic_string();
+}
+
+// Stored asset path back to one relative to the working directory, as the rest of the engine names assets
+static std::string fromScenePath(const std::string &path, const std::string &directory) {
+  fs::path resolved = fs::path(path).is_absolute() ? fs::path(path) : fs::path(directory) / path;
+  return resolved.lexically_normal().lexically_proximate(fs::current_path()).generic_string();
+}
+
+static std::string sceneDirectory(const std::string &scenePath) {
+  return fs::absolute(scenePath).lexically_normal().parent_path().generic_string();
+}
+
 void SceneSystem::destroyEntity(Entity entity) {
   auto &renderSystem = systemManager.getSystem<RenderSystem>();
   renderSystem.removeRenderable(entity);
 
+  // Release the entity's references to its shared mesh and materials
+  if (componentManager.has<ModelComponent>(entity)) {
+    auto &resourceSystem = systemManager.getSystem<ResourceSystem>();
+    const auto &model = componentManager.get<ModelComponent>(entity);
+    resourceSystem.unloadMesh(model.meshHandle);
+    for (uint32_t material : model.materialHandles)
+      resourceSystem.unloadMaterial(material);
+  }
+
   if (componentManager.has<LightComponent>(entity)) {
     auto &lightSystem = systemManager.getSystem<LightSystem>();
     lightSystem.destroyLight(entity);
@@ -29,6 +65,315 @@ void SceneSystem::destroyEntity(Entity entity) {
   entityManager.destroyEntity(entity);
 };
 
+void SceneSystem::destroyEntities(const std::vector<Entity> &entities) {
+  PROFILE_ZONE("DestroyEntities");
+  auto &resourceSystem = systemManager.getSystem<ResourceSystem>();
+  auto &lightSystem = systemManager.getSystem<LightSystem>();
+  auto &cameraSystem = systemManager.getSystem<CameraSystem>();
+  std::unordered_set<Entity> destroyed(entities.begin(), entities.end());
+  systemManager.getSystem<RenderSystem>().removeRenderables(destroyed);
+
+  for (Entity entity : entities) {
+    if (auto *model = componentManager.tryGet<ModelComponent>(entity)) {
+      resourceSystem.unloadMesh(model->meshHandle);
+      for (uint32_t material : model->materialHandles)
+        resourceSystem.unloadMaterial(material);
+    }
+    if (componentManager.has<LightComponent>(entity))
+      lightSystem.destroyLight(entity);
+    if (cameraSystem.getActiveCamera() == entity)
+      cameraSystem.removeActiveCamera();
+    componentManager.removeAll(entity);
+    entityManager.destroyEntity(entity);
+  }
+}
+
+void SceneSystem::clearScene() {
+  PROFILE_ZONE("ClearScene");
+  auto &resourceSystem = systemManager.getSystem<ResourceSystem>();
+  for (Entity entity : entityManager.getEntities()) {
+    if (auto *model = componentManager.tryGet<ModelComponent>(entity)) {
+      resourceSystem.unloadMesh(model->meshHandle);
+      for (uint32_t material : model->materialHandles)
+        resourceSystem.unloadMaterial(material);
+    }
+  }
+
+  // Bulk versions of destroyEntity's per-system removals
+  systemManager.getSystem<RenderSystem>().clearRenderables();
+  systemManager.getSystem<LightSystem>().clearLights();
+  systemManager.getSystem<CameraSystem>().removeActiveCamera();
+  componentManager.clear();
+  entityManager.clear();
+}
+
+bool SceneSystem::saveScene(const std::string &path, SceneFile::Format format) {
+  PROFILE_ZONE("SaveScene");
+  std::vector<Entity> entities(entityManager.getEntities().begin(), entityManager.getEntities().end());
+  std::sort(entities.begin(), entities.end());
+  SceneFile::Data data;
+  captureScene(data, entities, sceneDirectory(path));
+  return SceneFile::write(path, data, format);
+}
+
+bool SceneSystem::loadScene(const std::string &path) {
+  PROFILE_ZONE("LoadScene");
+  SceneFile::Data data;
+  if (!SceneFile::read(path, data))
+    return false;
+
+  clearScene();
+  SceneLoad load;
+  beginSceneLoad(load, std::move(data), sceneDirectory(path));
+  continueSceneLoad(load, SIZE_MAX);
+  endSceneLoad(load);
+  return true;
+}
+
+bool SceneSystem::saveWorld(const std::string &directory, float cellSize) {
+  PROFILE_ZONE("SaveWorld");
+  if (!(cellSize > 0.0f))
+    return false;
+
+  // Entities by cell, in ID order within a cell
+  std::vector<Entity> entities(entityManager.getEntities().begin(), entityManager.getEntities().end());
+  std::sort(entities.begin(), entities.end());
+  std::map<std::pair<int32_t, int32_t>, std::vector<Entity>> cells;
+  for (Entity entity : entities) {
+    if (auto *transform = componentManager.tryGet<TransformComponent>(entity)) {
+      auto x = static_cast<int32_t>(std::floor(transform->position.x / cellSize));
+      auto z = static_cast<int32_t>(std::floor(transform->position.z / cellSize));
+      cells[{x, z}].push_back(entity);
+    }
+  }
+
+  SceneFile::World world;
+  world.cellSize = cellSize;
+  std::string worldDirectory = fs::absolute(directory).lexically_normal().generic_string();
+  for (const auto &[coordinates, cellEntities] : cells) {
+    SceneFile::WorldCell cell;
+    cell.x = coordinates.first;
+    cell.z = coordinates.second;
+    cell.file = "cell_" + std::to_string(cell.x) + "_" + std::to_string(cell.z) + ".scene";
+    cell.entityCount = static_cast<uint32_t>(cellEntities.size());
+
+    SceneFile::Data data;
+    captureScene(data, cellEntities, worldDirectory);
+    if (!SceneFile::write((fs::path(directory) / cell.file).string(), data, SceneFile::Format::Snapshot))
+      return false;
+    world.cells.push_back(std::move(cell));
+  }
+  return SceneFile::writeWorld((fs::path(directory) / SceneFile::WORLD_INDEX_FILE).string(), world);
+}
+
+// Entities renumbered 0..n-1 in the given order; meshes and materials go to the asset tables once per handle
+void SceneSystem::captureScene(SceneFile::Data &data, const std::vector<Entity> &entities,
+                               const std::string &directory) {
+  auto &resourceSystem = systemManager.getSystem<ResourceSystem>();
+  Entity activeCamera = systemManager.getSystem<CameraSystem>().getActiveCamera();
+
+  data.entityCount = static_cast<uint32_t>(entities.size());
+  data.names.assign(entities.size(), SceneFile::NO_STRING);
+
+  std::unordered_map<uint32_t, uint32_t> meshIndices, materialIndices; // handle -> table entry
+  for (uint32_t i = 0; i < data.entityCount; ++i) {
+    Entity entity = entities[i];
+    if (auto *name = componentManager.tryGet<NameComponent>(entity))
+      data.names[i] = data.addString(name->name);
+
+    if (auto *transform = componentManager.tryGet<TransformComponent>(entity)) {
+      data.transformEntities.push_back(i);
+      data.positions.push_back(transform->position);
+      data.rotations.push_back(transform->rotation);
+      data.scales.push_back(transform->scale);
+    }
+
+    auto *model = componentManager.tryGet<ModelComponent>(entity);
+    if (model && !resourceSystem.getMeshPath(model->meshHandle).empty()) {
+      auto [meshIt, newMesh] = meshIndices.try_emplace(model->meshHandle, static_cast<uint32_t>(data.meshes.size()));
+      if (newMesh)
+        data.meshes.push_back(data.addString(toScenePath(resourceSystem.getMeshPath(model->meshHandle), directory)));
+
+      data.modelEntities.push_back(i);
+      data.modelMeshes.push_back(meshIt->second);
+      data.modelMaterialStarts.push_back(static_cast<uint32_t>(data.modelMaterials.size()));
+      data.modelMaterialCounts.push_back(static_cast<uint32_t>(model->materialHandles.size()));
+      for (uint32_t handle : model->materialHandles) {
+        auto [materialIt, newMaterial] =
+            materialIndices.try_emplace(handle, static_cast<uint32_t>(data.materials.size()));
+        if (newMaterial) {
+          const Material &material = resourceSystem.getMaterial(handle);
+          SceneFile::MaterialRecord record;
+          for (size_t slot = 0; slot < static_cast<size_t>(MaterialSlot::Count); ++slot) {
+            uint32_t texture = material.getTexture(static_cast<MaterialSlot>(slot));
+            std::string path = texture == Material::getFallbackTexture(static_cast<MaterialSlot>(slot))
+                                   ? std::string()
+                                   : resourceSystem.getTexturePath(texture);
+            record.textures[slot] = path.empty() ? SceneFile::NO_STRING : data.addString(toScenePath(path, directory));
+          }
+          record.shininess = material.getShininess();
+          data.materials.push_back(record);
+        }
+        data.modelMaterials.push_back(materialIt->second);
+      }
+    }
+
+    if (componentManager.has<OccluderComponent>(entity))
+      data.occluders.push_back(i);
+
+    if (auto *light = componentManager.tryGet<LightComponent>(entity))
+      data.lights.push_back({i, static_cast<uint32_t>(light->type), light->position, light->direction, light->color,
+                             light->intensity, light->ambient, light->constant, light->linear, light->quadratic,
+                             light->cutOff, light->outerCutOff});
+
+    if (auto *camera = componentManager.tryGet<CameraComponent>(entity))
+      data.cameras.push_back({i, entity == activeCamera, camera->position, camera->yaw, camera->pitch, camera->fov,
+                              camera->moveSpeed, camera->mouseSensitivity, camera->smoothFactor});
+  }
+}
+
+// Each distinct asset is requested once here; instantiated models then add their own references
+void SceneSystem::beginSceneLoad(SceneLoad &load, SceneFile::Data data, const std::string &directory) {
+  auto &resourceSystem = systemManager.getSystem<ResourceSystem>();
+  load = SceneLoad();
+  load.data = std::move(data);
+  const SceneFile::Data &scene = load.data;
+
+  std::vector<bool> meshUsed(scene.meshes.size(), false), materialUsed(scene.materials.size(), false);
+  for (uint32_t mesh : scene.modelMeshes)
+    meshUsed[mesh] = true;
+  for (uint32_t material : scene.modelMaterials)
+    materialUsed[material] = true;
+
+  load.meshHandles.assign(scene.meshes.size(), 0);
+  for (size_t i = 0; i < scene.meshes.size(); ++i) {
+    if (!meshUsed[i])
+      continue;
+    load.meshHandles[i] = resourceSystem.loadMeshAsync(fromScenePath(scene.strings[scene.meshes[i]], directory));
+    load.heldMeshes.push_back(load.meshHandles[i]);
+  }
+
+  load.materialHandles.assign(scene.materials.size(), 0);
+  for (size_t i = 0; i < scene.materials.size(); ++i) {
+    if (!materialUsed[i])
+      continue;
+    const SceneFile::MaterialRecord &record = scene.materials[i];
+    Material material;
+    for (size_t slot = 0; slot < static_cast<size_t>(MaterialSlot::Count); ++slot) {
+      if (record.textures[slot] == SceneFile::NO_STRING)
+        continue;
+      TextureUsage usage = slot == static_cast<size_t>(MaterialSlot::Normal) ? TextureUsage::Normal
+                                                                               : TextureUsage::Color;
+      material.setTexture(static_cast<MaterialSlot>(slot),
+                          resourceSystem.loadTextureAsync(fromScenePath(scene.strings[record.textures[slot]], directory),
+                                                          usage));
+    }
+    material.setShininess(record.shininess);
+    load.materialHandles[i] = resourceSystem.createMaterial(material);
+    load.heldMaterials.push_back(load.materialHandles[i]);
+  }
+
+  load.entities.reserve(scene.entityCount);
+  componentManager.reserve<NameComponent>(scene.entityCount);
+  componentManager.reserve<TransformComponent>(scene.transformEntities.size());
+  componentManager.reserve<ModelComponent>(scene.modelEntities.size());
+}
+
+// Pool by pool (entities, names, transforms, models, occluders, lights, cameras), so a model always finds its
+// transform; the cursor counts rows over all pools
+bool SceneSystem::continueSceneLoad(SceneLoad &load, size_t budget) {
+  PROFILE_ZONE("ContinueSceneLoad");
+  auto &resourceSystem = systemManager.getSystem<ResourceSystem>();
+  auto &renderSystem = systemManager.getSystem<RenderSystem>();
+  auto &cameraSystem = systemManager.getSystem<CameraSystem>();
+  const SceneFile::Data &data = load.data;
+  const size_t end = budget > SIZE_MAX - load.cursor ? SIZE_MAX : load.cursor + budget;
+  size_t poolStart = 0;
+
+  // Run fn(row) for the rows of the next pool that fit in the budget
+  auto pool = [&](size_t rows, auto &&fn) {
+    size_t first = poolStart;
+    poolStart += rows;
+    for (; load.cursor < std::min(end, poolStart); ++load.cursor)
+      fn(load.cursor - first);
+  };
+
+  pool(data.entityCount, [&](size_t) { load.entities.push_back(entityManager.createEntity()); });
+
+  pool(data.entityCount, [&](size_t i) {
+    if (data.names[i] != SceneFile::NO_STRING)
+      componentManager.insert<NameComponent>(load.entities[i],
+                                             std::make_unique<NameComponent>(data.strings[data.names[i]]));
+  });
+
+  pool(data.transformEntities.size(), [&](size_t i) {
+    componentManager.insert<TransformComponent>(
+        load.entities[data.transformEntities[i]],
+        std::make_unique<TransformComponent>(data.positions[i], data.rotations[i], data.scales[i]));
+  });
+
+  pool(data.modelEntities.size(), [&](size_t i) {
+    uint32_t meshHandle = load.meshHandles[data.modelMeshes[i]];
+    resourceSystem.retainMesh(meshHandle);
+    const uint32_t *first = data.modelMaterials.data() + data.modelMaterialStarts[i];
+    std::vector<uint32_t> materials(data.modelMaterialCounts[i]);
+    for (size_t m = 0; m < materials.size(); ++m) {
+      materials[m] = load.materialHandles[first[m]];
+      resourceSystem.retainMaterial(materials[m]);
+    }
+
+    Entity entity = load.entities[data.modelEntities[i]];
+    if (!componentManager.has<TransformComponent>(entity)) // rendering needs one
+      componentManager.insert<TransformComponent>(entity, std::make_unique<TransformComponent>());
+    componentManager.insert<ModelComponent>(entity, std::make_unique<ModelComponent>(meshHandle, std::move(materials)));
+    renderSystem.insertRenderable(entity);
+  });
+
+  pool(data.occluders.size(), [&](size_t i) {
+    componentManager.insert<OccluderComponent>(load.entities[data.occluders[i]], std::make_unique<OccluderComponent>());
+  });
+
+  pool(data.lights.size(), [&](size_t i) {
+    const SceneFile::LightRecord &record = data.lights[i];
+    Entity entity = load.entities[record.entity];
+    componentManager.insert<LightComponent>(
+        entity, std::make_unique<LightComponent>(static_cast<LightType>(record.type), record.position,
+                                                 record.direction, record.color, record.intensity, record.ambient,
+                                                 record.constant, record.linear, record.quadratic, record.cutOff,
+                                                 record.outerCutOff));
+    systemManager.getSystem<LightSystem>().createLight(entity);
+  });
+
+  pool(data.cameras.size(), [&](size_t i) {
+    const SceneFile::CameraRecord &record = data.cameras[i];
+    auto camera = std::make_unique<CameraComponent>();
+    camera->position = record.position;
+    camera->yaw = record.yaw;
+    camera->pitch = record.pitch;
+    camera->fov = record.fov;
+    camera->moveSpeed = record.moveSpeed;
+    camera->mouseSensitivity = record.mouseSensitivity;
+    camera->smoothFactor = record.smoothFactor;
+    cameraSystem.updateFront(*camera);
+    Entity entity = load.entities[record.entity];
+    componentManager.insert<CameraComponent>(entity, std::move(camera));
+    if (record.active)
+      cameraSystem.setActiveCamera(entity);
+  });
+
+  return load.cursor >= poolStart;
+}
+
+void SceneSystem::endSceneLoad(SceneLoad &load) {
+  auto &resourceSystem = systemManager.getSystem<ResourceSystem>();
+  for (uint32_t mesh : load.heldMeshes)
+    resourceSystem.unloadMesh(mesh);
+  for (uint32_t material : load.heldMaterials)
+    resourceSystem.unloadMaterial(material);
+  load.heldMeshes.clear();
+  load.heldMaterials.clear();
+}
+
 void SceneSystem::createCameraEntity(glm::vec3 position, float yaw, float pitch, float fov) {
   auto &cameraSystem = systemManager.getSystem<CameraSystem>();
   Entity newCamera = entityManager.createEntity();
@@ -46,12 +391,12 @@ void SceneSystem::createCameraEntity(glm::vec3 position, float yaw, float pitch,
 }
 
 void SceneSystem::createModelEntity(const std::string name, const std::string &modelPath, glm::vec3 position,
-                                    glm::vec3 rotation, glm::vec3 scale) {
+                                    glm::vec3 rotation, glm::vec3 scale, bool async) {
   Entity entity = entityManager.createEntity();
 
   auto &resourceSystem = systemManager.getSystem<ResourceSystem>();
 
-  uint32_t meshHandle = resourceSystem.loadMesh(modelPath);
+  uint32_t meshHandle = async ? resourceSystem.loadMeshAsync(modelPath) : resourceSystem.loadMesh(modelPath);
   Mesh &mesh = resourceSystem.getMesh(meshHandle);
 
   size_t submeshCount = mesh.getSubmeshes().size();
@@ -65,6 +410,30 @@ void SceneSystem::createModelEntity(const std::string name, const std::string &m
   systemManager.getSystem<RenderSystem>().insertRenderable(entity);
 }
 
+bool SceneSystem::createGltfEntities(const std::string &path, glm::vec3 position, glm::vec3 rotation,
+                                     glm::vec3 scale) {
+  auto &resourceSystem = systemManager.getSystem<ResourceSystem>();
+  auto &transformSystem = systemManager.getSystem<TransformSystem>();
+  std::vector<GltfInstance> instances;
+  if (!resourceSystem.loadGltf(path, instances))
+    return false;
+
+  glm::mat4 root = transformSystem.calculateModelMatrix(TransformComponent(position, rotation, scale));
+  for (GltfInstance &instance : instances) {
+    Entity entity = entityManager.createEntity();
+    size_t submeshCount = resourceSystem.getMesh(instance.meshHandle).getSubmeshes().size();
+
+    componentManager.insert<NameComponent>(entity, std::make_unique<NameComponent>(std::move(instance.name)));
+    TransformComponent transform = transformSystem.decomposeModelMatrix(root * instance.transform);
+    componentManager.insert<TransformComponent>(entity, std::make_unique<TransformComponent>(transform));
+    componentManager.insert<ModelComponent>(
+        entity, std::make_unique<ModelComponent>(instance.meshHandle, std::vector<uint32_t>(submeshCount, 0)));
+
+    systemManager.getSystem<RenderSystem>().insertRenderable(entity);
+  }
+  return true;
+}
+
 void SceneSystem::createLightEntity(const std::string &name, glm::vec3 position, glm::vec3 direction, glm::vec3 color,
                                     LightType type, float intensity, float cutOff, float outerCutOff) {
   Entity entity = entityManager.createEntity();
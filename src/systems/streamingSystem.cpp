@@ -0,0 +1,172 @@
+#include "systems/streamingSystem.h"
+#include "components/cameraComponent.h"
+#include "foundation/core/config.h"
+#include "foundation/core/profiler.h"
+#include "systems/cameraSystem.h"
+#include "systems/jobSystem.h"
+#include <algorithm>
+#include <atomic>
+#include <filesystem>
+#include <iostream>
+#include <utility>
+
+namespace fs = std::filesystem;
+
+struct StreamingSystem::CellRead {
+  std::atomic<bool> done{false};
+  bool ok = false; // valid once done
+  SceneFile::Data data;
+};
+
+// XZ distance from a point to a cell's square (0 inside)
+static float cellDistance(const glm::vec2 &point, const glm::vec2 &min, const glm::vec2 &max) {
+  return glm::length(glm::max(glm::max(min - point, glm::vec2(0.0f)), point - max));
+}
+
+bool StreamingSystem::openWorld(const std::string &directory) {
+  closeWorld();
+  SceneFile::World world;
+  if (!SceneFile::readWorld((fs::path(directory) / SceneFile::WORLD_INDEX_FILE).string(), world))
+    return false;
+
+  m_directory = fs::absolute(directory).lexically_normal().generic_string();
+  m_cells.resize(world.cells.size());
+  for (size_t i = 0; i < world.cells.size(); ++i) {
+    Cell &cell = m_cells[i];
+    cell.info = std::move(world.cells[i]);
+    cell.min = glm::vec2(cell.info.x, cell.info.z) * world.cellSize;
+    cell.max = cell.min + glm::vec2(world.cellSize);
+  }
+  m_stats = StreamingStats();
+  m_stats.cells = static_cast<uint32_t>(m_cells.size());
+  m_hasCameraPosition = false;
+  m_velocity = glm::vec3(0.0f);
+  return true;
+}
+
+void StreamingSystem::closeWorld() {
+  for (Cell &cell : m_cells)
+    unloadCell(cell);
+  m_cells.clear();
+  m_directory.clear();
+  m_stats.cells = 0;
+}
+
+bool StreamingSystem::isWorldOpen() const { return !m_directory.empty(); }
+
+// Back to Unloaded from any state; a read in flight finishes into its (then unreferenced) CellRead
+void StreamingSystem::unloadCell(Cell &cell) {
+  if (cell.state == CellState::Instantiating)
+    m_sceneSystem.endSceneLoad(cell.load);
+  if (cell.state == CellState::Instantiating || cell.state == CellState::Resident) {
+    m_sceneSystem.destroyEntities(cell.load.entities);
+    m_stats.cellUnloads++;
+  }
+  cell.load = SceneLoad();
+  cell.read.reset();
+  cell.state = CellState::Unloaded;
+}
+
+// Unload out of range cells, start reads for the nearest cells in range, then instantiate finished reads nearest
+// first; unloading and instantiating share the per-frame component budget
+void StreamingSystem::update(float deltaTime, SystemManager &systemManager) {
+  if (m_cells.empty())
+    return;
+
+  Entity activeCamera = systemManager.getSystem<CameraSystem>().getActiveCamera();
+  auto *camera = m_componentManager.tryGet<CameraComponent>(activeCamera);
+  if (!camera)
+    return;
+
+  // Smoothed velocity, so one fast frame does not swing the look-ahead across the world
+  if (m_hasCameraPosition && deltaTime > 0.0f)
+    m_velocity = glm::mix(m_velocity, (camera->position - m_lastCameraPosition) / deltaTime,
+                          EngineConfig::STREAMING_VELOCITY_SMOOTHING);
+  m_lastCameraPosition = camera->position;
+  m_hasCameraPosition = true;
+
+  glm::vec2 position(camera->position.x, camera->position.z);
+  glm::vec3 predicted = camera->position + m_velocity * EngineConfig::STREAMING_LOOKAHEAD_SECONDS;
+  glm::vec2 predictedPosition(predicted.x, predicted.z);
+  for (Cell &cell : m_cells)
+    cell.priority = std::min(cellDistance(position, cell.min, cell.max),
+                             cellDistance(predictedPosition, cell.min, cell.max));
+
+  size_t budget = EngineConfig::STREAMING_COMPONENTS_PER_FRAME;
+  bool unloaded = false;
+  for (Cell &cell : m_cells) {
+    if (cell.state == CellState::Unloaded || cell.priority <= EngineConfig::STREAMING_UNLOAD_RADIUS)
+      continue;
+    size_t cost = cell.load.entities.size();
+    if (unloaded && cost > budget)
+      continue; // next frame
+    unloadCell(cell);
+    budget -= std::min(cost, budget);
+    unloaded = true;
+  }
+
+  // Cells to act on, nearest (to the camera or its predicted position) first
+  std::vector<Cell *> order;
+  uint32_t pendingReads = 0;
+  for (Cell &cell : m_cells) {
+    if (cell.state == CellState::Reading)
+      pendingReads++;
+    if (cell.state == CellState::Reading || cell.state == CellState::Instantiating ||
+        (cell.state == CellState::Unloaded && cell.priority <= EngineConfig::STREAMING_LOAD_RADIUS))
+      order.push_back(&cell);
+  }
+  std::sort(order.begin(), order.end(), [](const Cell *a, const Cell *b) { return a->priority < b->priority; });
+
+  for (Cell *cell : order) {
+    if (cell->state != CellState::Unloaded || pendingReads >= EngineConfig::STREAMING_MAX_PENDING_READS)
+      continue;
+    auto read = std::make_shared<CellRead>();
+    std::string path = (fs::path(m_directory) / cell->info.file).string();
+    m_jobSystem.submitBackground([read, path] {
+      PROFILE_ZONE("ReadCell");
+      read->ok = SceneFile::read(path, read->data);
+      read->done.store(true, std::memory_order_release);
+    });
+    cell->read = std::move(read);
+    cell->state = CellState::Reading;
+    pendingReads++;
+  }
+
+  for (Cell *cell : order) {
+    if (cell->state == CellState::Reading && cell->read->done.load(std::memory_order_acquire)) {
+      if (!cell->read->ok) {
+        std::cerr << "[StreamingSystem] Failed to read cell " << cell->info.file << "\n";
+        cell->state = CellState::Failed;
+      } else {
+        m_sceneSystem.beginSceneLoad(cell->load, std::move(cell->read->data), m_directory);
+        cell->state = CellState::Instantiating;
+      }
+      cell->read.reset();
+    }
+
+    if (cell->state != CellState::Instantiating || budget == 0)
+      continue;
+    size_t before = cell->load.cursor;
+    bool complete = m_sceneSystem.continueSceneLoad(cell->load, budget);
+    budget -= std::min(cell->load.cursor - before, budget);
+    if (complete) {
+      m_sceneSystem.endSceneLoad(cell->load);
+      cell->load.data = SceneFile::Data(); // only the entities are needed to unload it
+      cell->state = CellState::Resident;
+      m_stats.cellLoads++;
+    }
+  }
+}
+
+StreamingStats StreamingSystem::getStats() const {
+  StreamingStats stats = m_stats;
+  stats.residentCells = stats.loadingCells = stats.residentEntities = 0;
+  for (const Cell &cell : m_cells) {
+    if (cell.state == CellState::Resident)
+      stats.residentCells++;
+    else if (cell.state == CellState::Reading || cell.state == CellState::Instantiating)
+      stats.loadingCells++;
+    stats.residentEntities += static_cast<uint32_t>(cell.load.entities.size());
+  }
+  return stats;
+}
@@ -2,6 +2,8 @@
 #include "components/transformComponent.h"
 #include "glm/ext/matrix_transform.hpp"
 #include <glm/gtc/quaternion.hpp>
+#define GLM_ENABLE_EXPERIMENTAL
+#include <glm/gtx/euler_angles.hpp>
 
 glm::mat4 TransformSystem::calculateModelMatrix(const TransformComponent &transform) {
   glm::mat4 modelMatrix = glm::translate(glm::mat4(1.0f), transform.position);
@@ -17,3 +19,22 @@ glm::mat4 TransformSystem::calculateModelMatrix(const TransformComponent &transf
 
   return modelMatrix;
 }
+
+TransformComponent TransformSystem::decomposeModelMatrix(const glm::mat4 &modelMatrix) {
+  glm::vec3 position(modelMatrix[3]);
+  glm::vec3 scale(glm::length(glm::vec3(modelMatrix[0])), glm::length(glm::vec3(modelMatrix[1])),
+                  glm::length(glm::vec3(modelMatrix[2])));
+  // a mirrored matrix keeps its handedness as a negative x scale
+  if (glm::determinant(glm::mat3(modelMatrix)) < 0.0f)
+    scale.x = -scale.x;
+
+  glm::mat4 rotationMatrix(1.0f);
+  for (int axis = 0; axis < 3; ++axis)
+    if (scale[axis] != 0.0f)
+      rotationMatrix[axis] = glm::vec4(glm::vec3(modelMatrix[axis]) / scale[axis], 0.0f);
+
+  // calculateModelMatrix rotates by qy * qx * qz
+  float yaw, pitch, roll;
+  glm::extractEulerAngleYXZ(rotationMatrix, yaw, pitch, roll);
+  return TransformComponent(position, glm::degrees(glm::vec3(pitch, yaw, roll)), scale);
+}
@@ -2,8 +2,11 @@
 #include "components/lightComponent.h"
 #include "components/modelComponent.h"
 #include "components/nameComponent.h"
+#include "components/occluderComponent.h"
 
 #include "components/transformComponent.h"
+#include "foundation/core/config.h"
+#include "foundation/core/profiler.h"
 #include "rendering/resources/material.h"
 #include "rendering/resources/mesh.h"
 #include "systems/lightSystem.h"
@@ -15,6 +18,10 @@
 #include <imgui/imgui_impl_opengl3.h>
 #include <imgui/imgui_impl_sdl3.h>
 
+#include <algorithm>
+#include <array>
+#include <cstdio>
+
 UISystem::UISystem(SDL_Window *window, SDL_GLContext glContext) {
   IMGUI_CHECKVERSION();
   ImGui::CreateContext();
@@ -77,6 +84,17 @@ void UISystem::render(EntityManager &entityManager, SystemManager &systemManager
         ImGui::DragFloat3("Scale", &transform.scale.x, 0.1f);
       }
 
+      // Occluder flag (rasterized for CPU occlusion culling)
+      if (componentManager.has<ModelComponent>(m_selectedEntity)) {
+        bool occluder = componentManager.has<OccluderComponent>(m_selectedEntity);
+        if (ImGui::Checkbox("Occluder", &occluder)) {
+          if (occluder)
+            componentManager.insert<OccluderComponent>(m_selectedEntity, std::make_unique<OccluderComponent>());
+          else
+            componentManager.remove<OccluderComponent>(m_selectedEntity);
+        }
+      }
+
       // Model/Material component
       if (componentManager.has<ModelComponent>(m_selectedEntity)) {
         auto &model = componentManager.get<ModelComponent>(m_selectedEntity);
@@ -84,102 +102,49 @@ void UISystem::render(EntityManager &entityManager, SystemManager &systemManager
         const auto &submeshes = mesh.getSubmeshes();
 
         ImGui::Separator();
+        ImGui::Text("Mesh %u (shared by %u entities)", model.meshHandle,
+                    resourceSystem.getMeshRefCount(model.meshHandle));
+        const char *residency[] = {"GPU only", "CPU + GPU", "CPU positions"};
+        ImGui::Text("%s: %zu CPU + %zu GPU bytes", residency[static_cast<int>(mesh.getResidency())],
+                    mesh.getCpuBytes(), mesh.getGpuBytes());
         ImGui::Text("Materials (%zu submeshes):", submeshes.size());
 
         static char globalPaths[4][256] = {};
         const char *labels[4] = {"Diffuse", "Specular", "Normal", "Emission"};
-        enum TexType { DIFF = 0, SPEC = 1, NORM = 2, EMIS = 3 };
-
-        // Apply texture to all submeshes
-        auto applyAll = [&](TexType type, const char *path) {
-          GLuint tex = resourceSystem.loadTexture(path);
-
-          for (size_t i = 0; i < model.materialHandles.size(); ++i) {
-            uint32_t &handle = model.materialHandles[i];
-
-            // Copy-on-write if shared
-            if (handle == 0) {
-              handle = resourceSystem.createMaterial();
-            } else {
-              int count = 0;
-              for (auto h : model.materialHandles)
-                if (h == handle)
-                  count++;
-
-              if (count > 1) {
-                uint32_t newHandle = resourceSystem.createMaterial();
-                resourceSystem.getMaterial(newHandle) = resourceSystem.getMaterial(handle);
-                handle = newHandle;
-              }
-            }
 
-            Material &mat = resourceSystem.getMaterial(handle);
-            switch (type) {
-            case DIFF:
-              mat.setDiffuseTexture(tex);
-              break;
-            case SPEC:
-              mat.setSpecularTexture(tex);
-              break;
-            case NORM:
-              mat.setNormalTexture(tex);
-              break;
-            case EMIS:
-              mat.setEmissionTexture(tex);
-              break;
-            }
-          }
+        // Materials are shared: edit a copy and swap the handle for the material with the edited parameters
+        auto editMaterial = [&](uint32_t &handle, auto edit) {
+          Material material = resourceSystem.getMaterial(handle);
+          edit(material);
+          uint32_t edited = resourceSystem.createMaterial(material);
+          resourceSystem.unloadMaterial(handle);
+          handle = edited;
         };
 
-        // Reset to default texture for all submeshes
-        auto removeAll = [&](TexType type) {
-          Material &defaultMat = resourceSystem.getMaterial(0);
-
-          for (size_t i = 0; i < model.materialHandles.size(); ++i) {
-            uint32_t &handle = model.materialHandles[i];
-
-            if (handle == 0)
-              continue;
-
-            int count = 0;
-            for (auto h : model.materialHandles)
-              if (h == handle)
-                count++;
-
-            if (count > 1) {
-              uint32_t newHandle = resourceSystem.createMaterial();
-              resourceSystem.getMaterial(newHandle) = resourceSystem.getMaterial(handle);
-              handle = newHandle;
-            }
+        auto setTexture = [&](uint32_t &handle, MaterialSlot slot, GLuint texture) {
+          editMaterial(handle, [&](Material &material) { material.setTexture(slot, texture); });
+        };
 
-            Material &mat = resourceSystem.getMaterial(handle);
-            switch (type) {
-            case DIFF:
-              mat.setDiffuseTexture(defaultMat.getDiffuse());
-              break;
-            case SPEC:
-              mat.setSpecularTexture(defaultMat.getSpecular());
-              break;
-            case NORM:
-              mat.setNormalTexture(defaultMat.getNormal());
-              break;
-            case EMIS:
-              mat.setEmissionTexture(defaultMat.getEmission());
-              break;
-            }
-          }
+        // Decoded in the background; a flat placeholder is bound until the upload
+        auto loadTexture = [&](MaterialSlot slot, const char *path) {
+          return resourceSystem.loadTextureAsync(path, slot == MaterialSlot::Normal ? TextureUsage::Normal
+                                                                                     : TextureUsage::Color);
         };
 
-        // Global texture controls
+        // Global texture controls (all submeshes)
         for (int t = 0; t < 4; t++) {
+          MaterialSlot slot = static_cast<MaterialSlot>(t);
           ImGui::InputText((std::string("Set All ") + labels[t]).c_str(), globalPaths[t], 256);
           ImGui::SameLine();
           if (ImGui::Button((std::string("Apply##all_") + labels[t]).c_str())) {
-            applyAll((TexType)t, globalPaths[t]);
+            GLuint tex = loadTexture(slot, globalPaths[t]);
+            for (uint32_t &handle : model.materialHandles)
+              setTexture(handle, slot, tex);
           }
           ImGui::SameLine();
           if (ImGui::Button((std::string("[X]##all_") + labels[t]).c_str())) {
-            removeAll((TexType)t);
+            for (uint32_t &handle : model.materialHandles)
+              setTexture(handle, slot, Material::getFallbackTexture(slot));
           }
         }
 
@@ -187,8 +152,8 @@ void UISystem::render(EntityManager &entityManager, SystemManager &systemManager
 
         // Per-submesh material controls
         static std::vector<std::array<char[256], 4>> paths;
-        if (paths.size() != submeshes.size())
-          paths.resize(submeshes.size());
+        if (paths.size() != model.materialHandles.size())
+          paths.resize(model.materialHandles.size());
 
         for (size_t i = 0; i < model.materialHandles.size(); ++i) {
           ImGui::PushID(i);
@@ -196,107 +161,32 @@ void UISystem::render(EntityManager &entityManager, SystemManager &systemManager
           if (ImGui::CollapsingHeader((std::string("Submesh ") + std::to_string(i)).c_str())) {
 
             uint32_t &handle = model.materialHandles[i];
-            Material *matPtr = (handle != 0) ? &resourceSystem.getMaterial(handle) : nullptr;
-
-            if (matPtr) {
+            if (handle != 0) {
               ImGui::Text("Current Material: %u", handle);
             } else {
               ImGui::Text("Current Material: DEFAULT (0)");
             }
 
             for (int t = 0; t < 4; t++) {
+              MaterialSlot slot = static_cast<MaterialSlot>(t);
               ImGui::InputText(labels[t], paths[i][t], 256);
               ImGui::SameLine();
 
               // Set texture
-              if (ImGui::Button((std::string("Set##") + labels[t]).c_str())) {
-                if (handle == 0) {
-                  handle = resourceSystem.createMaterial();
-                } else {
-                  int count = 0;
-                  for (auto h : model.materialHandles)
-                    if (h == handle)
-                      count++;
-                  if (count > 1) {
-                    uint32_t newHandle = resourceSystem.createMaterial();
-                    resourceSystem.getMaterial(newHandle) = resourceSystem.getMaterial(handle);
-                    handle = newHandle;
-                  }
-                }
-
-                GLuint tex = resourceSystem.loadTexture(paths[i][t]);
-                Material &m = resourceSystem.getMaterial(handle);
-
-                switch (t) {
-                case DIFF:
-                  m.setDiffuseTexture(tex);
-                  break;
-                case SPEC:
-                  m.setSpecularTexture(tex);
-                  break;
-                case NORM:
-                  m.setNormalTexture(tex);
-                  break;
-                case EMIS:
-                  m.setEmissionTexture(tex);
-                  break;
-                }
-              }
+              if (ImGui::Button((std::string("Set##") + labels[t]).c_str()))
+                setTexture(handle, slot, loadTexture(slot, paths[i][t]));
 
               ImGui::SameLine();
 
               // Reset to default
-              if (ImGui::Button((std::string("[X]##") + labels[t]).c_str())) {
-                if (handle != 0) {
-                  int count = 0;
-                  for (auto h : model.materialHandles)
-                    if (h == handle)
-                      count++;
-                  if (count > 1) {
-                    uint32_t newHandle = resourceSystem.createMaterial();
-                    resourceSystem.getMaterial(newHandle) = resourceSystem.getMaterial(handle);
-                    handle = newHandle;
-                  }
-
-                  Material &m = resourceSystem.getMaterial(handle);
-                  Material &defaultMat = resourceSystem.getMaterial(0);
-
-                  switch (t) {
-                  case DIFF:
-                    m.setDiffuseTexture(defaultMat.getDiffuse());
-                    break;
-                  case SPEC:
-                    m.setSpecularTexture(defaultMat.getSpecular());
-                    break;
-                  case NORM:
-                    m.setNormalTexture(defaultMat.getNormal());
-                    break;
-                  case EMIS:
-                    m.setEmissionTexture(defaultMat.getEmission());
-                    break;
-                  }
-                }
-              }
+              if (ImGui::Button((std::string("[X]##") + labels[t]).c_str()))
+                setTexture(handle, slot, Material::getFallbackTexture(slot));
             }
 
             // Shininess slider
-            float shininess = matPtr ? matPtr->getShininess() : 16.0f;
-            if (ImGui::SliderFloat("Shininess", &shininess, 1.0f, 256.0f)) {
-              if (handle == 0) {
-                handle = resourceSystem.createMaterial();
-              } else {
-                int count = 0;
-                for (auto h : model.materialHandles)
-                  if (h == handle)
-                    count++;
-                if (count > 1) {
-                  uint32_t newHandle = resourceSystem.createMaterial();
-                  resourceSystem.getMaterial(newHandle) = resourceSystem.getMaterial(handle);
-                  handle = newHandle;
-                }
-              }
-              resourceSystem.getMaterial(handle).setShininess(shininess);
-            }
+            float shininess = resourceSystem.getMaterial(handle).getShininess();
+            if (ImGui::SliderFloat("Shininess", &shininess, 1.0f, 256.0f))
+              editMaterial(handle, [&](Material &material) { material.setShininess(shininess); });
           }
 
           ImGui::PopID();
@@ -406,7 +296,8 @@ void UISystem::render(EntityManager &entityManager, SystemManager &systemManager
 
       if (ImGui::Button("Create")) {
         sceneSystem.createModelEntity(modelName, modelPath, glm::vec3(pos[0], pos[1], pos[2]),
-                                      glm::vec3(rot[0], rot[1], rot[2]), glm::vec3(scale[0], scale[1], scale[2]));
+                                      glm::vec3(rot[0], rot[1], rot[2]), glm::vec3(scale[0], scale[1], scale[2]),
+                                      true);
         formType = 0;
         ImGui::CloseCurrentPopup();
       }
@@ -466,4 +357,168 @@ void UISystem::render(EntityManager &entityManager, SystemManager &systemManager
   }
 
   ImGui::End();
+
+  renderStats(systemManager);
+  renderProfiler(systemManager);
+}
+
+void UISystem::renderStats(SystemManager &systemManager) {
+  auto &renderSystem = systemManager.getSystem<RenderSystem>();
+  const RenderStats &stats = renderSystem.getStats();
+  ImGuiIO &io = ImGui::GetIO();
+
+  ImGui::SetNextWindowPos(ImVec2(io.DisplaySize.x - 10.0f, 10.0f), ImGuiCond_Always, ImVec2(1.0f, 0.0f));
+  ImGui::SetNextWindowBgAlpha(0.6f);
+  ImGui::Begin("Render Stats", nullptr,
+               ImGuiWindowFlags_NoTitleBar | ImGuiWindowFlags_NoResize | ImGuiWindowFlags_AlwaysAutoResize |
+                   ImGuiWindowFlags_NoMove | ImGuiWindowFlags_NoFocusOnAppearing | ImGuiWindowFlags_NoNav);
+
+  ImGui::Text("%.1f FPS (%.2f ms)", io.Framerate, 1000.0f / io.Framerate);
+  ImGui::Text("Draw calls: %u (%u mesh batches)", stats.drawCalls, stats.meshBatches);
+  ImGui::Text("Triangles: %u (shadow %u)", stats.triangles, stats.shadowTriangles);
+  for (size_t lod = 0; lod < stats.entitiesPerLod.size(); ++lod) {
+    ImGui::Text("LOD %zu: %u entities", lod, stats.entitiesPerLod[lod]);
+  }
+
+  ImGui::Separator();
+  bool occlusion = renderSystem.isOcclusionCullingEnabled();
+  if (ImGui::Checkbox("Occlusion culling", &occlusion))
+    renderSystem.setOcclusionCulling(occlusion);
+  ImGui::Text("Culled: %u (occluder tris %u)", stats.culledEntities, stats.occluderTriangles);
+
+  ImGui::End();
+}
+
+void UISystem::renderProfiler(SystemManager &systemManager) {
+  const GpuTimer &gpuTimer = systemManager.getSystem<RenderSystem>().getRenderer().getGpuTimer();
+  const ProfileFrame &frame = Profiler::getLastFrame();
+  ImGuiIO &io = ImGui::GetIO();
+
+  ImGui::SetNextWindowPos(ImVec2(io.DisplaySize.x - 10.0f, io.DisplaySize.y - 10.0f), ImGuiCond_FirstUseEver,
+                          ImVec2(1.0f, 1.0f));
+  ImGui::SetNextWindowSize(ImVec2(520.0f, 360.0f), ImGuiCond_FirstUseEver);
+  ImGui::Begin("Profiler");
+
+  bool enabled = Profiler::isEnabled();
+  if (ImGui::Checkbox("Enabled", &enabled))
+    Profiler::setEnabled(enabled);
+  ImGui::SameLine();
+  if (ImGui::Button("Save Chrome trace")) {
+    m_traceStatus = Profiler::writeChromeTrace(EngineConfig::PROFILER_TRACE_PATH)
+                        ? std::string("Saved ") + EngineConfig::PROFILER_TRACE_PATH
+                        : std::string("Failed to save trace");
+  }
+  if (!m_traceStatus.empty()) {
+    ImGui::SameLine();
+    ImGui::TextUnformatted(m_traceStatus.c_str());
+  }
+
+  // GPU passes: frame-time graph and rolling percentiles over the timer history
+  if (ImGui::CollapsingHeader("GPU", ImGuiTreeNodeFlags_DefaultOpen)) {
+    char overlay[32];
+    std::snprintf(overlay, sizeof(overlay), "%.3f ms", gpuTimer.getLastMs(GpuPass::Frame));
+    ImGui::PlotLines("##GpuFrame", gpuTimer.getHistory(GpuPass::Frame), gpuTimer.getHistorySize(),
+                     gpuTimer.getHistoryOffset(), overlay, 0.0f, gpuTimer.getPercentile(GpuPass::Frame, 1.0f) * 1.2f,
+                     ImVec2(ImGui::GetContentRegionAvail().x, 60.0f));
+
+    if (ImGui::BeginTable("GpuPasses", 5, ImGuiTableFlags_RowBg | ImGuiTableFlags_SizingStretchProp)) {
+      ImGui::TableSetupColumn("Pass");
+      ImGui::TableSetupColumn("ms");
+      ImGui::TableSetupColumn("p50");
+      ImGui::TableSetupColumn("p95");
+      ImGui::TableSetupColumn("p99");
+      ImGui::TableHeadersRow();
+
+      for (uint32_t i = 0; i < static_cast<uint32_t>(GpuPass::Count); ++i) {
+        GpuPass pass = static_cast<GpuPass>(i);
+        ImGui::TableNextRow();
+        ImGui::TableNextColumn();
+        ImGui::TextUnformatted(GpuTimer::getPassName(pass));
+        ImGui::TableNextColumn();
+        ImGui::Text("%.3f", gpuTimer.getLastMs(pass));
+        ImGui::TableNextColumn();
+        ImGui::Text("%.3f", gpuTimer.getPercentile(pass, 0.5f));
+        ImGui::TableNextColumn();
+        ImGui::Text("%.3f", gpuTimer.getPercentile(pass, 0.95f));
+        ImGui::TableNextColumn();
+        ImGui::Text("%.3f", gpuTimer.getPercentile(pass, 0.99f));
+      }
+      ImGui::EndTable();
+    }
+    ImGui::Text("Dropped (not ready): %u", gpuTimer.getDroppedFrames());
+  }
+
+  if (!ImGui::CollapsingHeader("CPU", ImGuiTreeNodeFlags_DefaultOpen)) {
+    ImGui::End();
+    return;
+  }
+
+  double frameMs = (frame.end - frame.start) / 1e6;
+  ImGui::Text("Frame: %.3f ms, %zu zones", frameMs, frame.events.size());
+
+  // Flame graph: one lane per thread, one row per nesting depth
+  const float rowHeight = 16.0f;
+  const float width = ImGui::GetContentRegionAvail().x;
+  ImDrawList *drawList = ImGui::GetWindowDrawList();
+  ImVec2 origin = ImGui::GetCursorScreenPos();
+  float laneTop = 0.0f;
+
+  for (size_t first = 0; first < frame.events.size();) {
+    uint32_t threadId = frame.events[first].threadId;
+    size_t last = first;
+    uint32_t maxDepth = 0;
+    while (last < frame.events.size() && frame.events[last].threadId == threadId)
+      maxDepth = std::max(maxDepth, frame.events[last++].depth);
+
+    drawList->AddText(ImVec2(origin.x, origin.y + laneTop), IM_COL32(200, 200, 200, 255),
+                      Profiler::getThreadName(threadId).c_str());
+    laneTop += rowHeight;
+
+    for (size_t i = first; i < last; ++i) {
+      const ProfileEvent &event = frame.events[i];
+      float x0 = frameMs > 0.0 ? float((double(event.start) - frame.start) / 1e6 / frameMs) * width : 0.0f;
+      float x1 = frameMs > 0.0 ? float((double(event.end) - frame.start) / 1e6 / frameMs) * width : 0.0f;
+      x0 = std::clamp(x0, 0.0f, width);
+      x1 = std::clamp(x1, x0 + 1.0f, width);
+
+      ImVec2 min(origin.x + x0, origin.y + laneTop + event.depth * rowHeight);
+      ImVec2 max(origin.x + x1, min.y + rowHeight - 1.0f);
+      uint32_t hash = 2166136261u; // FNV-1a, stable color per zone name
+      for (const char *c = event.name; *c; ++c)
+        hash = (hash ^ static_cast<uint8_t>(*c)) * 16777619u;
+      drawList->AddRectFilled(min, max, IM_COL32(80 + (hash & 0x7F), 80 + ((hash >> 8) & 0x7F), 160, 255));
+      if (max.x - min.x > 40.0f) {
+        drawList->PushClipRect(min, max, true);
+        drawList->AddText(ImVec2(min.x + 2.0f, min.y), IM_COL32_WHITE, event.name);
+        drawList->PopClipRect();
+      }
+      if (ImGui::IsMouseHoveringRect(min, max))
+        ImGui::SetTooltip("%s: %.3f ms", event.name, (event.end - event.start) / 1e6);
+    }
+
+    laneTop += (maxDepth + 1) * rowHeight + 4.0f;
+    first = last;
+  }
+  ImGui::Dummy(ImVec2(width, laneTop));
+
+  // Per-zone totals over all threads
+  if (ImGui::BeginTable("Zones", 3, ImGuiTableFlags_RowBg | ImGuiTableFlags_SizingStretchProp)) {
+    ImGui::TableSetupColumn("Zone");
+    ImGui::TableSetupColumn("ms");
+    ImGui::TableSetupColumn("Calls");
+    ImGui::TableHeadersRow();
+
+    for (const ProfileZoneStats &zone : Profiler::getZoneStats()) {
+      ImGui::TableNextRow();
+      ImGui::TableNextColumn();
+      ImGui::Text("%*s%s", static_cast<int>(zone.depth * 2), "", zone.name);
+      ImGui::TableNextColumn();
+      ImGui::Text("%.3f", zone.totalMs);
+      ImGui::TableNextColumn();
+      ImGui::Text("%u", zone.calls);
+    }
+    ImGui::EndTable();
+  }
+
+  ImGui::End();
 }
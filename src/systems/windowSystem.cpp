@@ -1,10 +1,16 @@
 #include "systems/windowSystem.h"
 
-WindowSystem::WindowSystem(float screenWidth, float screenHeight) : m_window(nullptr), m_glContext(nullptr) {
+WindowSystem::WindowSystem(float screenWidth, float screenHeight, bool headless)
+    : m_window(nullptr), m_glContext(nullptr), m_headless(headless) {
   initialize(screenWidth, screenHeight);
 };
 
 bool WindowSystem::initialize(float screenWidth, float screenHeight) {
+  if (m_headless) {
+    SDL_Log("Running headless (no window, no GL context)");
+    return true;
+  }
+
   if (!SDL_Init(SDL_INIT_VIDEO)) {
     SDL_Log("Failed to initialize SDL: %s", SDL_GetError());
     return false;
@@ -40,5 +46,9 @@ void WindowSystem::onResize(int newWidth, int newHeight, Renderer &renderer) {
 
 SDL_Window *WindowSystem::getWindow() const { return m_window; }
 SDL_GLContext WindowSystem::getContext() const { return m_glContext; }
+bool WindowSystem::isHeadless() const { return m_headless; }
 
-void WindowSystem::setCursor(bool boolean) { SDL_SetWindowRelativeMouseMode(m_window, boolean); }
\ No newline at end of file
+void WindowSystem::setCursor(bool boolean) {
+  if (m_window)
+    SDL_SetWindowRelativeMouseMode(m_window, boolean);
+}
\ No newline at end of file
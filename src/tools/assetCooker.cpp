@@ -0,0 +1,303 @@
+// Offline asset cooker: converts the meshes and textures under an asset directory into the engine's runtime
+// formats (mesh cache, block-compressed texture cache) on all cores, and optionally packs them.
+//
+// Cooking is incremental: a manifest records a content hash of every source (file contents + importer
+// settings), and only sources whose hash changed are re-cooked. Sources that were merely touched get their
+// cache re-stamped so the engine keeps using the cooked data.
+//
+// Usage: asset_cooker [dir] [--pack [output]] [--force]
+
+#include "foundation/core/assetPack.h"
+#include "foundation/core/config.h"
+#include "foundation/core/fileUtils.h"
+#include "rendering/backend/nullBackend.h"
+#include "rendering/resources/mesh.h"
+#include "rendering/resources/meshCache.h"
+#include "rendering/resources/textureCache.h"
+#include "rendering/resources/textureImporter.h"
+#include "systems/jobSystem.h"
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+namespace {
+
+constexpr const char *MANIFEST_NAME = "cooker_manifest.txt";
+
+enum class SourceKind { Mesh, Texture, NormalMap, Shader };
+
+const char *getKindName(SourceKind kind) {
+  switch (kind) {
+  case SourceKind::Mesh:
+    return "mesh";
+  case SourceKind::Texture:
+    return "texture";
+  case SourceKind::NormalMap:
+    return "normal";
+  case SourceKind::Shader:
+    return "shader";
+  }
+  return "";
+}
+
+enum class CookResult { Cooked, UpToDate, Restamped, Failed };
+
+struct Source {
+  std::string path;
+  SourceKind kind;
+  uint64_t hash = 0; // contents + settings
+  CookResult result = CookResult::Failed;
+};
+
+uint64_t combine(uint64_t hash, uint64_t value) {
+  for (int byte = 0; byte < 8; ++byte)
+    hash = (hash ^ ((value >> (byte * 8)) & 0xff)) * 1099511628211ull;
+  return hash;
+}
+
+uint64_t floatBits(float value) {
+  uint32_t bits;
+  std::memcpy(&bits, &value, sizeof(bits));
+  return bits;
+}
+
+// Everything besides the source contents that changes the cooked output
+uint64_t getSettingsHash(SourceKind kind) {
+  uint64_t hash = combine(1469598103934665603ull, static_cast<uint64_t>(kind));
+  if (kind == SourceKind::Mesh) {
+    hash = combine(hash, MeshCache::FORMAT_VERSION);
+    hash = combine(hash, MeshCache::IMPORTER_VERSION);
+    hash = combine(hash, EngineConfig::MESH_LOD_COUNT);
+    hash = combine(hash, floatBits(EngineConfig::MESH_LOD_REDUCTION));
+    hash = combine(hash, floatBits(EngineConfig::MESH_LOD_MAX_ERROR));
+    hash = combine(hash, floatBits(EngineConfig::MESH_LOD_MIN_SAVING));
+  } else if (kind != SourceKind::Shader) {
+    hash = combine(hash, TextureCache::FORMAT_VERSION);
+    hash = combine(hash, TextureCache::ENCODER_VERSION);
+    hash = combine(hash, EngineConfig::TEXTURE_COMPRESSION_ENABLED);
+    hash = combine(hash, EngineConfig::TEXTURE_COMPRESSION_USE_BC7);
+  }
+  return hash;
+}
+
+TextureUsage getUsage(SourceKind kind) {
+  return kind == SourceKind::NormalMap ? TextureUsage::Normal : TextureUsage::Color;
+}
+
+std::string getCookedPath(const Source &source) {
+  switch (source.kind) {
+  case SourceKind::Mesh:
+    return MeshCache::getCachePath(source.path);
+  case SourceKind::Texture:
+  case SourceKind::NormalMap:
+    return TextureCache::getCachePath(source.path, getUsage(source.kind));
+  case SourceKind::Shader:
+    return source.path; // packed as is
+  }
+  return "";
+}
+
+// Whether the cooked file is valid for the current source stamp (what the engine checks at load time)
+bool isCacheCurrent(const Source &source) {
+  if (source.kind == SourceKind::Mesh) {
+    MeshCache::View view;
+    return MeshCache::open(source.path, view);
+  }
+  TextureImage image;
+  return TextureCache::open(source.path, getUsage(source.kind), image);
+}
+
+bool updateStamp(const Source &source) {
+  if (source.kind == SourceKind::Mesh)
+    return MeshCache::updateSourceStamp(source.path);
+  return TextureCache::updateSourceStamp(source.path, getUsage(source.kind));
+}
+
+// Import from scratch; the stale cache is removed first so the importer cannot pick it up
+bool cook(const Source &source, JobSystem &jobSystem) {
+  std::error_code error;
+  fs::remove(getCookedPath(source), error);
+
+  if (source.kind == SourceKind::Mesh) {
+    Mesh mesh;
+    if (!mesh.load(source.path, &jobSystem))
+      return false;
+  } else {
+    TextureImage image;
+    if (!TextureImporter::import(source.path, getUsage(source.kind), image, &jobSystem))
+      return false;
+  }
+
+  // The importers only warn when the cache cannot be written (and textures write none without compression)
+  return fs::exists(getCookedPath(source), error);
+}
+
+std::unordered_map<std::string, uint64_t> readManifest(const std::string &path) {
+  std::unordered_map<std::string, uint64_t> manifest;
+  std::ifstream file(path);
+  std::string line;
+  while (std::getline(file, line)) {
+    std::istringstream stream(line);
+    std::string kind, hash, sourcePath;
+    if (!(stream >> kind >> hash) || !std::getline(stream >> std::ws, sourcePath))
+      continue;
+    manifest[kind + " " + sourcePath] = std::strtoull(hash.c_str(), nullptr, 16);
+  }
+  return manifest;
+}
+
+bool writeManifest(const std::string &path, const std::vector<Source> &sources) {
+  std::string text;
+  char hash[17];
+  for (const Source &source : sources) {
+    if (source.kind == SourceKind::Shader || source.result == CookResult::Failed)
+      continue;
+    std::snprintf(hash, sizeof(hash), "%016llx", static_cast<unsigned long long>(source.hash));
+    text += std::string(getKindName(source.kind)) + " " + hash + " " + source.path + "\n";
+  }
+  return FileUtils::writeFileAtomic(path, text.data(), text.size());
+}
+
+std::vector<Source> findSources(const std::string &directory) {
+  std::vector<Source> sources;
+  std::error_code error;
+  for (fs::recursive_directory_iterator it(directory, error), end; !error && it != end; it.increment(error)) {
+    if (!it->is_regular_file())
+      continue;
+    std::string ext = it->path().extension().string();
+    std::transform(ext.begin(), ext.end(), ext.begin(), [](unsigned char c) { return std::tolower(c); });
+
+    Source source;
+    source.path = it->path().generic_string();
+    if (ext == ".obj")
+      source.kind = SourceKind::Mesh;
+    else if (TextureImporter::isSupportedFile(it->path()))
+      source.kind = TextureImporter::guessUsage(it->path()) == TextureUsage::Normal ? SourceKind::NormalMap
+                                                                                    : SourceKind::Texture;
+    else if (ext == ".vert" || ext == ".frag" || ext == ".geom" || ext == ".glsl")
+      source.kind = SourceKind::Shader;
+    else
+      continue;
+    sources.push_back(source);
+  }
+
+  // Deterministic manifest and pack order
+  std::sort(sources.begin(), sources.end(), [](const Source &a, const Source &b) { return a.path < b.path; });
+  return sources;
+}
+
+bool writePack(const std::string &outputPath, const std::vector<Source> &sources) {
+  AssetPackWriter writer;
+  for (const Source &source : sources) {
+    if (source.result == CookResult::Failed)
+      continue;
+    MappedFile file;
+    if (!file.open(getCookedPath(source))) {
+      std::cerr << "[Cooker] Not packed, cannot read " << getCookedPath(source) << std::endl;
+      continue;
+    }
+
+    AssetType type = source.kind == SourceKind::Mesh       ? AssetType::Mesh
+                     : source.kind == SourceKind::Texture   ? AssetType::Texture
+                     : source.kind == SourceKind::NormalMap ? AssetType::NormalMap
+                                                            : AssetType::Shader;
+    writer.add(source.path, type, file.getData(), file.getSize());
+  }
+
+  if (!writer.write(outputPath))
+    return false;
+  std::error_code error;
+  std::cout << "[Cooker] Packed " << writer.getAssetCount() << " assets into " << outputPath << " ("
+            << fs::file_size(outputPath, error) / (1024.0 * 1024.0) << " MiB)" << std::endl;
+  return true;
+}
+
+} // namespace
+
+int main(int argc, char *argv[]) {
+  std::string directory = EngineConfig::ASSET_BASE_PATH;
+  std::string packPath;
+  bool force = false;
+  for (int i = 1; i < argc; ++i) {
+    if (std::strcmp(argv[i], "--pack") == 0)
+      packPath = (i + 1 < argc && argv[i + 1][0] != '-') ? argv[++i] : EngineConfig::ASSET_PACK_PATH;
+    else if (std::strcmp(argv[i], "--force") == 0)
+      force = true;
+    else
+      directory = argv[i];
+  }
+
+  // The importers only ask the backend which formats exist; no GPU is needed
+  RenderBackend::set(std::make_unique<NullBackend>());
+  JobSystem jobSystem;
+  auto start = std::chrono::steady_clock::now();
+
+  std::vector<Source> sources = findSources(directory);
+  const std::string manifestPath = std::string(EngineConfig::ASSET_BASE_PATH) + "cache/" + MANIFEST_NAME;
+  std::unordered_map<std::string, uint64_t> manifest = force ? decltype(manifest)() : readManifest(manifestPath);
+
+  // One job per source; texture encoding inside spreads further over the same pool
+  JobSystem::Group group;
+  for (Source &source : sources) {
+    if (source.kind == SourceKind::Shader) {
+      source.result = CookResult::UpToDate;
+      continue;
+    }
+
+    auto it = manifest.find(std::string(getKindName(source.kind)) + " " + source.path);
+    uint64_t previousHash = it != manifest.end() ? it->second : 0;
+    jobSystem.submit(
+        [&source, &jobSystem, previousHash] {
+          uint64_t contentHash;
+          if (!FileUtils::hashFile(source.path, contentHash)) {
+            source.result = CookResult::Failed;
+            return;
+          }
+          source.hash = combine(getSettingsHash(source.kind), contentHash);
+
+          if (source.hash == previousHash) {
+            if (isCacheCurrent(source)) {
+              source.result = CookResult::UpToDate;
+              return;
+            }
+            // Same contents, new file stamp (checkout, copy): keep the cooked data
+            if (updateStamp(source) && isCacheCurrent(source)) {
+              source.result = CookResult::Restamped;
+              return;
+            }
+          }
+          source.result = cook(source, jobSystem) ? CookResult::Cooked : CookResult::Failed;
+        },
+        &group);
+  }
+  jobSystem.wait(group);
+
+  uint32_t counts[4] = {};
+  for (const Source &source : sources) {
+    counts[static_cast<int>(source.result)]++;
+    if (source.result == CookResult::Failed)
+      std::cerr << "[Cooker] Failed: " << source.path << std::endl;
+  }
+
+  if (!writeManifest(manifestPath, sources))
+    std::cerr << "[Cooker] Cannot write " << manifestPath << std::endl;
+
+  bool packed = packPath.empty() || writePack(packPath, sources);
+  double totalMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+  std::cout << "[Cooker] " << sources.size() << " sources: " << counts[0] << " cooked, " << counts[1]
+            << " up to date, " << counts[2] << " re-stamped, " << counts[3] << " failed in " << totalMs << " ms ("
+            << jobSystem.getThreadCount() << " threads)" << std::endl;
+  return counts[3] == 0 && packed ? 0 : 1;
+}
@@ -0,0 +1,415 @@
+// Engine benchmarks: each one writes a synthetic input (fixture) to the temp directory, times the engine
+// loading it and prints the result. They run on a headless engine and its job system, so the numbers come from
+// the same worker pool the engine uses.
+//
+// Usage: engine_bench mesh [path] [iterations]
+//        engine_bench obj [triangles] [iterations]
+//        engine_bench glb [triangles] [iterations]
+//        engine_bench scene [entities] [iterations]
+//        engine_bench world [cells per side] [entities per cell] [frames]
+
+#define TINYOBJLOADER_IMPLEMENTATION
+#include "foundation/core/config.h"
+#include "foundation/core/engine.h"
+#include "rendering/geometry/objParser.h"
+#include "rendering/resources/gltfLoader.h"
+#include "rendering/resources/mesh.h"
+#include "rendering/resources/meshCache.h"
+#include "systems/streamingSystem.h"
+#include "systems/jobSystem.h"
+#include <SDL3/SDL.h>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <functional>
+#include <json/json.hpp>
+#include <memory>
+#include <string>
+#include <thread>
+#include <tiny_obj_loader/tiny_obj_loader.h>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+namespace {
+
+// Benchmark input in the temp directory (a file or a directory), removed when the fixture goes out of scope
+class Fixture {
+private:
+  fs::path m_path;
+
+public:
+  explicit Fixture(const std::string &name) : m_path(fs::temp_directory_path() / ("engine_bench_" + name)) {
+    std::error_code error;
+    fs::remove_all(m_path, error);
+  }
+  ~Fixture() {
+    std::error_code error;
+    fs::remove_all(m_path, error);
+  }
+
+  Fixture(const Fixture &) = delete;
+  Fixture &operator=(const Fixture &) = delete;
+
+  std::string getPath() const { return m_path.string(); }
+
+  // Size of the file, or of every file under the directory
+  double getMegabytes() const {
+    std::error_code error;
+    uintmax_t bytes = 0;
+    if (fs::is_directory(m_path, error)) {
+      for (const auto &entry : fs::recursive_directory_iterator(m_path, error))
+        bytes += entry.is_regular_file(error) ? entry.file_size(error) : 0;
+    } else {
+      bytes = fs::file_size(m_path, error);
+    }
+    return error ? 0.0 : bytes / (1024.0 * 1024.0);
+  }
+};
+
+// Average wall time of run over the iterations, in ms
+double timeMs(uint32_t iterations, const std::function<void()> &run) {
+  auto start = std::chrono::steady_clock::now();
+  for (uint32_t i = 0; i < iterations; ++i)
+    run();
+  return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count() /
+         (iterations ? iterations : 1);
+}
+
+double ratio(double numerator, double denominator) { return denominator > 0.0 ? numerator / denominator : 0.0; }
+
+// The engine's default scene: a camera, a directional light and a box at the origin
+void createDefaultScene(Engine &engine) {
+  glm::vec3 origin(0.0f);
+  engine.createCameraEntity(glm::vec3(0.0f, 3.0f, 8.0f), 0.0f, -15.0f, 90.0f);
+  engine.createLightEntity("Directional", glm::vec3(2.0f, 3.0f, 2.0f), glm::vec3(-1.0f), glm::vec3(1.0f),
+                           LightType::Directional, 1.5f, 0.0f, 0.0f);
+  engine.createModelEntity("Object", EngineConfig::MODEL_BOX, origin, origin, glm::vec3(1.0f));
+}
+
+// Write a grid of quads with positions, UVs and normals as an OBJ file of about the given triangle count
+bool writeGridObj(const std::string &path, uint32_t triangles) {
+  FILE *file = std::fopen(path.c_str(), "w");
+  if (!file)
+    return false;
+
+  const uint32_t side = std::max(2u, static_cast<uint32_t>(std::sqrt(triangles / 2.0)) + 1);
+  for (uint32_t y = 0; y < side; ++y) {
+    for (uint32_t x = 0; x < side; ++x) {
+      float u = x / float(side - 1), v = y / float(side - 1);
+      float height = 0.1f * std::sin(u * 20.0f) * std::cos(v * 20.0f);
+      std::fprintf(file, "v %.6f %.6f %.6f\nvt %.6f %.6f\nvn %.6f %.6f %.6f\n", u * 10.0f, height, v * 10.0f, u, v,
+                   -height, 1.0f, height);
+    }
+  }
+  for (uint32_t y = 0; y + 1 < side; ++y) {
+    if (y == (side - 1) / 2)
+      std::fprintf(file, "g half\n");
+    for (uint32_t x = 0; x + 1 < side; ++x) {
+      uint32_t a = y * side + x + 1, b = a + 1, c = a + side + 1, d = a + side;
+      std::fprintf(file, "f %u/%u/%u %u/%u/%u %u/%u/%u %u/%u/%u\n", a, a, a, b, b, b, c, c, c, d, d, d);
+    }
+  }
+  return std::fclose(file) == 0;
+}
+
+// Write the OBJ grid's geometry as a binary glTF: interleaved Vertex array and 32-bit indices in one buffer
+bool writeGridGlb(const std::string &path, const ObjParser::Result &grid) {
+  const size_t vertexBytes = grid.vertices.size() * sizeof(Vertex);
+  const size_t indexBytes = grid.indices.size() * sizeof(uint32_t);
+  glm::vec3 boundsMin(INFINITY), boundsMax(-INFINITY);
+  for (const Vertex &vertex : grid.vertices) {
+    boundsMin = glm::min(boundsMin, vertex.position);
+    boundsMax = glm::max(boundsMax, vertex.position);
+  }
+
+  using json = nlohmann::json;
+  auto accessor = [](int view, size_t offset, size_t count, int componentType, const char *type) {
+    return json{{"bufferView", view}, {"byteOffset", offset}, {"count", count}, {"componentType", componentType},
+                {"type", type}};
+  };
+  json position = accessor(0, offsetof(Vertex, position), grid.vertices.size(), 5126, "VEC3");
+  position["min"] = {boundsMin.x, boundsMin.y, boundsMin.z};
+  position["max"] = {boundsMax.x, boundsMax.y, boundsMax.z};
+  json document = {
+      {"asset", {{"version", "2.0"}}},
+      {"scene", 0},
+      {"scenes", {{{"nodes", {0}}}}},
+      {"nodes", {{{"name", "Grid"}, {"mesh", 0}}}},
+      {"meshes",
+       {{{"primitives", {{{"attributes", {{"POSITION", 0}, {"NORMAL", 1}, {"TEXCOORD_0", 2}}}, {"indices", 3}}}}}}},
+      {"accessors",
+       {position, accessor(0, offsetof(Vertex, normal), grid.vertices.size(), 5126, "VEC3"),
+        accessor(0, offsetof(Vertex, texCoord), grid.vertices.size(), 5126, "VEC2"),
+        accessor(1, 0, grid.indices.size(), 5125, "SCALAR")}},
+      {"bufferViews",
+       {{{"buffer", 0}, {"byteOffset", 0}, {"byteLength", vertexBytes}, {"byteStride", sizeof(Vertex)}},
+        {{"buffer", 0}, {"byteOffset", vertexBytes}, {"byteLength", indexBytes}}}},
+      {"buffers", {{{"byteLength", vertexBytes + indexBytes}}}}};
+
+  std::string text = document.dump();
+  text.resize((text.size() + 3) & ~size_t(3), ' ');
+  const uint32_t binaryLength = static_cast<uint32_t>((vertexBytes + indexBytes + 3) & ~size_t(3));
+  const uint32_t header[5] = {0x46546C67, 2, static_cast<uint32_t>(12 + 8 + text.size() + 8 + binaryLength),
+                              static_cast<uint32_t>(text.size()), 0x4E4F534A};
+  const uint32_t binaryHeader[2] = {binaryLength, 0x004E4942};
+  const uint32_t padding = 0;
+
+  FILE *file = std::fopen(path.c_str(), "wb");
+  if (!file)
+    return false;
+  std::fwrite(header, sizeof(header), 1, file);
+  std::fwrite(text.data(), text.size(), 1, file);
+  std::fwrite(binaryHeader, sizeof(binaryHeader), 1, file);
+  std::fwrite(grid.vertices.data(), vertexBytes, 1, file);
+  std::fwrite(grid.indices.data(), indexBytes, 1, file);
+  std::fwrite(&padding, binaryLength - vertexBytes - indexBytes, 1, file);
+  return std::fclose(file) == 0;
+}
+
+// Cold OBJ import (parse, optimize, LODs, cache write) versus loading the mapped mesh cache
+void runMeshBenchmark(Engine &engine, const std::string &path, uint32_t iterations) {
+  JobSystem &jobSystem = engine.getJobSystem();
+  double coldMs = timeMs(iterations, [&]() {
+    std::error_code error;
+    fs::remove(MeshCache::getCachePath(path), error);
+    Mesh mesh(path, &jobSystem);
+  });
+  double cachedMs = timeMs(iterations, [&]() { Mesh mesh(path, &jobSystem); });
+
+  SDL_Log("Mesh load %s (%u runs): OBJ import %.3f ms, cached %.3f ms (%.1fx)", path.c_str(), iterations, coldMs,
+          cachedMs, ratio(coldMs, cachedMs));
+}
+
+// Parse a generated OBJ with tinyobjloader and with ObjParser (one thread and the engine's job system)
+void runObjBenchmark(Engine &engine, uint32_t triangles, uint32_t iterations) {
+  Fixture obj("grid.obj");
+  if (!writeGridObj(obj.getPath(), triangles)) {
+    SDL_Log("Cannot write %s", obj.getPath().c_str());
+    return;
+  }
+
+  size_t tinyIndices = 0;
+  double tinyMs = timeMs(iterations, [&]() {
+    tinyobj::attrib_t attrib;
+    std::vector<tinyobj::shape_t> shapes;
+    std::vector<tinyobj::material_t> materials;
+    std::string err;
+    tinyobj::LoadObj(&attrib, &shapes, &materials, &err, obj.getPath().c_str());
+    tinyIndices = 0;
+    for (const auto &shape : shapes)
+      tinyIndices += shape.mesh.indices.size();
+  });
+
+  ObjParser::Result result;
+  double serialMs = timeMs(iterations, [&]() { ObjParser::parse(obj.getPath(), result); });
+  size_t serialIndices = result.indices.size();
+
+  JobSystem &jobSystem = engine.getJobSystem();
+  double parallelMs = timeMs(iterations, [&]() { ObjParser::parse(obj.getPath(), result, &jobSystem); });
+  size_t parallelIndices = result.indices.size();
+
+  SDL_Log("OBJ parse, %.1f MiB, %zu triangles (%u runs): tinyobjloader %.1f ms, ObjParser %.1f ms (%.1fx), "
+          "%u threads %.1f ms (%.1fx); %zu welded vertices, %zu submeshes",
+          obj.getMegabytes(), parallelIndices / 3, iterations, tinyMs, serialMs, ratio(tinyMs, serialMs),
+          jobSystem.getThreadCount(), parallelMs, ratio(tinyMs, parallelMs), result.vertices.size(),
+          result.submeshes.size());
+  if (tinyIndices != serialIndices || serialIndices != parallelIndices)
+    SDL_Log("Index count mismatch: %zu / %zu / %zu", tinyIndices, serialIndices, parallelIndices);
+}
+
+// Load the same grid as OBJ (parse, then upload the built vertices) and as glb (upload from the mapped file)
+void runGltfBenchmark(Engine &engine, uint32_t triangles, uint32_t iterations) {
+  Fixture obj("grid.obj"), glb("grid.glb");
+  ObjParser::Result grid;
+  if (!writeGridObj(obj.getPath(), triangles) || !ObjParser::parse(obj.getPath(), grid) ||
+      !writeGridGlb(glb.getPath(), grid)) {
+    SDL_Log("Cannot write the benchmark grid to %s", glb.getPath().c_str());
+    return;
+  }
+
+  JobSystem &jobSystem = engine.getJobSystem();
+  size_t objIndices = 0, glbIndices = 0;
+  double objMs = timeMs(iterations, [&]() {
+    ObjParser::Result result;
+    ObjParser::parse(obj.getPath(), result, &jobSystem);
+    Mesh mesh(std::move(result.vertices), std::move(result.indices), std::move(result.submeshes),
+              MeshResidency::GpuOnly);
+    objIndices = mesh.getIndexCount();
+  });
+
+  bool zeroCopy = false;
+  double glbMs = timeMs(iterations, [&]() {
+    GltfLoader::Asset asset;
+    std::unique_ptr<Mesh> mesh =
+        GltfLoader::load(glb.getPath(), asset) ? GltfLoader::createMesh(asset, 0, &zeroCopy) : nullptr;
+    glbIndices = mesh ? mesh->getIndexCount() : 0;
+  });
+
+  SDL_Log("Mesh load, %zu triangles (%u runs): OBJ %.1f ms, glb %.1f ms (%.1fx, %s)", glbIndices / 3, iterations,
+          objMs, glbMs, ratio(objMs, glbMs), zeroCopy ? "zero-copy" : "repacked");
+  if (objIndices != glbIndices)
+    SDL_Log("Index count mismatch: %zu / %zu", objIndices, glbIndices);
+}
+
+// Save a grid of models around the default scene as JSON and as a snapshot, then time loading each back
+void runSceneBenchmark(Engine &engine, uint32_t entityCount, uint32_t iterations) {
+  createDefaultScene(engine);
+  const uint32_t gridWidth = 300;
+  for (uint32_t i = 3; i < entityCount; ++i) {
+    glm::vec3 position((i % gridWidth) * 3.0f - gridWidth * 1.5f, 0.0f, -3.0f - (i / gridWidth) * 3.0f);
+    engine.createModelEntity("Object " + std::to_string(i), EngineConfig::MODEL_BOX, position, glm::vec3(0.0f),
+                             glm::vec3(1.0f));
+  }
+
+  Fixture json("scene.json"), snapshot("scene.scene");
+  bool ok = true;
+  double saveJsonMs = timeMs(iterations, [&]() { ok &= engine.saveScene(json.getPath(), SceneFile::Format::Json); });
+  double saveSnapshotMs =
+      timeMs(iterations, [&]() { ok &= engine.saveScene(snapshot.getPath(), SceneFile::Format::Snapshot); });
+  double loadJsonMs = timeMs(iterations, [&]() { ok &= engine.loadScene(json.getPath()); });
+  double loadSnapshotMs = timeMs(iterations, [&]() { ok &= engine.loadScene(snapshot.getPath()); });
+  if (!ok) {
+    SDL_Log("Failed to save or load the benchmark scene");
+    return;
+  }
+
+  SDL_Log("Scene, %u entities (%u runs): JSON %.1f MiB save %.1f ms load %.1f ms; snapshot %.1f MiB save %.1f ms "
+          "load %.1f ms (%.1fx)",
+          std::max(entityCount, 3u), iterations, json.getMegabytes(), saveJsonMs, loadJsonMs,
+          snapshot.getMegabytes(), saveSnapshotMs, loadSnapshotMs, ratio(loadJsonMs, loadSnapshotMs));
+}
+
+// Write a world of cellsPerSide^2 cell snapshots (a grid of boxes each) without building it in memory, then
+// fly the camera across it at 60 Hz and report the frame times and how much of the world was resident
+void runWorldBenchmark(Engine &engine, uint32_t cellsPerSide, uint32_t entitiesPerCell, uint32_t frameCount) {
+  createDefaultScene(engine);
+  const float cellSize = 32.0f;
+  const float cameraSpeed = 60.0f; // units per second, along the diagonal
+  const double framePeriodMs = 1000.0 / 60.0;
+  Fixture fixture("world");
+  std::string directory = fixture.getPath();
+  std::error_code error;
+  fs::create_directories(directory, error);
+
+  SceneFile::World world;
+  world.cellSize = cellSize;
+  uint32_t gridWidth = std::max(1u, static_cast<uint32_t>(std::ceil(std::sqrt(static_cast<double>(entitiesPerCell)))));
+  float spacing = cellSize / gridWidth;
+  std::string boxPath = fs::absolute(EngineConfig::MODEL_BOX).lexically_normal().lexically_proximate(
+      fs::absolute(directory)).generic_string();
+  auto writeStart = std::chrono::steady_clock::now();
+  for (uint32_t z = 0; z < cellsPerSide; ++z) {
+    for (uint32_t x = 0; x < cellsPerSide; ++x) {
+      SceneFile::Data data;
+      data.entityCount = entitiesPerCell;
+      data.names.assign(entitiesPerCell, SceneFile::NO_STRING);
+      data.meshes.push_back(data.addString(boxPath));
+      data.materials.push_back({{SceneFile::NO_STRING, SceneFile::NO_STRING, SceneFile::NO_STRING,
+                                 SceneFile::NO_STRING}, 16.0f}); // fallback maps
+      for (uint32_t i = 0; i < entitiesPerCell; ++i) {
+        data.transformEntities.push_back(i);
+        data.positions.emplace_back((x + ((i % gridWidth) + 0.5f) / gridWidth) * cellSize, 0.0f,
+                                    (z + ((i / gridWidth) + 0.5f) / gridWidth) * cellSize);
+        data.rotations.emplace_back(0.0f);
+        data.scales.emplace_back(spacing * 0.25f);
+        data.modelEntities.push_back(i);
+        data.modelMeshes.push_back(0);
+        data.modelMaterialStarts.push_back(i);
+        data.modelMaterialCounts.push_back(1);
+        data.modelMaterials.push_back(0);
+      }
+
+      SceneFile::WorldCell cell;
+      cell.x = static_cast<int32_t>(x);
+      cell.z = static_cast<int32_t>(z);
+      cell.file = "cell_" + std::to_string(x) + "_" + std::to_string(z) + ".scene";
+      cell.entityCount = entitiesPerCell;
+      if (!SceneFile::write((fs::path(directory) / cell.file).string(), data, SceneFile::Format::Snapshot)) {
+        SDL_Log("Failed to write world cell %s", cell.file.c_str());
+        return;
+      }
+      world.cells.push_back(std::move(cell));
+    }
+  }
+  if (!SceneFile::writeWorld((fs::path(directory) / SceneFile::WORLD_INDEX_FILE).string(), world) ||
+      !engine.openWorld(directory)) {
+    SDL_Log("Failed to write world %s", directory.c_str());
+    return;
+  }
+  double writeMs =
+      std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - writeStart).count();
+
+  std::vector<double> frameMs;
+  frameMs.reserve(frameCount);
+  uint32_t maxResidentEntities = 0, maxResidentCells = 0;
+  glm::vec3 start(cellSize * 2.0f, 3.0f, cellSize * 2.0f);
+  for (uint32_t frame = 0; frame < frameCount; ++frame) {
+    float distance = cameraSpeed * static_cast<float>(frame * framePeriodMs / 1000.0);
+    engine.setCameraPosition(start + glm::vec3(distance, 0.0f, distance) * 0.70710678f);
+
+    auto frameStart = std::chrono::steady_clock::now();
+    engine.runFrames(1);
+    double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - frameStart).count();
+    frameMs.push_back(ms);
+
+    StreamingStats stats = engine.getStreamingStats();
+    maxResidentEntities = std::max(maxResidentEntities, stats.residentEntities);
+    maxResidentCells = std::max(maxResidentCells, stats.residentCells);
+    if (ms < framePeriodMs)
+      std::this_thread::sleep_for(std::chrono::duration<double, std::milli>(framePeriodMs - ms));
+  }
+
+  StreamingStats stats = engine.getStreamingStats();
+  std::vector<double> sorted = frameMs;
+  std::sort(sorted.begin(), sorted.end());
+  double totalMs = 0.0;
+  for (double ms : frameMs)
+    totalMs += ms;
+  size_t count = sorted.size();
+  SDL_Log("World, %u cells x %u entities (%u total), written in %.0f ms: %u frames at 60 Hz, frame %.2f ms avg "
+          "%.2f ms p99 %.2f ms max",
+          stats.cells, entitiesPerCell, stats.cells * entitiesPerCell, writeMs, frameCount,
+          count ? totalMs / count : 0.0, count ? sorted[std::min(count - 1, count * 99 / 100)] : 0.0,
+          count ? sorted.back() : 0.0);
+  SDL_Log("  streaming: at most %u cells / %u entities resident, %u cell loads, %u unloads", maxResidentCells,
+          maxResidentEntities, stats.cellLoads, stats.cellUnloads);
+
+  engine.closeWorld();
+}
+
+uint32_t getArgument(int argc, char *argv[], int index, uint32_t fallback) {
+  return argc > index ? static_cast<uint32_t>(std::atoi(argv[index])) : fallback;
+}
+
+} // namespace
+
+int main(int argc, char *argv[]) {
+  const char *benchmark = argc > 1 ? argv[1] : "";
+  Engine engine(true);
+  if (!engine.init())
+    return 1;
+
+  if (std::strcmp(benchmark, "mesh") == 0)
+    runMeshBenchmark(engine, argc > 2 ? argv[2] : EngineConfig::MODEL_BOX, getArgument(argc, argv, 3, 20));
+  else if (std::strcmp(benchmark, "obj") == 0)
+    runObjBenchmark(engine, getArgument(argc, argv, 2, 2000000), getArgument(argc, argv, 3, 3));
+  else if (std::strcmp(benchmark, "glb") == 0)
+    runGltfBenchmark(engine, getArgument(argc, argv, 2, 2000000), getArgument(argc, argv, 3, 3));
+  else if (std::strcmp(benchmark, "scene") == 0)
+    runSceneBenchmark(engine, getArgument(argc, argv, 2, 100000), getArgument(argc, argv, 3, 3));
+  else if (std::strcmp(benchmark, "world") == 0)
+    runWorldBenchmark(engine, getArgument(argc, argv, 2, 64), getArgument(argc, argv, 3, 64),
+                      getArgument(argc, argv, 4, 600));
+  else {
+    std::fprintf(stderr, "Usage: engine_bench mesh [path] [iterations] | obj|glb [triangles] [iterations] | "
+                         "scene [entities] [iterations] | world [cells per side] [entities per cell] [frames]\n");
+    return 2;
+  }
+  return 0;
+}